@@ -0,0 +1,164 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*  Measures the throughput of Repository::retrieveObject.  The Repository
+    is filled with a number of objects (one million by default, or the
+    number given on the command line) which are then retrieved one at a
+    time, in bulk, and - if ObjectHandler was configured with
+    --enable-thread-safe-repository - from several threads at once.
+*/
+
+#if defined(HAVE_CONFIG_H)     // Dynamically created by configure
+#include <oh/config.hpp>
+#endif
+
+#ifdef BOOST_MSVC
+#  define BOOST_LIB_DIAGNOSTIC
+#  include <oh/auto_link.hpp>
+#  undef BOOST_LIB_DIAGNOSTIC
+#endif
+#include <oh/objecthandler.hpp>
+#include <ExampleObjects/accountexample.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#if defined(OH_ENABLE_THREAD_SAFE_REPOSITORY)
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <exception>
+#include <cstdlib>
+
+namespace {
+
+    double now() {
+        using namespace boost::posix_time;
+        static const ptime start = microsec_clock::universal_time();
+        return (microsec_clock::universal_time() - start)
+            .total_microseconds() * 1.0e-6;
+    }
+
+    void report(const std::string &what, std::size_t n, double seconds) {
+        std::cout << std::setw(32) << std::left << what
+                  << std::setw(10) << std::right << std::fixed
+                  << std::setprecision(3) << seconds << " s"
+                  << std::setw(14) << std::setprecision(0)
+                  << (seconds > 0.0 ? n / seconds : 0.0) << " /s"
+                  << std::endl;
+    }
+
+    // retrieves all the objects in the list one at a time
+    void retrieveAll(const std::vector<std::string> &ids, long *checksum) {
+        long sum = 0;
+        for (std::size_t i=0; i<ids.size(); ++i) {
+            OH_GET_REFERENCE(customer, ids[i],
+                AccountExample::CustomerObject, AccountExample::Customer)
+            sum += customer->name().size();
+        }
+        *checksum = sum;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    ObjectHandler::Repository repository;
+    ObjectHandler::EnumTypeRegistry enumTypeRegistry;
+    ObjectHandler::ProcessorFactory processorFactory;
+
+    try {
+
+        std::size_t n = 1000000;
+        if (argc > 1)
+            n = boost::lexical_cast<std::size_t>(argv[1]);
+
+        std::vector<std::string> ids(n);
+        for (std::size_t i=0; i<n; ++i)
+            ids[i] = "Customer#" + boost::lexical_cast<std::string>(i);
+
+        double t = now();
+        for (std::size_t i=0; i<n; ++i) {
+            boost::shared_ptr<ObjectHandler::ValueObject> valueObject(
+                new AccountExample::CustomerValueObject(
+                                          ids[i], "customer", 40, false));
+            boost::shared_ptr<ObjectHandler::Object> object(
+                new AccountExample::CustomerObject(
+                                  valueObject, "customer", 40, false));
+            repository.storeObject(ids[i], object);
+        }
+        report("storeObject", n, now() - t);
+
+        // look the objects up in random order and with a different case
+        std::srand(42);
+        std::random_shuffle(ids.begin(), ids.end());
+        for (std::size_t i=0; i<n; ++i)
+            boost::algorithm::to_lower(ids[i]);
+
+        long checksum = 0;
+        t = now();
+        retrieveAll(ids, &checksum);
+        report("retrieveObject", n, now() - t);
+        OH_REQUIRE(checksum == long(8*n), "wrong checksum: " << checksum);
+
+        const std::size_t batchSize = 1000;
+        t = now();
+        for (std::size_t i=0; i<n; i+=batchSize) {
+            std::vector<std::string> batch(ids.begin() + i,
+                ids.begin() + std::min(n, i+batchSize));
+            std::vector<boost::shared_ptr<AccountExample::CustomerObject> >
+                customers;
+            repository.retrieveObjects(customers, batch);
+        }
+        report("retrieveObjects (batches of 1000)", n, now() - t);
+
+        #if defined(OH_ENABLE_THREAD_SAFE_REPOSITORY)
+        unsigned int threads = std::max(boost::thread::hardware_concurrency(), 2u);
+        std::vector<long> checksums(threads);
+        boost::thread_group group;
+        t = now();
+        for (unsigned int i=0; i<threads; ++i)
+            group.create_thread(boost::bind(retrieveAll, boost::cref(ids),
+                                            &checksums[i]));
+        group.join_all();
+        report("retrieveObject, " + boost::lexical_cast<std::string>(threads)
+               + " threads", threads*n, now() - t);
+        for (unsigned int i=0; i<threads; ++i)
+            OH_REQUIRE(checksums[i] == long(8*n),
+                       "wrong checksum: " << checksums[i]);
+        #endif
+
+        t = now();
+        repository.deleteAllObjects();
+        report("deleteAllObjects", n, now() - t);
+
+        return 0;
+
+    } catch (const std::exception &e) {
+
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+
+    } catch (...) {
+
+        std::cout << "Error" << std::endl;
+        return 1;
+
+    }
+}
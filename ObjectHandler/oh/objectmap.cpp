@@ -0,0 +1,217 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#if defined(HAVE_CONFIG_H)     // Dynamically created by configure
+#include <oh/config.hpp>
+#endif
+
+#include <oh/objectmap.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+
+#if defined(OH_ENABLE_THREAD_SAFE_REPOSITORY)
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#endif
+
+using boost::shared_ptr;
+using std::string;
+
+namespace ObjectHandler {
+
+    namespace {
+
+        // The number of shards is fixed; it only needs to be large
+        // enough for threads looking up different objects to seldom
+        // hit the same lock.
+        const std::size_t shardCount = 64;
+
+        #if defined(OH_ENABLE_THREAD_SAFE_REPOSITORY)
+        typedef boost::shared_mutex Mutex;
+        typedef boost::shared_lock<boost::shared_mutex> ReadLock;
+        typedef boost::unique_lock<boost::shared_mutex> WriteLock;
+        #else
+        struct Mutex {};
+        struct ReadLock {
+            explicit ReadLock(Mutex&) {}
+        };
+        typedef ReadLock WriteLock;
+        #endif
+
+        typedef std::pair<string, ObjectMap::Entry> KeyedEntry;
+
+        bool keyLess(const KeyedEntry &e1, const KeyedEntry &e2) {
+            return e1.first < e2.first;
+        }
+
+    }
+
+    struct ObjectMap::Shard {
+        typedef boost::unordered_map<string, Entry> Table;
+        Table objects;
+        mutable Mutex mutex;
+    };
+
+    ObjectMap::ObjectMap()
+    : ctype_(std::use_facet<std::ctype<char> >(locale_)),
+      shards_(new Shard[shardCount]) {}
+
+    ObjectMap::~ObjectMap() {}
+
+    string ObjectMap::key(const string &id) const {
+        string result(id);
+        if (!result.empty())
+            ctype_.toupper(&result[0], &result[0] + result.size());
+        return result;
+    }
+
+    std::size_t ObjectMap::shardIndex(const string &key) const {
+        return boost::hash<string>()(key) % shardCount;
+    }
+
+    shared_ptr<ObjectWrapper> ObjectMap::find(const string &id) const {
+        string k = key(id);
+        const Shard &shard = shards_[shardIndex(k)];
+        ReadLock lock(shard.mutex);
+        Shard::Table::const_iterator i = shard.objects.find(k);
+        if (i == shard.objects.end())
+            return shared_ptr<ObjectWrapper>();
+        return i->second.wrapper;
+    }
+
+    std::vector<shared_ptr<ObjectWrapper> >
+    ObjectMap::find(const std::vector<string> &ids) const {
+        std::vector<shared_ptr<ObjectWrapper> > result(ids.size());
+
+        // group the positions of the IDs by shard...
+        std::vector<string> keys(ids.size());
+        std::vector<std::vector<std::size_t> > positions(shardCount);
+        for (std::size_t i=0; i<ids.size(); ++i) {
+            keys[i] = key(ids[i]);
+            positions[shardIndex(keys[i])].push_back(i);
+        }
+
+        // ...so that each shard is locked only once
+        for (std::size_t s=0; s<shardCount; ++s) {
+            if (positions[s].empty())
+                continue;
+            const Shard &shard = shards_[s];
+            ReadLock lock(shard.mutex);
+            for (std::size_t j=0; j<positions[s].size(); ++j) {
+                std::size_t i = positions[s][j];
+                Shard::Table::const_iterator e = shard.objects.find(keys[i]);
+                if (e != shard.objects.end())
+                    result[i] = e->second.wrapper;
+            }
+        }
+        return result;
+    }
+
+    bool ObjectMap::contains(const string &id) const {
+        string k = key(id);
+        const Shard &shard = shards_[shardIndex(k)];
+        ReadLock lock(shard.mutex);
+        return shard.objects.find(k) != shard.objects.end();
+    }
+
+    std::pair<shared_ptr<ObjectWrapper>, bool>
+    ObjectMap::insert(const string &id,
+                      const shared_ptr<ObjectWrapper> &wrapper) {
+        string k = key(id);
+        Shard &shard = shards_[shardIndex(k)];
+        Entry entry;
+        entry.id = id;
+        entry.wrapper = wrapper;
+        WriteLock lock(shard.mutex);
+        std::pair<Shard::Table::iterator, bool> result =
+            shard.objects.insert(std::make_pair(k, entry));
+        return std::make_pair(result.first->second.wrapper, result.second);
+    }
+
+    bool ObjectMap::erase(const string &id) {
+        string k = key(id);
+        Shard &shard = shards_[shardIndex(k)];
+        // the wrapper is released after the lock, in case the
+        // destruction of the object accesses the map
+        shared_ptr<ObjectWrapper> erased;
+        {
+            WriteLock lock(shard.mutex);
+            Shard::Table::iterator i = shard.objects.find(k);
+            if (i == shard.objects.end())
+                return false;
+            erased = i->second.wrapper;
+            shard.objects.erase(i);
+        }
+        return true;
+    }
+
+    void ObjectMap::eraseIf(bool (*predicate)(const ObjectWrapper&)) {
+        for (std::size_t s=0; s<shardCount; ++s) {
+            Shard &shard = shards_[s];
+            std::vector<shared_ptr<ObjectWrapper> > erased;
+            WriteLock lock(shard.mutex);
+            Shard::Table::iterator i = shard.objects.begin();
+            while (i != shard.objects.end()) {
+                if (predicate(*i->second.wrapper)) {
+                    erased.push_back(i->second.wrapper);
+                    i = shard.objects.erase(i);
+                } else {
+                    ++i;
+                }
+            }
+        }
+    }
+
+    void ObjectMap::clear() {
+        for (std::size_t s=0; s<shardCount; ++s) {
+            Shard &shard = shards_[s];
+            Shard::Table erased;
+            WriteLock lock(shard.mutex);
+            shard.objects.swap(erased);
+        }
+    }
+
+    std::size_t ObjectMap::size() const {
+        std::size_t n = 0;
+        for (std::size_t s=0; s<shardCount; ++s) {
+            ReadLock lock(shards_[s].mutex);
+            n += shards_[s].objects.size();
+        }
+        return n;
+    }
+
+    std::vector<ObjectMap::Entry> ObjectMap::entries() const {
+        std::vector<KeyedEntry> keyed;
+        for (std::size_t s=0; s<shardCount; ++s) {
+            const Shard &shard = shards_[s];
+            ReadLock lock(shard.mutex);
+            for (Shard::Table::const_iterator i = shard.objects.begin();
+                 i != shard.objects.end(); ++i)
+                keyed.push_back(*i);
+        }
+        std::sort(keyed.begin(), keyed.end(), keyLess);
+
+        std::vector<Entry> result;
+        result.reserve(keyed.size());
+        for (std::vector<KeyedEntry>::const_iterator i = keyed.begin();
+             i != keyed.end(); ++i)
+            result.push_back(i->second);
+        return result;
+    }
+
+}
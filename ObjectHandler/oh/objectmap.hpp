@@ -0,0 +1,120 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file
+    \brief Class ObjectMap - the structure used by the Repository to store Objects
+*/
+
+#ifndef oh_objectmap_hpp
+#define oh_objectmap_hpp
+
+#include <oh/objectwrapper.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <locale>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace ObjectHandler {
+
+    //! Store of ObjectWrappers keyed by case-insensitive ID.
+    /*! IDs are "case-preserving": the ID with which an object was
+        first stored is kept, while lookups ignore case.  The keys
+        are folded to upper case once, when an ID is passed to the
+        map, so that lookups don't compare IDs character by character
+        ignoring case as the std::map previously used by the
+        Repository did.
+
+        The objects are spread over a fixed number of shards chosen
+        by the hash of the folded key, each shard being a hash table.
+        If ObjectHandler is configured with
+        --enable-thread-safe-repository (or OH_ENABLE_THREAD_SAFE_REPOSITORY
+        is defined when compiling objectmap.cpp) each shard is guarded by
+        a readers/writer lock, so that lookups from several threads
+        proceed in parallel and only contend with writers to the same
+        shard.  Otherwise no locking takes place.
+
+        \warning thread safety covers the map only.  The ObjectWrappers
+                 it holds, and in particular the recreation of dirty
+                 objects and the notification of observers, are not
+                 made thread-safe.
+    */
+    class ObjectMap : boost::noncopyable {
+    public:
+        //! An object ID together with its ObjectWrapper.
+        struct Entry {
+            std::string id;
+            boost::shared_ptr<ObjectWrapper> wrapper;
+        };
+
+        ObjectMap();
+        ~ObjectMap();
+
+        //! \name Lookup
+        //@{
+        //! Return the ObjectWrapper with the given ID, or a null pointer if none is found.
+        boost::shared_ptr<ObjectWrapper> find(const std::string &id) const;
+        //! Bulk version of find.
+        /*! The result holds a null pointer for each ID which is not found.
+            Each shard is locked once for the whole list.
+        */
+        std::vector<boost::shared_ptr<ObjectWrapper> > find(
+            const std::vector<std::string> &ids) const;
+        //! Indicate whether an Object with the given ID is stored in the map.
+        bool contains(const std::string &id) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! Store the ObjectWrapper with the given ID unless the ID is already present.
+        /*! Returns the ObjectWrapper stored with that ID and a flag telling
+            whether the given one was inserted.  If the ID was present,
+            the map is left unchanged.
+        */
+        std::pair<boost::shared_ptr<ObjectWrapper>, bool> insert(
+            const std::string &id,
+            const boost::shared_ptr<ObjectWrapper> &wrapper);
+        //! Remove the Object with the given ID; returns false if none was found.
+        bool erase(const std::string &id);
+        //! Remove the Objects for which the given predicate returns true.
+        void eraseIf(bool (*predicate)(const ObjectWrapper&));
+        //! Remove all the Objects.
+        void clear();
+        //@}
+
+        //! \name Inspectors
+        //@{
+        //! Count of the Objects in the map.
+        std::size_t size() const;
+        //! IDs and ObjectWrappers of all the Objects, sorted by ID ignoring case.
+        std::vector<Entry> entries() const;
+        //@}
+
+    private:
+        struct Shard;
+        std::string key(const std::string &id) const;
+        std::size_t shardIndex(const std::string &key) const;
+
+        std::locale locale_;
+        const std::ctype<char> &ctype_;
+        boost::scoped_array<Shard> shards_;
+    };
+
+}
+
+#endif
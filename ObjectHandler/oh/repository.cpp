@@ -40,9 +40,17 @@ namespace ObjectHandler {
 
     Repository *Repository::instance_;
 
-    // std::map cannot be exported across DLL boundaries
+    // ObjectMap cannot be exported across DLL boundaries
     // so instead we use a static variable.
-    Repository::ObjectMap objectMap_;
+    ObjectMap objectMap_;
+
+    namespace {
+
+        bool isTransient(const ObjectWrapper &objectWrapper) {
+            return !objectWrapper.object()->permanent();
+        }
+
+    }
 
     Repository::Repository() {
         instance_ = this;
@@ -58,25 +66,24 @@ namespace ObjectHandler {
         return *instance_;
     }
 
-    // TODO: implement Scott Meyers' "Effective STL" item 24
     string Repository::storeObject(const string &objectID,
                                    const shared_ptr<Object> &object,
                                    bool overwrite,
                                    boost::shared_ptr<ValueObject>) {
-        OH_REQUIRE(overwrite || !objectExists(objectID),
-                   "Cannot store object with ID '" << objectID <<
-                   "' because an object with that ID already exists");
-
-        if(objectExists(objectID)){
-            ObjectMap::const_iterator result = objectMap_.find(objectID);
-            //result->second->notifyObservers();
-            result->second->reset(object);
-        } else{
-            shared_ptr<ObjectWrapper> objWrapper(new ObjectWrapper(object));
-            objectMap_[objectID] = objWrapper;
+
+        // A single lookup both inserts a new object and finds an existing
+        // one; the existing wrapper, which other objects may be observing,
+        // is reset with the new object.
+        std::pair<shared_ptr<ObjectWrapper>, bool> result = objectMap_.insert(
+            objectID, shared_ptr<ObjectWrapper>(new ObjectWrapper(object)));
+        if (!result.second) {
+            OH_REQUIRE(overwrite,
+                       "Cannot store object with ID '" << objectID <<
+                       "' because an object with that ID already exists");
+            result.first->reset(object);
         }
 
-        registerObserver(objectMap_[objectID]);
+        registerObserver(result.first);
         return objectID;
     }
 
@@ -87,25 +94,54 @@ namespace ObjectHandler {
 
     shared_ptr<Object> Repository::retrieveObjectImpl(const string &objectID) {
 
-        ObjectMap::const_iterator result = objectMap_.find(formatID(objectID));
-        OH_REQUIRE(result != objectMap_.end(),
+        shared_ptr<ObjectWrapper> result = objectMap_.find(formatID(objectID));
+        OH_REQUIRE(result,
                    "ObjectHandler error: attempt to retrieve object "
                    "with unknown ID '" << objectID << "'");
-        if(result->second->dirty()) {
-            result->second->recreate();
+        if(result->dirty()) {
+            result->recreate();
         }
-        return result->second->object();
+        return result->object();
     }
 
-    const shared_ptr<ObjectWrapper>&
+    void Repository::retrieveObjects(std::vector<shared_ptr<Object> > &ret,
+                                     const std::vector<string> &ids) {
+        ret = retrieveObjectsImpl(ids);
+    }
+
+    std::vector<shared_ptr<Object> >
+    Repository::retrieveObjectsImpl(const std::vector<string> &objectIDs) {
+
+        std::vector<string> realIDs;
+        realIDs.reserve(objectIDs.size());
+        std::vector<string>::const_iterator i;
+        for (i = objectIDs.begin(); i != objectIDs.end(); ++i)
+            realIDs.push_back(formatID(*i));
+
+        std::vector<shared_ptr<ObjectWrapper> > result =
+            objectMap_.find(realIDs);
+        std::vector<shared_ptr<Object> > ret(result.size());
+        for (std::size_t j=0; j<result.size(); ++j) {
+            OH_REQUIRE(result[j],
+                       "ObjectHandler error: attempt to retrieve object "
+                       "with unknown ID '" << objectIDs[j] << "'");
+            if(result[j]->dirty()) {
+                result[j]->recreate();
+            }
+            ret[j] = result[j]->object();
+        }
+        return ret;
+    }
+
+    shared_ptr<ObjectWrapper>
     Repository::getObjectWrapper(const string &objectID) const {
 
-        ObjectMap::const_iterator result = objectMap_.find(objectID);
-        OH_REQUIRE(result != objectMap_.end(),
+        shared_ptr<ObjectWrapper> result = objectMap_.find(objectID);
+        OH_REQUIRE(result,
                    "ObjectHandler error: attempt to retrieve object "
                    "with unknown ID '" << objectID << "'");
 
-        return result->second;
+        return result;
     }
 
     void Repository::registerObserver(shared_ptr<ObjectWrapper> objWrapper) {
@@ -124,10 +160,9 @@ namespace ObjectHandler {
 
     void Repository::deleteObject(const string &objectID) {
         string realID = formatID(objectID);
-        OH_REQUIRE(objectExists(realID),
+        OH_REQUIRE(objectMap_.erase(realID),
                    "Cannot delete '" << realID << "' because no Object with "
                    "that ID is present in the Repository");
-        objectMap_.erase(realID);
     }
 
     void Repository::deleteObject(const std::vector<string> &objectIDs) {
@@ -143,35 +178,30 @@ namespace ObjectHandler {
         if (deletePermanent) {
             objectMap_.clear();
         } else {
-            ObjectMap::iterator i = objectMap_.begin();
-            while (i != objectMap_.end()) {
-                if (i->second->object()->permanent())
-                    ++i;
-                else
-                    objectMap_.erase(i++);                    
-            }
+            objectMap_.eraseIf(isTransient);
         }
     }
 
     void Repository::dump(std::ostream& out) {
 
         out << "dump of all objects in ObjectHandler:" << endl << endl;
-        ObjectMap::const_iterator i;
-        for (i=objectMap_.begin(); i!=objectMap_.end(); ++i) {
-                shared_ptr<Object> object = i->second->object();
-                out << "Object with ID = " << i->first << ":" << endl <<object;
+        std::vector<ObjectMap::Entry> entries = objectMap_.entries();
+        std::vector<ObjectMap::Entry>::const_iterator i;
+        for (i=entries.begin(); i!=entries.end(); ++i) {
+                shared_ptr<Object> object = i->wrapper->object();
+                out << "Object with ID = " << i->id << ":" << endl <<object;
         }
     }
 
     void Repository::dumpObject(const string &objectID, std::ostream &out) {
 
         string realID = formatID(objectID);
-        ObjectMap::const_iterator result = objectMap_.find(realID);
-        if (result == objectMap_.end()) {
+        shared_ptr<ObjectWrapper> result = objectMap_.find(realID);
+        if (!result) {
             out << "no object in repository with ID = " << realID << endl;
         } else {
             out << "log dump of object with ID = " << realID <<
-                endl << result->second;
+                endl << result;
         }
     }
 
@@ -182,25 +212,24 @@ namespace ObjectHandler {
     const std::vector<string> Repository::listObjectIDs(const string &regex) {
 
         std::vector<string> objectIDs;
+        std::vector<ObjectMap::Entry> entries = objectMap_.entries();
+        std::vector<ObjectMap::Entry>::const_iterator i;
         if (regex.empty()) {
-            objectIDs.reserve(objectMap_.size());
-            ObjectMap::const_iterator i;
-            for (i=objectMap_.begin(); i!=objectMap_.end(); ++i)
-                objectIDs.push_back(i->first);
+            objectIDs.reserve(entries.size());
+            for (i=entries.begin(); i!=entries.end(); ++i)
+                objectIDs.push_back(i->id);
         } else {
             boost::regex r(regex, boost::regex::perl | boost::regex::icase);
-            ObjectMap::const_iterator i;
-            for (i=objectMap_.begin(); i!=objectMap_.end(); ++i) {
-                string objectID = i->first;
-                if (regex_match(objectID, r))
-                    objectIDs.push_back(objectID);
+            for (i=entries.begin(); i!=entries.end(); ++i) {
+                if (regex_match(i->id, r))
+                    objectIDs.push_back(i->id);
             }
         }
         return objectIDs;
     }
 
     bool Repository::objectExists(const string &objectID) const {
-        return objectMap_.find(objectID) != objectMap_.end();
+        return objectMap_.contains(objectID);
     }
 
     std::vector<bool>
@@ -221,10 +250,9 @@ namespace ObjectHandler {
 
         std::vector<string>::const_iterator i;
         for (i = objectList.begin(); i != objectList.end(); ++i) {
-            string realID = formatID(*i);
-            if(objectExists(realID)){
-                ObjectMap::const_iterator result = objectMap_.find(realID);
-                ret.push_back(result->second->creationTime());
+            shared_ptr<ObjectWrapper> result = objectMap_.find(formatID(*i));
+            if (result) {
+                ret.push_back(result->creationTime());
             } else {
                 OH_FAIL("Unable to retrieve object with ID "<<*i);
             }
@@ -239,10 +267,10 @@ namespace ObjectHandler {
         for (std::vector<string>::const_iterator i = objectList.begin();
             i != objectList.end(); ++i) {
 
-                string realID = formatID(*i);
-                if (objectExists(realID)){
-                    ObjectMap::const_iterator result = objectMap_.find(realID);
-                    ret.push_back( result->second->updateTime());
+                shared_ptr<ObjectWrapper> result =
+                    objectMap_.find(formatID(*i));
+                if (result) {
+                    ret.push_back(result->updateTime());
                 } else {
                     OH_FAIL("Unable to retrieve object with ID "<<*i);
                 }
@@ -252,11 +280,9 @@ namespace ObjectHandler {
 
     const std::vector<string>
     Repository::precedentIDs(const string &objectID) {
-        string realID = formatID(objectID);
-        if (objectExists(realID)){
-			ObjectMap::const_iterator result = objectMap_.find(realID);
-
-			shared_ptr<Object> object = result->second->object();
+        shared_ptr<ObjectWrapper> result = objectMap_.find(formatID(objectID));
+        if (result) {
+			shared_ptr<Object> object = result->object();
 			shared_ptr<Group> group = boost::dynamic_pointer_cast<Group>(object);
 
 			if(group)
@@ -294,10 +320,9 @@ namespace ObjectHandler {
 
         std::vector<string>::const_iterator i;
         for (i = objectList.begin(); i != objectList.end(); ++i) {
-            string realID = formatID(*i);
-            if (objectExists(realID)){
-                ObjectMap::const_iterator result = objectMap_.find(realID);
-                ret.push_back(result->second->object()->permanent());
+            shared_ptr<ObjectWrapper> result = objectMap_.find(formatID(*i));
+            if (result) {
+                ret.push_back(result->object()->permanent());
             } else {
                 OH_FAIL("Unable to retrieve object with ID "<<*i);
             }
@@ -311,12 +336,9 @@ namespace ObjectHandler {
 
         std::vector<string>::const_iterator i;
         for (i = objectList.begin(); i != objectList.end(); ++i) {
-            string realID = formatID(*i);
-            if (objectExists(realID)){
-
-                ObjectMap::const_iterator result = objectMap_.find(realID);
-
-                ret.push_back(result->second->object()->properties()->className());
+            shared_ptr<ObjectWrapper> result = objectMap_.find(formatID(*i));
+            if (result) {
+                ret.push_back(result->object()->properties()->className());
 
             } else {
                 OH_FAIL("Unable to retrieve object with ID "<<*i);
@@ -27,8 +27,8 @@
 
 #include <oh/objectwrapper.hpp>
 #include <oh/ohdefines.hpp>
+#include <oh/objectmap.hpp>
 #include <oh/iless.hpp>
-#include <map>
 
 //! ObjectHandler
 /*! Namespace for ObjectHandler functionality.
@@ -42,6 +42,14 @@ namespace ObjectHandler {
     /*! The client application may store, retrieve, and delete Objects in
         the Repository.
 
+        The Objects are held in an ObjectMap.  The Repository class cannot
+        declare a private data member of that type, because it is not exported
+        across DLL boundaries on the Windows platform; instead the map is
+        declared as a static variable in the cpp file.  If ObjectHandler is
+        configured with --enable-thread-safe-repository, Objects may be
+        stored, retrieved and deleted from several threads at once; see
+        ObjectMap for details and limitations.
+
         This class is implemented using a Singleton design pattern.  Rather
         than the Meyers Singleton used elsewhere, Repository uses a specialized
         Singleton supporting inheritance so that the Repository can be customized
@@ -103,6 +111,36 @@ namespace ObjectHandler {
         void retrieveObject(boost::shared_ptr<Object> &ret,
                             const std::string &id);
 
+        //! Template member function to retrieve the Objects with the given IDs.
+        /*! Bulk version of retrieveObject.  The Objects are looked up
+            together, which is faster than retrieving them one at a time.
+            Throw an exception if no Object exists with any of the IDs or
+            if any of the Objects cannot be downcast to the desired type.
+            This template passes the work off to function retrieveObjectsImpl
+            which may be overridden in derived classes.
+        */
+        template <class T>
+        void retrieveObjects(std::vector<boost::shared_ptr<T> > &ret,
+                             const std::vector<std::string> &ids) {
+            std::vector<boost::shared_ptr<Object> > objects =
+                retrieveObjectsImpl(ids);
+            ret.resize(objects.size());
+            for (std::size_t i=0; i<objects.size(); ++i) {
+                ret[i] = boost::dynamic_pointer_cast<T>(objects[i]);
+                OH_REQUIRE(ret[i], "Error retrieving object with id '"
+                    << ids[i] << "' - unable to convert reference to type '"
+                    << typeid(T).name() << "' found instead '"
+                    << typeid(*objects[i]).name() << "'");
+            }
+        }
+
+        //! Override of template function retrieveObjects.
+        /*! Specialized for the case where the client has requested references to
+            class Object and no downcast is necessary.
+        */
+        void retrieveObjects(std::vector<boost::shared_ptr<Object> > &ret,
+                             const std::vector<std::string> &ids);
+
         //! Default implementation of retrieveObjectImpl.
         /*! Retrieves the Object with the given ID.
             Throws an exception if no Object exists with that ID.
@@ -110,6 +148,15 @@ namespace ObjectHandler {
             the Repository class for platform-specific functionality.
         */
         virtual boost::shared_ptr<Object> retrieveObjectImpl(const std::string &objectID);
+
+        //! Default implementation of retrieveObjectsImpl.
+        /*! Retrieves the Objects with the given IDs.
+            Throws an exception if no Object exists with any of the IDs.
+            This member function may be overridden in base classes which customize
+            the Repository class for platform-specific functionality.
+        */
+        virtual std::vector<boost::shared_ptr<Object> > retrieveObjectsImpl(
+            const std::vector<std::string> &objectIDs);
         
         //! Delete the object with the given ID.
         /*! Delete the object regardless of whether or not it is permanent.
@@ -157,14 +204,6 @@ namespace ObjectHandler {
         virtual std::vector<bool> objectExists(const std::vector<std::string> &objectList);
         //@}
 
-        //! Define the type of the structure used to store the Objects.
-        /*! The Repository class cannot declare a private data member of type
-            ObjectMap, because std::map cannot be exported across DLL boundaries
-            on the Windows platform.  Instead the map is declared as a static
-            variable in the cpp file.
-        */
-        typedef std::map<std::string, boost::shared_ptr<ObjectWrapper>, my_iless> ObjectMap;
-
         //! \name Precedent object IDs and timestamps
         //@{
         //! Retrieve the list of IDs of precedent objects
@@ -186,7 +225,7 @@ namespace ObjectHandler {
         //! A pointer to the Repository instance, used to support the Singleton pattern.
         static Repository *instance_;
         //! Get the object ObjectWrapper from ObjectMap
-        virtual const boost::shared_ptr<ObjectWrapper>& getObjectWrapper(const std::string &objectID) const;
+        virtual boost::shared_ptr<ObjectWrapper> getObjectWrapper(const std::string &objectID) const;
 
         //! Register an ObjectWrapper as an Observer of its precedents
         /*! The given ObjectWrapper is registered as an Observer of all of its
@@ -46,10 +46,10 @@ using std::endl;
 namespace ObjectHandler {
 
     // Below are three structures which must be declared as static variables rather than
-    // class members because std::map cannot be exported across DLL boundaries.
+    // class members because std::map and ObjectMap cannot be exported across DLL boundaries.
 
     // The object map declared in the cpp file for the base Repository class.
-    extern Repository::ObjectMap objectMap_;
+    extern ObjectMap objectMap_;
 
     // A map to associate error messages with Excel range addresses.
     typedef std::map<string, shared_ptr<RangeReference> > ErrorMessageMap;
@@ -86,14 +86,14 @@ namespace ObjectHandler {
                 valueObject->setProperty("OBJECTID", objectID);
 
             shared_ptr<ObjectWrapperXL> objectWrapperXL;
-            ObjectMap::const_iterator result = objectMap_.find(objectID);
-            if (result == objectMap_.end()) {
+            shared_ptr<ObjectWrapper> result = objectMap_.find(objectID);
+            if (!result) {
                 objectWrapperXL = shared_ptr<ObjectWrapperXL> (
                     new ObjectWrapperXL(objectID, object, callingRange));
-                objectMap_[objectID] = objectWrapperXL;
+                objectMap_.insert(objectID, objectWrapperXL);
                 callingRange->registerObject(objectID, objectWrapperXL);
             } else {
-                objectWrapperXL = boost::static_pointer_cast<ObjectWrapperXL>(result->second);
+                objectWrapperXL = boost::static_pointer_cast<ObjectWrapperXL>(result);
                 if (objectWrapperXL->callerKey() != callingRange->key()) {
                     OH_REQUIRE(overwrite, "Cannot create object with ID '" << objectID <<
                         "' in cell " << callingRange->addressString() <<
@@ -293,10 +293,10 @@ namespace ObjectHandler {
         for (std::vector<string>::const_iterator i = objectList.begin();
             i != objectList.end(); ++i) {
                 shared_ptr<ObjectWrapperXL> objectWrapperXL;
-                ObjectMap::const_iterator result = objectMap_.find(CallingRange::getStub(*i));
-                if (result != objectMap_.end()) {
+                shared_ptr<ObjectWrapper> result = objectMap_.find(CallingRange::getStub(*i));
+                if (result) {
 
-                    objectWrapperXL = boost::static_pointer_cast<ObjectWrapperXL>(result->second);
+                    objectWrapperXL = boost::static_pointer_cast<ObjectWrapperXL>(result);
 
                     ret.push_back(!objectWrapperXL->getCallingRange()->valid());
                 }
@@ -316,10 +316,10 @@ namespace ObjectHandler {
             i != objectList.end(); ++i) {
 
                 shared_ptr<ObjectWrapperXL> objectWrapperXL;
-                ObjectMap::const_iterator result = objectMap_.find(CallingRange::getStub(*i));
-                if (result != objectMap_.end()) {
+                shared_ptr<ObjectWrapper> result = objectMap_.find(CallingRange::getStub(*i));
+                if (result) {
 
-                    objectWrapperXL = boost::static_pointer_cast<ObjectWrapperXL>(result->second);
+                    objectWrapperXL = boost::static_pointer_cast<ObjectWrapperXL>(result);
 
                     ret.push_back(objectWrapperXL->getCallingRange()->getUpdateCount());
                 }
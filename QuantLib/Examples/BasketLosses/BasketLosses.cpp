@@ -175,16 +175,19 @@ int main(int, char* []) {
         // --- G Random model ---------------------
         // Gaussian random joint default model:
         Size numSimulations = 100000;
-        // Size numCoresUsed = 4;
+        Size numCoresUsed = 4;
         // Sobol, many cores
         boost::shared_ptr<DefaultLossModel> rdlmG(
-            boost::make_shared<RandomDefaultLM<GaussianCopulaPolicy, 
-            RandomSequenceGenerator<
-                BoxMullerGaussianRng<MersenneTwisterUniformRng> > > >(gLM, 
-                    recoveries, numSimulations, 1.e-6, 2863311530));
+            boost::make_shared<RandomDefaultLM<GaussianCopulaPolicy> >(gLM, 
+                recoveries, numSimulations, 1.e-6, 2863311530,
+                numCoresUsed));
+        // Box-Muller can't skip ahead; simulations would run on one core
         //boost::shared_ptr<DefaultLossModel> rdlmG(
-        //    boost::make_shared<RandomDefaultLM<GaussianCopulaPolicy> >(gLM, 
-        //        recoveries, numSimulations, 1.e-6, 2863311530));
+        //    boost::make_shared<RandomDefaultLM<GaussianCopulaPolicy, 
+        //    RandomSequenceGenerator<
+        //        BoxMullerGaussianRng<MersenneTwisterUniformRng> > > >(gLM, 
+        //            recoveries, numSimulations, 1.e-6, 2863311530,
+        //            numCoresUsed));
         theBskt->setLossModel(rdlmG);
 
         std::cout << "Random G Expected 10-Yr Losses: "  << std::endl;
@@ -193,13 +196,16 @@ int main(int, char* []) {
         // --- StudentT Random model ---------------------
         // Sobol, many cores
         boost::shared_ptr<DefaultLossModel> rdlmT(
-            boost::make_shared<RandomDefaultLM<TCopulaPolicy, 
-            RandomSequenceGenerator<
-                PolarStudentTRng<MersenneTwisterUniformRng> > > >(ktTLossLM, 
-                    recoveries, numSimulations, 1.e-6, 2863311530));
+            boost::make_shared<RandomDefaultLM<TCopulaPolicy> >(ktTLossLM, 
+                recoveries, numSimulations, 1.e-6, 2863311530,
+                numCoresUsed));
+        // polar Student-T can't skip ahead; simulations would run on one core
         //boost::shared_ptr<DefaultLossModel> rdlmT(
-        //    boost::make_shared<RandomDefaultLM<TCopulaPolicy> >(ktTLossLM, 
-        //        recoveries, numSimulations, 1.e-6, 2863311530));
+        //    boost::make_shared<RandomDefaultLM<TCopulaPolicy, 
+        //    RandomSequenceGenerator<
+        //        PolarStudentTRng<MersenneTwisterUniformRng> > > >(ktTLossLM, 
+        //            recoveries, numSimulations, 1.e-6, 2863311530,
+        //            numCoresUsed));
         theBskt->setLossModel(rdlmT);
 
         std::cout << "Random T Expected 10-Yr Losses: "  << std::endl;
@@ -224,7 +230,7 @@ int main(int, char* []) {
         // Sobol, many cores
         boost::shared_ptr<DefaultLossModel> rdLlmG(
             boost::make_shared<RandomLossLM<GaussianCopulaPolicy> >(sptLG, 
-                numSimulations, 1.e-6, 2863311530));
+                numSimulations, 1.e-6, 2863311530, numCoresUsed));
         theBskt->setLossModel(rdLlmG);
 
         std::cout << "Random Loss G Expected 10-Yr Losses: "  << std::endl;
@@ -235,7 +241,7 @@ int main(int, char* []) {
         // Sobol, many cores
         boost::shared_ptr<DefaultLossModel> rdLlmT(
             boost::make_shared<RandomLossLM<TCopulaPolicy> >(sptLT, 
-                numSimulations, 1.e-6, 2863311530));
+                numSimulations, 1.e-6, 2863311530, numCoresUsed));
         theBskt->setLossModel(rdLlmT);
 
         std::cout << "Random Loss T Expected 10-Yr Losses: "  << std::endl;
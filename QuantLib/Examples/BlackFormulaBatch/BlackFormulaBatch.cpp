@@ -0,0 +1,232 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*  This example compares the throughput of the scalar Black formulas
+    with that of their batch versions, which take arrays of options.
+    The options are those of a volatility surface with a smile; their
+    prices are calculated and then inverted to implied volatilities.
+*/
+
+// the only header you need to use QuantLib
+#include <ql/quantlib.hpp>
+
+#ifdef BOOST_MSVC
+/* Uncomment the following lines to unmask floating-point
+   exceptions. Warning: unpredictable results can arise...
+
+   See http://www.wilmott.com/messageview.cfm?catid=10&threadid=9481
+   Is there anyone with a definitive word about this?
+*/
+// #include <float.h>
+// namespace { unsigned int u = _controlfp(_EM_INEXACT, _MCW_EM); }
+#endif
+
+#include <boost/timer.hpp>
+#include <iostream>
+#include <iomanip>
+
+using namespace QuantLib;
+
+#ifdef BOOST_MSVC
+#  ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#    include <ql/auto_link.hpp>
+#    define BOOST_LIB_NAME boost_system
+#    include <boost/config/auto_link.hpp>
+#    undef BOOST_LIB_NAME
+#    define BOOST_LIB_NAME boost_thread
+#    include <boost/config/auto_link.hpp>
+#    undef BOOST_LIB_NAME
+#  endif
+#endif
+
+
+#if defined(QL_ENABLE_SESSIONS)
+namespace QuantLib {
+
+    Integer sessionId() { return 0; }
+
+}
+#endif
+
+
+namespace {
+
+    // options in the surface, and times each calculation is repeated
+    const Size expiries = 40, strikesPerExpiry = 50, repetitions = 25;
+
+    void report(const std::string& what, Size n,
+                double scalarTime, double batchTime, Real difference) {
+        std::cout << std::setw(22) << std::left << what
+                  << std::right << std::fixed
+                  << std::setw(12) << std::setprecision(0)
+                  << (scalarTime > 0.0 ? n/scalarTime : 0.0)
+                  << std::setw(12) << std::setprecision(0)
+                  << (batchTime > 0.0 ? n/batchTime : 0.0)
+                  << std::setw(9) << std::setprecision(2)
+                  << (batchTime > 0.0 ? scalarTime/batchTime : 0.0)
+                  << std::setw(12) << std::scientific << std::setprecision(1)
+                  << difference << std::endl;
+    }
+
+}
+
+
+int main(int, char* []) {
+
+    try {
+
+        boost::timer timer;
+        std::cout << std::endl;
+
+        Real forward = 100.0;
+        std::vector<Option::Type> types;
+        std::vector<Real> strikes, forwards, stdDevs, discounts;
+        for (Size i=0; i<expiries; ++i) {
+            Time t = 0.25*(i+1);
+            Real discount = std::exp(-0.02*t);
+            for (Size j=0; j<strikesPerExpiry; ++j) {
+                // strikes from 50% to 200% of the forward
+                Real k = forward*std::exp(std::log(0.5)
+                                          + std::log(4.0)*j/(strikesPerExpiry-1));
+                Real x = std::log(k/forward);
+                Real vol = 0.20 - 0.10*x + 0.15*x*x;
+                types.push_back(k < forward ? Option::Put : Option::Call);
+                strikes.push_back(k);
+                forwards.push_back(forward);
+                stdDevs.push_back(vol*std::sqrt(t));
+                discounts.push_back(discount);
+            }
+        }
+        const Size n = types.size(), total = n*repetitions;
+
+        std::cout << n << " options, each calculation repeated "
+                  << repetitions << " times\n" << std::endl;
+        std::cout << std::setw(22) << std::left << "function"
+                  << std::setw(12) << std::right << "scalar/s"
+                  << std::setw(12) << "batch/s"
+                  << std::setw(9) << "ratio"
+                  << std::setw(12) << "max diff" << std::endl;
+
+        // prices
+        std::vector<Real> prices(n), batchPrices;
+        boost::timer t;
+        for (Size r=0; r<repetitions; ++r)
+            for (Size i=0; i<n; ++i)
+                prices[i] = blackFormula(types[i], strikes[i], forwards[i],
+                                         stdDevs[i], discounts[i]);
+        double scalarTime = t.elapsed();
+        t.restart();
+        for (Size r=0; r<repetitions; ++r)
+            batchPrices = blackFormula(types, strikes, forwards,
+                                       stdDevs, discounts);
+        double batchTime = t.elapsed();
+        Real difference = 0.0;
+        for (Size i=0; i<n; ++i)
+            difference = std::max(difference,
+                                  std::fabs(prices[i]-batchPrices[i]));
+        report("blackFormula", total, scalarTime, batchTime, difference);
+
+        // vegas
+        std::vector<Real> vegas(n), batchVegas;
+        t.restart();
+        for (Size r=0; r<repetitions; ++r)
+            for (Size i=0; i<n; ++i)
+                vegas[i] = blackFormulaStdDevDerivative(
+                              strikes[i], forwards[i], stdDevs[i], discounts[i]);
+        scalarTime = t.elapsed();
+        t.restart();
+        for (Size r=0; r<repetitions; ++r)
+            batchVegas = blackFormulaStdDevDerivative(strikes, forwards,
+                                                      stdDevs, discounts);
+        batchTime = t.elapsed();
+        difference = 0.0;
+        for (Size i=0; i<n; ++i)
+            difference = std::max(difference,
+                                  std::fabs(vegas[i]-batchVegas[i]));
+        report("stdDevDerivative", total, scalarTime, batchTime, difference);
+
+        // Bachelier prices, with the same standard deviations in
+        // absolute terms
+        std::vector<Real> normalStdDevs(n), bachelierPrices(n),
+            batchBachelierPrices;
+        for (Size i=0; i<n; ++i)
+            normalStdDevs[i] = stdDevs[i]*forward;
+        t.restart();
+        for (Size r=0; r<repetitions; ++r)
+            for (Size i=0; i<n; ++i)
+                bachelierPrices[i] = bachelierBlackFormula(
+                                      types[i], strikes[i], forwards[i],
+                                      normalStdDevs[i], discounts[i]);
+        scalarTime = t.elapsed();
+        t.restart();
+        for (Size r=0; r<repetitions; ++r)
+            batchBachelierPrices = bachelierBlackFormula(
+                       types, strikes, forwards, normalStdDevs, discounts);
+        batchTime = t.elapsed();
+        difference = 0.0;
+        for (Size i=0; i<n; ++i)
+            difference = std::max(difference,
+                                  std::fabs(bachelierPrices[i]
+                                            -batchBachelierPrices[i]));
+        report("bachelierBlackFormula", total,
+               scalarTime, batchTime, difference);
+
+        // implied standard deviations
+        const Real accuracy = 1.0e-8;
+        std::vector<Real> implied(n), batchImplied;
+        t.restart();
+        for (Size r=0; r<repetitions; ++r)
+            for (Size i=0; i<n; ++i)
+                implied[i] = blackFormulaImpliedStdDev(
+                                    types[i], strikes[i], forwards[i],
+                                    prices[i], discounts[i], 0.0,
+                                    Null<Real>(), accuracy);
+        scalarTime = t.elapsed();
+        t.restart();
+        for (Size r=0; r<repetitions; ++r)
+            batchImplied = blackFormulaImpliedStdDev(types, strikes, forwards,
+                                                     prices, discounts, 0.0,
+                                                     accuracy);
+        batchTime = t.elapsed();
+        difference = 0.0;
+        for (Size i=0; i<n; ++i)
+            difference = std::max(difference,
+                                  std::fabs(implied[i]-batchImplied[i]));
+        report("impliedStdDev", total, scalarTime, batchTime, difference);
+
+        double seconds = timer.elapsed();
+        Integer hours = int(seconds/3600);
+        seconds -= hours * 3600;
+        Integer minutes = int(seconds/60);
+        seconds -= minutes * 60;
+        std::cout << " \nRun completed in ";
+        if (hours > 0)
+            std::cout << hours << " h ";
+        if (hours > 0 || minutes > 0)
+            std::cout << minutes << " m ";
+        std::cout << std::fixed << std::setprecision(0)
+                  << seconds << " s\n" << std::endl;
+        return 0;
+
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+        return 1;
+    }
+}
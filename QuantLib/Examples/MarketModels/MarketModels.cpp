@@ -40,6 +40,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/quotes/simplequote.hpp>
 #include <sstream>
 #include <iostream>
+#include <string>
 #include <ctime>
 
 using namespace QuantLib;
@@ -804,9 +805,125 @@ int InverseFloater(Real rateLevel)
 
 }
 
-int main()
+// evolves the given number of paths up to the last step
+Real pathsPerSecond(MarketModelEvolver& evolver, Size paths)
+{
+    Size steps = evolver.numeraires().size();
+
+    int t1 = clock();
+
+    for (Size i=0; i < paths; ++i)
+    {
+        evolver.startNewPath();
+        for (Size j=0; j < steps; ++j)
+            evolver.advanceStep();
+    }
+
+    int t2 = clock();
+
+    return paths/((t2-t1)/static_cast<Real>(CLOCKS_PER_SEC));
+}
+
+// paths per second for each evolver on the same model; the figures
+// can be compared between releases to track regressions in the
+// drift computations and the evolution steps.  It is only run when
+// the example is called with the --benchmark option.
+int EvolverBenchmark()
+{
+    Size numberRates = 20;
+    Real accrual = 0.5;
+    Real firstTime = 0.5;
+
+    std::vector<Real> rateTimes(numberRates+1);
+    for (Size i=0; i < rateTimes.size(); ++i)
+        rateTimes[i] = firstTime + i*accrual;
+
+    EvolutionDescription evolution(rateTimes);
+
+    Size seed = 12332;
+    Size paths = 16384;
+
+#ifdef _DEBUG
+    paths = 1024;
+#endif
+
+    Real rateLevel = 0.05;
+    Real volLevel = 0.11;
+    Real beta = 0.2;
+    Real gamma = 1.0;
+    Size numberOfFactors = std::min<Size>(5,numberRates);
+    Spread displacementLevel = 0.02;
+    Size spanningForwards = 2;
+
+    std::vector<Rate> initialRates(numberRates,rateLevel);
+    std::vector<Volatility> volatilities(numberRates, volLevel);
+    std::vector<Spread> displacements(numberRates, displacementLevel);
+
+    boost::shared_ptr<PiecewiseConstantCorrelation> correlations(
+        new ExponentialForwardCorrelation(rateTimes, volLevel, beta, gamma));
+
+    boost::shared_ptr<MarketModel> marketModel(
+        new FlatVol(volatilities, correlations, evolution,
+                    numberOfFactors, initialRates, displacements));
+
+    MTBrownianGeneratorFactory generatorFactory(seed);
+
+    std::vector<Size> moneyMarket(moneyMarketMeasure(evolution));
+    std::vector<Size> terminal(terminalMeasure(evolution));
+
+    std::cout << " evolver benchmark \n";
+    std::cout << " number rates :  " << numberRates << "\n";
+    std::cout << " number factors :  " << numberOfFactors << "\n";
+    std::cout << "paths, " << paths << "\n";
+
+    std::vector<std::string> names;
+    std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers;
+
+    names.push_back("LogNormalFwdRatePc");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new LogNormalFwdRatePc(marketModel, generatorFactory, moneyMarket)));
+    names.push_back("LogNormalFwdRateEuler");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                  moneyMarket)));
+    names.push_back("LogNormalFwdRateBalland");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new LogNormalFwdRateBalland(marketModel, generatorFactory,
+                                    moneyMarket)));
+    names.push_back("LogNormalFwdRateIpc");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new LogNormalFwdRateIpc(marketModel, generatorFactory, terminal)));
+    names.push_back("LogNormalFwdRateiBalland");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new LogNormalFwdRateiBalland(marketModel, generatorFactory,
+                                     terminal)));
+    names.push_back("NormalFwdRatePc");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new NormalFwdRatePc(marketModel, generatorFactory, moneyMarket)));
+    // the same model is used for swap rates; it's only a benchmark
+    names.push_back("LogNormalCotSwapRatePc");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new LogNormalCotSwapRatePc(marketModel, generatorFactory,
+                                   moneyMarket)));
+    names.push_back("LogNormalCmSwapRatePc");
+    evolvers.push_back(boost::shared_ptr<MarketModelEvolver>(
+        new LogNormalCmSwapRatePc(spanningForwards, marketModel,
+                                  generatorFactory, moneyMarket)));
+
+    for (Size i=0; i < evolvers.size(); ++i)
+        std::cout << names[i] << ", "
+                  << pathsPerSecond(*evolvers[i], paths)
+                  << ", paths per second.\n";
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
 {
     try {
+        if (argc > 1 && std::string(argv[1]) == "--benchmark")
+            return EvolverBenchmark();
+
         for (Size i=5; i < 10; ++i)
             InverseFloater(i/100.0);
 
@@ -21,10 +21,9 @@
 */
 
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
-#include <ql/math/solvers1d/brent.hpp>
-#include <ql/math/solvers1d/newtonsafe.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/patterns/visitor.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -565,272 +564,6 @@ namespace QuantLib {
         return targetNpv/bps;
     }
 
-    // IRR utility functions
-    namespace {
-
-        template <class T>
-        Integer sign(T x) {
-            static T zero = T();
-            if (x == zero)
-                return 0;
-            else if (x > zero)
-                return 1;
-            else
-                return -1;
-        }
-
-        Real simpleDuration(const Leg& leg,
-                            const InterestRate& y,
-                            bool includeSettlementDateFlows,
-                            Date settlementDate,
-                            Date npvDate) {
-            if (leg.empty())
-                return 0.0;
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-            if (npvDate == Date())
-                npvDate = settlementDate;
-
-            Real P = 0.0;
-            Real dPdy = 0.0;
-            Time t = 0.0;
-            Date lastDate = npvDate;
-            Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
-            for (Size i=0; i<leg.size(); ++i) {
-                if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                    continue;
-
-                Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
-
-                Date couponDate = leg[i]->date();
-                shared_ptr<Coupon> coupon =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                if (coupon) {
-                    refStartDate = coupon->referencePeriodStart();
-                    refEndDate = coupon->referencePeriodEnd();
-                } else {
-                    if (lastDate == npvDate) {
-                        // we don't have a previous coupon date,
-                        // so we fake it
-                        refStartDate = couponDate - 1*Years;
-                    } else  {
-                        refStartDate = lastDate;
-                    }
-                    refEndDate = couponDate;
-                }
-
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
-
-                DiscountFactor B = y.discountFactor(t);
-                P += c * B;
-                dPdy += t * c * B;
-                
-                lastDate = couponDate;
-            }
-            if (P == 0.0) // no cashflows
-                return 0.0;
-            return dPdy/P;
-        }
-
-        Real modifiedDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
-            if (leg.empty())
-                return 0.0;
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-            if (npvDate == Date())
-                npvDate = settlementDate;
-
-            Real P = 0.0;
-            Time t = 0.0;
-            Real dPdy = 0.0;
-            Rate r = y.rate();
-            Natural N = y.frequency();
-            Date lastDate = npvDate;
-            Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
-            for (Size i=0; i<leg.size(); ++i) {
-                if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                    continue;
-
-                Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
-
-                Date couponDate = leg[i]->date();
-                shared_ptr<Coupon> coupon =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                if (coupon) {
-                    refStartDate = coupon->referencePeriodStart();
-                    refEndDate = coupon->referencePeriodEnd();
-                } else {
-                    if (lastDate == npvDate) {
-                        // we don't have a previous coupon date,
-                        // so we fake it
-                        refStartDate = couponDate - 1*Years;
-                    } else  {
-                        refStartDate = lastDate;
-                    }
-                    refEndDate = couponDate;
-                }
-                
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
-                
-                DiscountFactor B = y.discountFactor(t);
-                P += c * B;
-                switch (y.compounding()) {
-                  case Simple:
-                    dPdy -= c * B*B * t;
-                    break;
-                  case Compounded:
-                    dPdy -= c * t * B/(1+r/N);
-                    break;
-                  case Continuous:
-                    dPdy -= c * B * t;
-                    break;
-                  case SimpleThenCompounded:
-                    if (t<=1.0/N)
-                        dPdy -= c * B*B * t;
-                    else
-                        dPdy -= c * t * B/(1+r/N);
-                    break;
-                  default:
-                    QL_FAIL("unknown compounding convention (" <<
-                            Integer(y.compounding()) << ")");
-                }
-                lastDate = couponDate;
-            }
-
-            if (P == 0.0) // no cashflows
-                return 0.0;
-            return -dPdy/P; // reverse derivative sign
-        }
-
-        Real macaulayDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
-
-            QL_REQUIRE(y.compounding() == Compounded,
-                       "compounded rate required");
-
-            return (1.0+y.rate()/y.frequency()) *
-                modifiedDuration(leg, y,
-                                 includeSettlementDateFlows,
-                                 settlementDate, npvDate);
-        }
-
-        class IrrFinder : public std::unary_function<Rate, Real> {
-          public:
-            IrrFinder(const Leg& leg,
-                      Real npv,
-                      const DayCounter& dayCounter,
-                      Compounding comp,
-                      Frequency freq,
-                      bool includeSettlementDateFlows,
-                      Date settlementDate,
-                      Date npvDate)
-            : leg_(leg), npv_(npv),
-              dayCounter_(dayCounter), compounding_(comp), frequency_(freq),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
-
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-                if (npvDate == Date())
-                    npvDate = settlementDate;
-
-                checkSign();
-            }
-            Real operator()(Rate y) const {
-                InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                Real NPV = CashFlows::npv(leg_, yield,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
-                return npv_ - NPV;
-            }
-            Real derivative(Rate y) const {
-                InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                return modifiedDuration(leg_, yield,
-                                        includeSettlementDateFlows_,
-                                        settlementDate_, npvDate_);
-            }
-          private:
-            void checkSign() const {
-                // depending on the sign of the market price, check that cash
-                // flows of the opposite sign have been specified (otherwise
-                // IRR is nonsensical.)
-
-                Integer lastSign = sign(-npv_),
-                        signChanges = 0;
-                for (Size i = 0; i < leg_.size(); ++i) {
-                    if (!leg_[i]->hasOccurred(settlementDate_,
-                                              includeSettlementDateFlows_) &&
-                        !leg_[i]->tradingExCoupon(settlementDate_)) {
-                        Integer thisSign = sign(leg_[i]->amount());
-                        if (lastSign * thisSign < 0) // sign change
-                            signChanges++;
-
-                        if (thisSign != 0)
-                            lastSign = thisSign;
-                    }
-                }
-                QL_REQUIRE(signChanges > 0,
-                           "the given cash flows cannot result in the given market "
-                           "price due to their sign");
-
-                /* The following is commented out due to the lack of a QL_WARN macro
-                if (signChanges > 1) {    // Danger of non-unique solution
-                                          // Check the aggregate cash flows (Norstrom)
-                    Real aggregateCashFlow = npv;
-                    signChanges = 0;
-                    for (Size i = 0; i < leg.size(); ++i) {
-                        Real nextAggregateCashFlow =
-                            aggregateCashFlow + leg[i]->amount();
-
-                        if (aggregateCashFlow * nextAggregateCashFlow < 0.0)
-                            signChanges++;
-
-                        aggregateCashFlow = nextAggregateCashFlow;
-                    }
-                    if (signChanges > 1)
-                        QL_WARN( "danger of non-unique solution");
-                };
-                */
-            }
-            const Leg& leg_;
-            Real npv_;
-            DayCounter dayCounter_;
-            Compounding compounding_;
-            Frequency frequency_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
-        };
-
-
-
-    } // anonymous namespace ends here
-
     Real CashFlows::npv(const Leg& leg,
                         const InterestRate& y,
                         bool includeSettlementDateFlows,
@@ -947,14 +680,10 @@ namespace QuantLib {
                           Real accuracy,
                           Size maxIterations,
                           Rate guess) {
-        //Brent solver;
-        NewtonSafe solver;
-        solver.setMaxEvaluations(maxIterations);
-        IrrFinder objFunction(leg, npv,
-                              dayCounter, compounding, frequency,
-                              includeSettlementDateFlows,
-                              settlementDate, npvDate);
-        return solver.solve(objFunction, accuracy, guess, guess/10.0);
+        CompiledLeg compiledLeg(leg, includeSettlementDateFlows,
+                                settlementDate, npvDate);
+        return compiledLeg.yield(npv, dayCounter, compounding, frequency,
+                                 accuracy, maxIterations, guess);
     }
 
 
@@ -965,31 +694,9 @@ namespace QuantLib {
                              Date settlementDate,
                              Date npvDate) {
 
-        if (leg.empty())
-            return 0.0;
-
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        switch (type) {
-          case Duration::Simple:
-            return simpleDuration(leg, rate,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-          case Duration::Modified:
-            return modifiedDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
-          case Duration::Macaulay:
-            return macaulayDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
-          default:
-            QL_FAIL("unknown duration type");
-        }
+        CompiledLeg compiledLeg(leg, includeSettlementDateFlows,
+                                settlementDate, npvDate);
+        return compiledLeg.duration(rate, type);
     }
 
     Time CashFlows::duration(const Leg& leg,
@@ -1192,56 +899,6 @@ namespace QuantLib {
                                     settlementDate, npvDate);
     }
 
-    // Z-spread utility functions
-    namespace {
-
-        class ZSpreadFinder : public std::unary_function<Rate, Real> {
-          public:
-            ZSpreadFinder(const Leg& leg,
-                          const shared_ptr<YieldTermStructure>& discountCurve,
-                          Real npv,
-                          const DayCounter& dc,
-                          Compounding comp,
-                          Frequency freq,
-                          bool includeSettlementDateFlows,
-                          Date settlementDate,
-                          Date npvDate)
-            : leg_(leg), npv_(npv), zSpread_(new SimpleQuote(0.0)),
-              curve_(Handle<YieldTermStructure>(discountCurve),
-                     Handle<Quote>(zSpread_), comp, freq, dc),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
-
-                if (settlementDate == Date())
-                    settlementDate = Settings::instance().evaluationDate();
-
-                if (npvDate == Date())
-                    npvDate = settlementDate;
-
-                // if the discount curve allows extrapolation, let's
-                // the spreaded curve do too.
-                curve_.enableExtrapolation(
-                                  discountCurve->allowsExtrapolation());
-            }
-            Real operator()(Rate zSpread) const {
-                zSpread_->setValue(zSpread);
-                Real NPV = CashFlows::npv(leg_, curve_,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
-                return npv_ - NPV;
-            }
-          private:
-            const Leg& leg_;
-            Real npv_;
-            shared_ptr<SimpleQuote> zSpread_;
-            ZeroSpreadedTermStructure curve_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
-        };
-
-    } // anonymous namespace ends here
-
     Real CashFlows::npv(const Leg& leg,
                         const shared_ptr<YieldTermStructure>& discountCurve,
                         Spread zSpread,
@@ -1295,15 +952,11 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Brent solver;
-        solver.setMaxEvaluations(maxIterations);
-        ZSpreadFinder objFunction(leg,
-                                  discount,
-                                  npv,
-                                  dayCounter, compounding, frequency, includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-        Real step = 0.01;
-        return solver.solve(objFunction, accuracy, guess, step);
+        CompiledLeg compiledLeg(leg, includeSettlementDateFlows,
+                                settlementDate, npvDate);
+        return compiledLeg.zSpread(npv, discount,
+                                   dayCounter, compounding, frequency,
+                                   accuracy, maxIterations, guess);
     }
 
 }
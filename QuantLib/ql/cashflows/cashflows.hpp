@@ -37,7 +37,12 @@ namespace QuantLib {
     class YieldTermStructure;
 
     //! %cashflow-analysis functions
-    /*! \todo add tests */
+    /*! The yield and z-spread solvers work on a CompiledLeg, which
+        can also be used directly when the same leg is analyzed
+        several times.
+
+        \todo add tests
+    */
     class CashFlows {
       private:
         CashFlows();
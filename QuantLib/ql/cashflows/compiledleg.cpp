@@ -0,0 +1,420 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
+#include <ql/settings.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        const Spread basisPoint_ = 1.0e-4;
+
+        template <class T>
+        Integer sign(T x) {
+            static T zero = T();
+            if (x == zero)
+                return 0;
+            else if (x > zero)
+                return 1;
+            else
+                return -1;
+        }
+
+        // modified duration of the given amounts, paid after the
+        // given year fractions from each other
+        Real modifiedDuration(const std::vector<Real>& amounts,
+                              const std::vector<Time>& periods,
+                              const InterestRate& yield) {
+            Real P = 0.0;
+            Time t = 0.0;
+            Real dPdy = 0.0;
+            Rate r = yield.rate();
+            Natural N = yield.frequency();
+            for (Size i=0; i<amounts.size(); ++i) {
+                Real c = amounts[i];
+                t += periods[i];
+                DiscountFactor B = yield.discountFactor(t);
+                P += c * B;
+                switch (yield.compounding()) {
+                  case Simple:
+                    dPdy -= c * B*B * t;
+                    break;
+                  case Compounded:
+                    dPdy -= c * t * B/(1+r/N);
+                    break;
+                  case Continuous:
+                    dPdy -= c * B * t;
+                    break;
+                  case SimpleThenCompounded:
+                    if (t<=1.0/N)
+                        dPdy -= c * B*B * t;
+                    else
+                        dPdy -= c * t * B/(1+r/N);
+                    break;
+                  default:
+                    QL_FAIL("unknown compounding convention (" <<
+                            Integer(yield.compounding()) << ")");
+                }
+            }
+            if (P == 0.0) // no cashflows
+                return 0.0;
+            return -dPdy/P; // reverse derivative sign
+        }
+
+        // The year fractions between cash flows are calculated once
+        // for all the iterations; the rest of the calculations are
+        // done in the same order as in CashFlows, so that the
+        // results are the same.
+        class IrrFinder : public std::unary_function<Rate, Real> {
+          public:
+            IrrFinder(const std::vector<Real>& amounts,
+                      const std::vector<Time>& periods,
+                      Real npv,
+                      const DayCounter& dayCounter,
+                      Compounding comp,
+                      Frequency freq)
+            : amounts_(amounts), periods_(periods), npv_(npv),
+              dayCounter_(dayCounter), compounding_(comp),
+              frequency_(freq) {
+                checkSign();
+            }
+            Real operator()(Rate y) const {
+                InterestRate yield(y, dayCounter_, compounding_, frequency_);
+                Real NPV = 0.0;
+                DiscountFactor discount = 1.0;
+                for (Size i=0; i<amounts_.size(); ++i) {
+                    discount *= yield.discountFactor(periods_[i]);
+                    NPV += amounts_[i] * discount;
+                }
+                return npv_ - NPV;
+            }
+            // modified duration
+            Real derivative(Rate y) const {
+                return modifiedDuration(amounts_, periods_,
+                                        InterestRate(y, dayCounter_,
+                                                     compounding_,
+                                                     frequency_));
+            }
+          private:
+            void checkSign() const {
+                // depending on the sign of the market price, check that
+                // cash flows of the opposite sign have been specified
+                // (otherwise IRR is nonsensical.)
+                Integer lastSign = sign(-npv_),
+                        signChanges = 0;
+                for (Size i=0; i<amounts_.size(); ++i) {
+                    Integer thisSign = sign(amounts_[i]);
+                    if (lastSign * thisSign < 0) // sign change
+                        signChanges++;
+                    if (thisSign != 0)
+                        lastSign = thisSign;
+                }
+                QL_REQUIRE(signChanges > 0,
+                           "the given cash flows cannot result in the "
+                           "given market price due to their sign");
+            }
+            const std::vector<Real>& amounts_;
+            const std::vector<Time>& periods_;
+            Real npv_;
+            DayCounter dayCounter_;
+            Compounding compounding_;
+            Frequency frequency_;
+        };
+
+        // The zero rates of the discount curve are calculated once for
+        // all the iterations; the spread is added to them as done by
+        // ZeroSpreadedTermStructure.
+        class SpreadedDiscount {
+          public:
+            SpreadedDiscount(const YieldTermStructure& discountCurve,
+                             const std::vector<Date>& dates,
+                             const std::vector<bool>& skip,
+                             Compounding comp,
+                             Frequency freq) {
+                times_.resize(dates.size());
+                zeroRates_.resize(dates.size());
+                for (Size i=0; i<dates.size(); ++i) {
+                    if (skip[i])
+                        continue;
+                    // checks the range of the curve
+                    discountCurve.discount(dates[i]);
+                    times_[i] = discountCurve.timeFromReference(dates[i]);
+                    if (times_[i] != 0.0)
+                        zeroRates_[i] = discountCurve.zeroRate(times_[i],
+                                                               comp, freq,
+                                                               true);
+                }
+            }
+            DiscountFactor operator()(Size i, Spread zSpread) const {
+                Time t = times_[i];
+                if (t == 0.0)
+                    return 1.0;
+                const InterestRate& zeroRate = zeroRates_[i];
+                InterestRate spreadedRate(zeroRate + zSpread,
+                                          zeroRate.dayCounter(),
+                                          zeroRate.compounding(),
+                                          zeroRate.frequency());
+                Rate r = spreadedRate.equivalentRate(Continuous,
+                                                     NoFrequency, t);
+                return DiscountFactor(std::exp(-r*t));
+            }
+          private:
+            std::vector<Time> times_;
+            std::vector<InterestRate> zeroRates_;
+        };
+
+        class ZSpreadFinder : public std::unary_function<Rate, Real> {
+          public:
+            ZSpreadFinder(const std::vector<Real>& amounts,
+                          const std::vector<bool>& exCoupon,
+                          const SpreadedDiscount& discount,
+                          Real npv)
+            : amounts_(amounts), exCoupon_(exCoupon),
+              discount_(discount), npv_(npv) {}
+            Real operator()(Rate zSpread) const {
+                Real NPV = 0.0;
+                // the last discount is the one at the npv date
+                Size n = amounts_.size();
+                for (Size i=0; i<n; ++i) {
+                    if (!exCoupon_[i])
+                        NPV += amounts_[i] * discount_(i, zSpread);
+                }
+                return npv_ - NPV/discount_(n, zSpread);
+            }
+          private:
+            const std::vector<Real>& amounts_;
+            const std::vector<bool>& exCoupon_;
+            const SpreadedDiscount& discount_;
+            Real npv_;
+        };
+
+    }
+
+    CompiledLeg::CompiledLeg(const Leg& leg,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate)
+    : emptyLeg_(leg.empty()) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        settlementDate_ = settlementDate;
+        npvDate_ = npvDate;
+
+        Date lastDate = npvDate;
+        for (Size i=0; i<leg.size(); ++i) {
+            const CashFlow& cf = *leg[i];
+            if (cf.hasOccurred(settlementDate, includeSettlementDateFlows))
+                continue;
+
+            Date couponDate = cf.date();
+            dates_.push_back(couponDate);
+            amounts_.push_back(cf.amount());
+            exCoupon_.push_back(cf.tradingExCoupon(settlementDate));
+
+            const Coupon* coupon = dynamic_cast<const Coupon*>(&cf);
+            if (coupon) {
+                bpsFactors_.push_back(coupon->nominal() *
+                                      coupon->accrualPeriod());
+                refStartDates_.push_back(coupon->referencePeriodStart());
+                refEndDates_.push_back(coupon->referencePeriodEnd());
+            } else {
+                bpsFactors_.push_back(0.0);
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDates_.push_back(couponDate - 1*Years);
+                } else  {
+                    refStartDates_.push_back(lastDate);
+                }
+                refEndDates_.push_back(couponDate);
+            }
+            lastDate = couponDate;
+        }
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve) const {
+        if (emptyLeg_)
+            return 0.0;
+
+        Real totalNPV = 0.0;
+        for (Size i=0; i<dates_.size(); ++i) {
+            if (!exCoupon_[i])
+                totalNPV += amounts_[i] * discountCurve.discount(dates_[i]);
+        }
+        return totalNPV/discountCurve.discount(npvDate_);
+    }
+
+    Real CompiledLeg::bps(const YieldTermStructure& discountCurve) const {
+        if (emptyLeg_)
+            return 0.0;
+
+        Real bps = 0.0;
+        for (Size i=0; i<dates_.size(); ++i) {
+            if (!exCoupon_[i])
+                bps += bpsFactors_[i] * discountCurve.discount(dates_[i]);
+        }
+        return basisPoint_*bps/discountCurve.discount(npvDate_);
+    }
+
+    Real CompiledLeg::npv(const InterestRate& y) const {
+        Real npv = 0.0;
+        DiscountFactor discount = 1.0;
+        Date lastDate = npvDate_;
+        for (Size i=0; i<dates_.size(); ++i) {
+            DiscountFactor b = y.discountFactor(lastDate, dates_[i],
+                                                refStartDates_[i],
+                                                refEndDates_[i]);
+            discount *= b;
+            lastDate = dates_[i];
+            if (!exCoupon_[i])
+                npv += amounts_[i] * discount;
+        }
+        return npv;
+    }
+
+    Rate CompiledLeg::yield(Real npv,
+                            const DayCounter& dayCounter,
+                            Compounding compounding,
+                            Frequency frequency,
+                            Real accuracy,
+                            Size maxIterations,
+                            Rate guess) const {
+        std::vector<Real> amounts(dates_.size());
+        std::vector<Time> periods(dates_.size());
+        Date lastDate = npvDate_;
+        for (Size i=0; i<dates_.size(); ++i) {
+            QL_REQUIRE(dates_[i] >= lastDate,
+                       "d1 (" << lastDate << ") "
+                       "later than d2 (" << dates_[i] << ")");
+            periods[i] = dayCounter.yearFraction(lastDate, dates_[i],
+                                                 refStartDates_[i],
+                                                 refEndDates_[i]);
+            amounts[i] = exCoupon_[i] ? 0.0 : amounts_[i];
+            lastDate = dates_[i];
+        }
+
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        IrrFinder objFunction(amounts, periods, npv,
+                              dayCounter, compounding, frequency);
+        return solver.solve(objFunction, accuracy, guess, guess/10.0);
+    }
+
+    std::vector<Time>
+    CompiledLeg::periods(const DayCounter& dayCounter) const {
+        std::vector<Time> result(dates_.size());
+        Date lastDate = npvDate_;
+        for (Size i=0; i<dates_.size(); ++i) {
+            result[i] = dayCounter.yearFraction(lastDate, dates_[i],
+                                                refStartDates_[i],
+                                                refEndDates_[i]);
+            lastDate = dates_[i];
+        }
+        return result;
+    }
+
+    Time CompiledLeg::duration(const InterestRate& y,
+                               Duration::Type type) const {
+        if (emptyLeg_)
+            return 0.0;
+
+        std::vector<Real> amounts(dates_.size());
+        for (Size i=0; i<dates_.size(); ++i)
+            amounts[i] = exCoupon_[i] ? 0.0 : amounts_[i];
+        std::vector<Time> t = periods(y.dayCounter());
+
+        switch (type) {
+          case Duration::Simple: {
+              Real P = 0.0;
+              Real dPdy = 0.0;
+              Time time = 0.0;
+              for (Size i=0; i<amounts.size(); ++i) {
+                  time += t[i];
+                  DiscountFactor B = y.discountFactor(time);
+                  P += amounts[i] * B;
+                  dPdy += time * amounts[i] * B;
+              }
+              if (P == 0.0) // no cashflows
+                  return 0.0;
+              return dPdy/P;
+          }
+          case Duration::Modified:
+            return modifiedDuration(amounts, t, y);
+          case Duration::Macaulay:
+            QL_REQUIRE(y.compounding() == Compounded,
+                       "compounded rate required");
+            return (1.0+y.rate()/y.frequency()) *
+                modifiedDuration(amounts, t, y);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
+    Real CompiledLeg::npv(
+                   const boost::shared_ptr<YieldTermStructure>& discountCurve,
+                   Spread zSpread,
+                   const DayCounter&,
+                   Compounding compounding,
+                   Frequency frequency) const {
+        if (emptyLeg_)
+            return 0.0;
+
+        std::vector<Date> dates(dates_);
+        dates.push_back(npvDate_);
+        std::vector<bool> skip(exCoupon_);
+        skip.push_back(false);
+        SpreadedDiscount discount(*discountCurve, dates, skip,
+                                  compounding, frequency);
+        return -ZSpreadFinder(amounts_, exCoupon_, discount, 0.0)(zSpread);
+    }
+
+    Spread CompiledLeg::zSpread(
+                   Real npv,
+                   const boost::shared_ptr<YieldTermStructure>& discountCurve,
+                   const DayCounter&,
+                   Compounding compounding,
+                   Frequency frequency,
+                   Real accuracy,
+                   Size maxIterations,
+                   Rate guess) const {
+        // the discount at the npv date is stored last
+        std::vector<Date> dates(dates_);
+        dates.push_back(npvDate_);
+        std::vector<bool> skip(exCoupon_);
+        skip.push_back(false);
+        SpreadedDiscount discount(*discountCurve, dates, skip,
+                                  compounding, frequency);
+
+        Brent solver;
+        solver.setMaxEvaluations(maxIterations);
+        ZSpreadFinder objFunction(amounts_, exCoupon_, discount, npv);
+        Real step = 0.01;
+        return solver.solve(objFunction, accuracy, guess, step);
+    }
+
+}
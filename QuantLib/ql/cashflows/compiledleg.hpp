@@ -0,0 +1,126 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief flattened cash flows for repeated analysis
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/cashflows/duration.hpp>
+#include <ql/interestrate.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+
+    //! flattened cash flows for repeated analysis
+    /*! The cash flows of a leg that didn't occur at the settlement
+        date are read once and stored in plain arrays, together with
+        their payment dates, reference periods and basis-point
+        sensitivities; the functions below work on the arrays and
+        return the same results as the corresponding ones in the
+        CashFlows class, without any virtual call or cast on the
+        cash flows.  This pays off when the same leg is analyzed
+        several times, e.g., when solving for its yield or z-spread,
+        when calculating its duration at several yields, or when a
+        book of bonds is priced on several curves.
+
+        \warning the amounts are read at construction; if they
+                 depend on market data (as for floating-rate
+                 coupons) a new instance must be built when the
+                 data change.
+
+        \test the results are checked against the CashFlows
+              functions for fixed- and floating-rate legs.
+    */
+    class CompiledLeg {
+      public:
+        CompiledLeg(const Leg& leg,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate = Date(),
+                    Date npvDate = Date());
+        //! \name Inspectors
+        //@{
+        //! number of cash flows that didn't occur at settlement
+        Size size() const { return dates_.size(); }
+        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Real>& amounts() const { return amounts_; }
+        Date settlementDate() const { return settlementDate_; }
+        Date npvDate() const { return npvDate_; }
+        //@}
+        //! \name YieldTermStructure functions
+        //@{
+        //! same as CashFlows::npv
+        Real npv(const YieldTermStructure& discountCurve) const;
+        //! same as CashFlows::bps
+        Real bps(const YieldTermStructure& discountCurve) const;
+        //@}
+        //! \name Yield functions
+        //@{
+        //! same as CashFlows::npv
+        Real npv(const InterestRate& yield) const;
+        //! same as CashFlows::yield
+        Rate yield(Real npv,
+                   const DayCounter& dayCounter,
+                   Compounding compounding,
+                   Frequency frequency,
+                   Real accuracy = 1.0e-10,
+                   Size maxIterations = 100,
+                   Rate guess = 0.05) const;
+        //! same as CashFlows::duration
+        Time duration(const InterestRate& yield,
+                      Duration::Type type) const;
+        //@}
+        //! \name Z-spread functions
+        //@{
+        //! same as CashFlows::npv
+        Real npv(const boost::shared_ptr<YieldTermStructure>& discountCurve,
+                 Spread zSpread,
+                 const DayCounter& dayCounter,
+                 Compounding compounding,
+                 Frequency frequency) const;
+        //! same as CashFlows::zSpread
+        Spread zSpread(Real npv,
+                       const boost::shared_ptr<YieldTermStructure>&,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Real accuracy = 1.0e-10,
+                       Size maxIterations = 100,
+                       Rate guess = 0.0) const;
+        //@}
+      private:
+        // year fractions between consecutive payments
+        std::vector<Time> periods(const DayCounter& dayCounter) const;
+        bool emptyLeg_;
+        Date settlementDate_, npvDate_;
+        std::vector<Date> dates_;
+        std::vector<Real> amounts_;
+        // nominal times accrual period for coupons, null otherwise
+        std::vector<Real> bpsFactors_;
+        // reference periods used for the year fractions of yields
+        std::vector<Date> refStartDates_, refEndDates_;
+        std::vector<bool> exCoupon_;
+    };
+
+}
+
+#endif
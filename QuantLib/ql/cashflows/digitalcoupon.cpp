@@ -236,7 +236,7 @@ namespace QuantLib {
         if (fixingDate == today) {
             // might have been fixed
             Rate pastFixing =
-                IndexManager::instance().getHistory((underlying_->index())->name())[fixingDate];
+                IndexManager::instance().fixing((underlying_->index())->name(), fixingDate);
             if (pastFixing != Null<Real>()) {
                 return underlyingRate + callCsi_ * callPayoff() + putCsi_  * putPayoff();
             } else
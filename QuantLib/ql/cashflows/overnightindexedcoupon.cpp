@@ -55,8 +55,8 @@ namespace QuantLib {
                 Date today = Settings::instance().evaluationDate();
                 while (i<n && fixingDates[i]<today) {
                     // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
+                    Rate pastFixing = IndexManager::instance().fixing(
+                                                index->name(), fixingDates[i]);
                     QL_REQUIRE(pastFixing != Null<Real>(),
                                "Missing " << index->name() <<
                                " fixing for " << fixingDates[i]);
@@ -68,8 +68,8 @@ namespace QuantLib {
                 if (i<n && fixingDates[i] == today) {
                     // might have been fixed
                     try {
-                        Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
+                        Rate pastFixing = IndexManager::instance().fixing(
+                                                index->name(), fixingDates[i]);
                         if (pastFixing != Null<Real>()) {
                             compoundFactor *= (1.0 + pastFixing*dt[i]);
                             ++i;
@@ -25,6 +25,7 @@
 #include <ql/math/statistics/riskstatistics.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/haltonrsg.hpp>
 #include <ql/experimental/credit/basket.hpp>
 #include <ql/experimental/credit/defaultlossmodel.hpp>
 
@@ -35,6 +36,7 @@
 #include <ql/experimental/math/tcopulapolicy.hpp>
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
@@ -67,16 +69,52 @@ namespace QuantLib {
     // replaces class Loss
     template <class simEventOwner> struct simEvent;
 
+    namespace detail {
+
+        // tells whether a sequence generator can skip samples in
+        // constant time, as the low-discrepancy ones do; pseudo-random
+        // generators (and the rejection samplers built on them) have
+        // to draw and discard the skipped numbers
+        template <class USNG>
+        struct skips_in_constant_time : boost::false_type {};
+
+        template <>
+        struct skips_in_constant_time<SobolRsg> : boost::true_type {};
+
+        template <>
+        struct skips_in_constant_time<HaltonRsg> : boost::true_type {};
+
+    }
+
 
     /*! Base class for latent model monte carlo simulation. Independent of the
     copula type and the generator.
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample and
+    append them to the given buffer. They also have the accompanying event
+    trait to specify.
+
+    Statistics can be computed on several threads (when the library is
+    compiled with OpenMP support.) The simulations themselves are run on
+    several threads only if the generator can skip samples in constant
+    time, i.e., for the low-discrepancy SobolRsg and HaltonRsg; each thread
+    then runs a contiguous block of simulations on its own copy of the
+    generator, moved ahead to the first sample of the block. Pseudo-random
+    generators, and the Box-Muller and polar Student-T samplers built on
+    them, would have to draw all the skipped numbers; with them, the
+    simulations are run serially. In both cases, blocks are stored in order
+    and the results don't depend on the number of threads. nextSample must
+    be safe to call concurrently, which is the case as long as it only reads
+    the model, the basket and the curves; these are calculated before the
+    threads are started.
+
+    Events are stored contiguously for all simulations, with the position of
+    the first event of each simulation kept aside; this avoids a heap
+    allocation per simulation, most of them having few or no events. The
+    statistics compute the simulated losses on the same threads.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -84,11 +122,6 @@ namespace QuantLib {
     positions that part of the problem will be starting to overtake the
     simulation costs.
 
-    \todo: someone with sound experience on cache misses look into this, the
-    statistics will be getting memory in and out of the cpu heavily and it
-    might be possible to get performance out of that.
-    \todo: parallelize the statistics computation, things like Var/ESF splits
-    are very expensive.
     \todo: consider another design, taking the statistics outside the models.
     */
     template<template <class, class> class derivedRandomLM, class copulaPolicy,
@@ -101,16 +134,36 @@ namespace QuantLib {
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
     protected:
+        typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > event_type;
+        //! read-only view on the events of a simulation
+        class SimEvents {
+          public:
+            typedef typename std::vector<event_type>::const_iterator
+                const_iterator;
+            SimEvents(const_iterator begin, const_iterator end)
+            : begin_(begin), end_(end) {}
+            Size size() const { return end_ - begin_; }
+            const event_type& operator[](Size i) const { return begin_[i]; }
+            const_iterator begin() const { return begin_; }
+            const_iterator end() const { return end_; }
+          private:
+            const_iterator begin_, end_;
+        };
+
         RandomLM(Size numFactors,
             Size numLMVars,
             const copulaPolicy& copula,
             Size nSims,
-            BigNatural seed)
+            BigNatural seed,
+            Size nThreads = 1)
         : seed_(seed), numFactors_(numFactors), numLMVars_(numLMVars),
-          nSims_(nSims), copula_(copula) {}
+          nSims_(nSims), nThreads_(nThreads), copula_(copula) {
+            QL_REQUIRE(nThreads_ > 0, "at least one thread is required");
+        }
 
         void update() {
-            simsBuffer_.clear();
+            simsEvents_.clear();
+            simsOffsets_.clear();
             // tell basket to notify instruments, etc, we are invalid
             if(!basket_.empty()) basket_->notifyObservers();
             LazyObject::update();
@@ -124,34 +177,59 @@ namespace QuantLib {
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
+            simsEvents_.clear();
+            simsOffsets_.assign(1, 0);
+            if(nThreads_ > 1 && nSims_ > 1)
+                performSimulations(parallel_simulations());
+            else
+                performSimulations(boost::false_type());
+        }
+
+        void performSimulations(boost::false_type) const {
+            // Next sequence should determine the events and push them into
+            //   the buffer
             for(Size i=nSims_; i; i--) {
                 const std::vector<Real>& sample =
                     copulasRng_->nextSequence().value;
                 static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+                    this)->nextSample(sample, simsEvents_);
+                simsOffsets_.push_back(simsEvents_.size());
             }
         }
 
-        /* Method to access simulation results and avoiding a copy of
-        each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
-        stored.
+        void performSimulations(boost::true_type) const;
+
+        /* Method to access simulation results; it detaches the statistics
+        from the way the simulations are stored. PerformCalculations should
+        have been called.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        SimEvents getSim(const Size iSim) const {
+            return SimEvents(simsEvents_.begin() + simsOffsets_[iSim],
+                simsEvents_.begin() + simsOffsets_[iSim+1]);
+        }
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
-        Real getEventRecovery(
-            const simEvent<derivedRandomLM<copulaPolicy, USNG> >& evt) const
+        Real getEventRecovery(const event_type& evt) const
         {
             return static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
                 this)->getEventRecovery(evt);
         }
 
+        /* Portfolio loss of the events in a simulation taking place before
+        the given number of days from today. */
+        Real simulatedLoss(const SimEvents& events, BigInteger val,
+            const Date& today) const;
+        /* Tranched portfolio losses at the given date, indexed by simulation.
+        The simulations are split among the threads. */
+        Disposable<std::vector<Real> > trancheLosses(const Date& d) const;
+        /* Appends to the given buffer the relative split of the tranche loss
+        among the live names for each simulation in [begin, end) whose loss
+        is over the given level. */
+        void splitSimulations(Size begin, Size end, Real loss,
+            BigInteger val, const Date& today,
+            std::vector<Real>& splits) const;
+
         //! \name Statistics, DefaultLossModel interface.
         // These are virtual and allow for children-specific optimization and
         //   variance reduction. The virtual table is ok, they are not part
@@ -204,16 +282,22 @@ namespace QuantLib {
         //@}
     public:
         virtual ~RandomLM() {}
+        Size threads() const { return nThreads_; }
     private:
+        typedef boost::integral_constant<bool,
+            detail::skips_in_constant_time<USNG>::value> parallel_simulations;
         BigNatural seed_;
     protected:
         const Size numFactors_;
         const Size numLMVars_;
 
         const Size nSims_;
+        const Size nThreads_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        // events of all simulations; those of the i-th one are in the range
+        //   [simsOffsets_[i], simsOffsets_[i+1])
+        mutable std::vector<event_type> simsEvents_;
+        mutable std::vector<Size> simsOffsets_;
 
         mutable copulaPolicy copula_;
         mutable boost::shared_ptr<copulaRNG_type> copulasRng_;
@@ -224,6 +308,119 @@ namespace QuantLib {
     };
 
 
+    /* ---- Simulation ---------------------------------------------------  */
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::performSimulations(boost::true_type) const {
+        const D<C, URNG>* model = static_cast<const D<C, URNG>* >(this);
+
+        // lazy objects in the basket or in the curves are not thread safe;
+        // the first simulation is run here so that any pending calculation
+        // is triggered before entering the parallel loop
+        model->nextSample(copulasRng_->nextSequence().value, simsEvents_);
+        simsOffsets_.push_back(simsEvents_.size());
+
+        const Size remaining = nSims_-1;
+        const Size chunks = std::min(nThreads_, remaining);
+        std::vector<std::vector<event_type> > events(chunks);
+        std::vector<std::vector<Size> > offsets(chunks);
+        std::vector<std::string> errors(chunks);
+
+        #pragma omp parallel for num_threads(nThreads_) schedule(static,1)
+        for (Size c=0; c<chunks; ++c) {
+            const Size begin = (c*remaining)/chunks,
+                       end = ((c+1)*remaining)/chunks;
+            try {
+                copulaRNG_type generator(*copulasRng_);
+                generator.skip(begin);
+                offsets[c].reserve(end-begin);
+                for (Size j=begin; j<end; ++j) {
+                    model->nextSample(generator.nextSequence().value,
+                        events[c]);
+                    offsets[c].push_back(events[c].size());
+                }
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            } catch (...) {
+                errors[c] = "unknown error";
+            }
+        }
+
+        for (Size c=0; c<chunks; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+
+        // chunks are appended in order, as they would have been serially
+        simsOffsets_.reserve(nSims_+1);
+        for (Size c=0; c<chunks; ++c) {
+            const Size base = simsEvents_.size();
+            simsEvents_.insert(simsEvents_.end(),
+                events[c].begin(), events[c].end());
+            std::vector<event_type>().swap(events[c]);
+            for (Size j=0; j<offsets[c].size(); ++j)
+                simsOffsets_.push_back(base + offsets[c][j]);
+        }
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Real RandomLM<D, C, URNG>::simulatedLoss(const SimEvents& events,
+        BigInteger val, const Date& today) const
+    {
+        Real portfSimLoss=0.;
+        for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+            // if event is within time horizon...
+            if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
+                Size iName = events[iEvt].nameIdx;
+                // test needed to reuse simulations:
+                //  if(basket_->pool()->has(copula_->pool()->names()[iName]))
+                portfSimLoss +=
+                    basket_->exposure(basket_->names()[iName],
+                        Date(events[iEvt].dayFromRef +
+                            today.serialNumber())) *
+                                (1.-getEventRecovery(events[iEvt]));
+            }
+        }
+        return portfSimLoss;
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Disposable<std::vector<Real> > RandomLM<D, C, URNG>::trancheLosses(
+        const Date& d) const
+    {
+        calculate();
+        Date today = Settings::instance().evaluationDate();
+        BigInteger val = d.serialNumber() - today.serialNumber();
+
+        Real attachAmount = basket_->attachmentAmount();
+        Real detachAmount = basket_->detachmentAmount();
+
+        std::vector<Real> losses(nSims_);
+        const Size chunks = std::max<Size>(std::min(nThreads_, nSims_), 1);
+        std::vector<std::string> errors(chunks);
+
+        #pragma omp parallel for num_threads(nThreads_) schedule(static,1)
+        for (Size c=0; c<chunks; ++c) {
+            try {
+                for (Size iSim=(c*nSims_)/chunks;
+                     iSim<((c+1)*nSims_)/chunks; iSim++)
+                    losses[iSim] = std::min(std::max(
+                        simulatedLoss(getSim(iSim), val, today)
+                            - attachAmount, 0.), detachAmount - attachAmount);
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            } catch (...) {
+                errors[c] = "unknown error";
+            }
+        }
+
+        for (Size c=0; c<chunks; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+
+        return losses;
+    }
+
+
     /* ---- Statistics ---------------------------------------------------  */
 
     template<template <class, class> class D, class C, class URNG>
@@ -242,8 +439,7 @@ namespace QuantLib {
         Real counts = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
+            const SimEvents events = getSim(iSim);
             for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 // duck type on the members:
                 if(val > events[iEvt].dayFromRef) simCount++;
@@ -270,7 +466,7 @@ namespace QuantLib {
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -314,7 +510,7 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -348,35 +544,10 @@ namespace QuantLib {
     std::pair<Real, Real> RandomLM<D, C, URNG>::expectedTrancheLossInterval(
         const Date& d, Probability confidencePerc) const
     {
-        calculate();
-        Date today = Settings::instance().evaluationDate();
-        BigInteger val = d.serialNumber() - today.serialNumber();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        // Real trancheLoss= 0.;
+        std::vector<Real> losses = trancheLosses(d);
         GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                // if event is within time horizon...
-                if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-               }
-            }
-            lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
-                    detachAmount - attachAmount) );
-        }
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            lossStats.add(losses[iSim]);
         return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
             InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
     }
@@ -402,39 +573,13 @@ namespace QuantLib {
 
     template<template <class, class> class D, class C, class URNG>
     Histogram RandomLM<D, C, URNG>::computeHistogram(const Date& d) const {
-        std::vector<Real> data;
-        std::set<Real> keys;// attainable loss values
-        keys.insert(0.);
         Date today = Settings::instance().evaluationDate();
-        BigInteger val = d.serialNumber() - today.serialNumber();
         // redundant test? should have been tested by the basket caller?
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
 
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+        std::vector<Real> data = trancheLosses(d);
 
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-          // test needed (here and the others) to reuse simulations:
-          //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            data.push_back(std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount));
-            keys.insert(data.back());
-        }
         // avoid using as many points as in the simulation.
         Size nPts = std::min<Size>(data.size(), 150);// fix
         return Histogram(data.begin(), data.end(), nPts);
@@ -450,33 +595,10 @@ namespace QuantLib {
             "Requested percentile date must lie after computation date.");
         calculate();
 
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
         BigInteger val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
-        //GenericRiskStatistics<GeneralStatistics> statsX;
-        std::vector<Real> losses;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                    //if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            losses.push_back(portfSimLoss);
-        }
+        std::vector<Real> losses = trancheLosses(d);
 
         std::sort(losses.begin(), losses.end());
         Real posit = std::ceil(percent * nSims_);
@@ -543,31 +665,7 @@ namespace QuantLib {
             "Incorrect percentile");
         calculate();
 
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        std::vector<Real> rankLosses;
-        Date today = Settings::instance().evaluationDate();
-        BigInteger val = d.serialNumber() - today.serialNumber();
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                 //   if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            // update dataset for rank stat:
-            rankLosses.push_back(portfSimLoss);
-        }
+        std::vector<Real> rankLosses = trancheLosses(d);
 
         std::sort(rankLosses.begin(), rankLosses.end());
         Size quantilePosition = static_cast<Size>(floor(nSims_*percentile));
@@ -630,49 +728,28 @@ namespace QuantLib {
     }
 
 
-    // parallelize this one(if possible), it is really expensive
     template<template <class, class> class D, class C, class URNG>
-    /* FIX ME: some trouble on limit cases, like zero loss or no losses over the
-    requested level.*/
-    Disposable<std::vector<std::vector<Real> > >
-        RandomLM<D, C, URNG>::splitVaRAndError(const Date& date, Real loss,
-            Probability confInterval) const
+    void RandomLM<D, C, URNG>::splitSimulations(Size begin, Size end,
+        Real loss, BigInteger val, const Date& today,
+        std::vector<Real>& splits) const
     {
-        /* Check 'loss' value integrity: i.e. is within tranche limits? (should
-            have been done basket...)*/
-        calculate();
-
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
         Size numLiveNames = basket_->remainingSize();
 
         std::vector<Real> split(numLiveNames, 0.);
-        std::vector<GeneralStatistics> splitStats(numLiveNames,
-            GeneralStatistics());
-        Date today = Settings::instance().evaluationDate();
-        BigInteger val = date.serialNumber() - today.serialNumber();
-
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            //std::vector<Real> splitBuffer(numLiveNames_, 0.);
-            std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
-
+        std::vector<event_type> splitEventsBuffer;
+        for(Size iSim=begin; iSim < end; iSim++) {
+            const SimEvents events = getSim(iSim);
+            splitEventsBuffer.clear();
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<BigInteger>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                // if(basket_->pool()->has(copula_->pool()->names()[iName])) {
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                        //and will sort later if buffer applies:
-                        splitEventsBuffer.push_back(events[iEvt]);
-                }
+                if(val > static_cast<BigInteger>(events[iEvt].dayFromRef))
+                    //and will sort later if buffer applies:
+                    splitEventsBuffer.push_back(events[iEvt]);
             }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
+            Real portfSimLoss = std::min(std::max(
+                simulatedLoss(events, val, today) - attachAmount, 0.),
+                    detachAmount - attachAmount);
 
             /* second pass; split is conditional to total losses within target
             losses/percentile:  */
@@ -687,7 +764,7 @@ namespace QuantLib {
                     Size iName = splitEventsBuffer[i].nameIdx;
                     Real lossName =
             // allows amortizing (others should be like this)
-            // basket_->remainingNotionals(Date(simsBuffer_[i].dayFromRef +
+            // basket_->remainingNotionals(Date(events[i].dayFromRef +
             //      today.serialNumber()))[iName] *
                         basket_->exposure(basket_->names()[iName],
                             Date(splitEventsBuffer[i].dayFromRef +
@@ -705,12 +782,60 @@ namespace QuantLib {
                     split[iName] += tranchedLossAfter - tranchedLossBefore;
                 }
                 for(Size iName=0; iName<numLiveNames; iName++) {
-                    splitStats[iName].add(split[iName] /
+                    splits.push_back(split[iName] /
                         std::min(std::max(ptflCumulLoss - attachAmount, 0.),
                             detachAmount - attachAmount) );
                 }
             }
         }
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    /* FIX ME: some trouble on limit cases, like zero loss or no losses over the
+    requested level.*/
+    Disposable<std::vector<std::vector<Real> > >
+        RandomLM<D, C, URNG>::splitVaRAndError(const Date& date, Real loss,
+            Probability confInterval) const
+    {
+        /* Check 'loss' value integrity: i.e. is within tranche limits? (should
+            have been done basket...)*/
+        calculate();
+
+        Size numLiveNames = basket_->remainingSize();
+
+        std::vector<GeneralStatistics> splitStats(numLiveNames,
+            GeneralStatistics());
+        Date today = Settings::instance().evaluationDate();
+        BigInteger val = date.serialNumber() - today.serialNumber();
+
+        /* Simulations are split among the threads; each one stores the
+        relative splits of the simulations over the requested level, which
+        are then added to the statistics in the serial order. */
+        const Size chunks = std::max<Size>(std::min(nThreads_, nSims_), 1);
+        std::vector<std::vector<Real> > chunkSplits(chunks);
+        std::vector<std::string> errors(chunks);
+
+        #pragma omp parallel for num_threads(nThreads_) schedule(static,1)
+        for (Size c=0; c<chunks; ++c) {
+            try {
+                splitSimulations((c*nSims_)/chunks, ((c+1)*nSims_)/chunks,
+                    loss, val, today, chunkSplits[c]);
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            } catch (...) {
+                errors[c] = "unknown error";
+            }
+        }
+
+        for (Size c=0; c<chunks; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+
+        for (Size c=0; c<chunks; ++c) {
+            for (Size i=0; i<chunkSplits[c].size(); i+=numLiveNames)
+                for(Size iName=0; iName<numLiveNames; iName++)
+                    splitStats[iName].add(chunkSplits[c][i+iName]);
+        }
 
         // Compute error in VaR split
         std::vector<Real> means, rangeUp, rangeDown;
@@ -821,10 +946,11 @@ namespace QuantLib {
             const std::vector<Real>& recoveries = std::vector<Real>(),
             Size nSims = 0,// stats will crash on div by zero, FIX ME.
             Real accuracy = 1.e-6,
-            BigNatural seed = 2863311530)
+            BigNatural seed = 2863311530,
+            Size nThreads = 1)
         : RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>
             (copula->numFactors(), copula->size(), copula->copula(),
-                nSims, seed ),
+                nSims, seed, nThreads),
           copula_(copula), //<- renmae to latentModel_ or defautlLM_;
           recoveries_(recoveries.size()==0 ? std::vector<Real>(copula->size(),
             0.) : recoveries),
@@ -839,10 +965,11 @@ namespace QuantLib {
                 copula,
             Size nSims = 0,// stats will crash on div by zero, FIX ME.
             Real accuracy = 1.e-6,
-            BigNatural seed = 2863311530)
+            BigNatural seed = 2863311530,
+            Size nThreads = 1)
         : RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>
             (copula->numFactors(), copula->size(), copula->copula(),
-                nSims, seed ),
+                nSims, seed, nThreads),
           copula_(copula),
           recoveries_(copula->recoveries()),
           accuracy_(accuracy)
@@ -865,7 +992,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -924,11 +1052,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         for(Size iName=0; iName<copula_->size(); iName++) {
             Real latentVarSample =
@@ -956,8 +1083,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.push_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
@@ -971,7 +1097,7 @@ namespace QuantLib {
 
 
 
-    // Common usage typedefs (notice they vary in the multithread version)
+    // Common usage typedefs
     // ---------- Gaussian default generators options ------------------------
     /* Uses copula direct normal inversion and MT generator
     typedef RandomDefaultLM<GaussianCopulaPolicy,
@@ -81,10 +81,11 @@ namespace QuantLib {
                 copula,
             Size nSims = 0,
             Real accuracy = 1.e-6, 
-            BigNatural seed = 2863311530)
+            BigNatural seed = 2863311530,
+            Size nThreads = 1)
         : RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>
             (copula->numFactors(), copula->size(), copula->copula(), 
-                nSims, seed),
+                nSims, seed, nThreads),
           copula_(copula), accuracy_(accuracy)
     {
         // redundant through basket?
@@ -100,7 +101,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
 
         // see note on randomdefaultlatentmodel
         void initDates() const {
@@ -153,10 +155,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomLossLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const 
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const 
     {
         const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         // half the model is defaults, the other half are RRs...
         for(Size iName=0; iName<copula_->size()/2; iName++) {
@@ -210,7 +212,7 @@ namespace QuantLib {
                 Real recovery = 
                     copula_->conditionalRecovery(latentRRVarSample,
                         iName, eventDate);
-                this->simsBuffer_.back().push_back(
+                events.push_back(
                   defaultSimEvent(iName, dateSTride, recovery));
                 //emplace_back
             }
@@ -219,7 +221,7 @@ namespace QuantLib {
         default probability, otherwise is more expensive and sim access has 
         to be modified. However low probability is also an indicator that 
         variance reduction is needed. */
-        //if(simsBuffer.back().empty()) {
+        //if(events.empty()) {
         //    emptySims_++;// Size; intilzd to zero
         //    simsBuffer.pop_back();
         //}
@@ -227,7 +229,7 @@ namespace QuantLib {
     }
 
 
-    // Common uses: Not valid in multithread version.
+    // Common uses:
     // ---------- Gaussian default generators options ------------------------
     /* Uses copula direct normal inversion and MT generator 
     typedef RandomLossLM<GaussianCopulaPolicy,
@@ -110,6 +110,7 @@ namespace QuantLib {
         MakeMCEverestEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEverestEngine& withMaxSamples(Size samples);
         MakeMCEverestEngine& withSeed(BigNatural seed);
+        MakeMCEverestEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -118,6 +119,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -211,7 +213,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEverestEngine<RNG,S>&
@@ -276,6 +278,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEverestEngine<RNG,S>&
+    MakeMCEverestEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEverestEngine<RNG,S>::operator
@@ -284,7 +293,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCEverestEngine<RNG,S> > engine(new
             MCEverestEngine<RNG,S>(process_,
                                    steps_,
                                    stepsPerYear_,
@@ -293,6 +302,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
@@ -100,6 +100,7 @@ namespace QuantLib {
         MakeMCHimalayaEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCHimalayaEngine& withMaxSamples(Size samples);
         MakeMCHimalayaEngine& withSeed(BigNatural seed);
+        MakeMCHimalayaEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -108,6 +109,7 @@ namespace QuantLib {
         Size samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -178,7 +180,7 @@ namespace QuantLib {
                      const boost::shared_ptr<StochasticProcessArray>& process)
     : process_(process), brownianBridge_(false), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCHimalayaEngine<RNG,S>&
@@ -229,11 +231,18 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCHimalayaEngine<RNG,S>&
+    MakeMCHimalayaEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCHimalayaEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
                                                                       const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCHimalayaEngine<RNG,S> > engine(new
             MCHimalayaEngine<RNG,S>(process_,
                                     brownianBridge_,
                                     antithetic_,
@@ -241,6 +250,8 @@ namespace QuantLib {
                                     tolerance_,
                                     maxSamples_,
                                     seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
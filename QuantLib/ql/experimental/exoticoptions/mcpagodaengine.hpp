@@ -99,6 +99,7 @@ namespace QuantLib {
         MakeMCPagodaEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCPagodaEngine& withMaxSamples(Size samples);
         MakeMCPagodaEngine& withSeed(BigNatural seed);
+        MakeMCPagodaEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -107,6 +108,7 @@ namespace QuantLib {
         Size samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -179,7 +181,7 @@ namespace QuantLib {
                      const boost::shared_ptr<StochasticProcessArray>& process)
     : process_(process), brownianBridge_(false), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCPagodaEngine<RNG,S>&
@@ -230,17 +232,26 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCPagodaEngine<RNG,S>&
+    MakeMCPagodaEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCPagodaEngine<RNG,S>::operator
     boost::shared_ptr<PricingEngine>() const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCPagodaEngine<RNG,S> > engine(new
             MCPagodaEngine<RNG,S>(process_,
                                   brownianBridge_,
                                   antithetic_,
                                   samples_, tolerance_,
                                   maxSamples_,
                                   seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
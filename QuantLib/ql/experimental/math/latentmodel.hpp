@@ -434,6 +434,8 @@ namespace QuantLib {
                 x_.value = copula_.allFactorCumulInverter(sample.value);
                 return x_;
             }
+            //! skips the next n samples
+            void skip(Size n) { sequenceGen_.skip(n); }
         private:
             USNG sequenceGen_;// copy, we might be mutithreaded
             mutable sample_type x_;
@@ -738,7 +740,8 @@ namespace QuantLib {
     */
     /*! \brief  Specialization for direct Gaussian Box-Muller generation.\par
     The implementation of Box-Muller in the library is the rejection variant so
-    do not use it within a multithreaded simulation.
+    it can't skip samples; random latent models using it run their
+    simulations serially.
     */
     template<class TC> template<class URNG, bool dummy>
     class LatentModel<TC>
@@ -759,8 +762,8 @@ namespace QuantLib {
     };
 
     /*! \brief Specialization for direct T samples generation.\par
-    The PolarT is a rejection algorithm so do not use it within a 
-    multithreaded simulation.
+    The PolarT is a rejection algorithm so it can't skip samples; random
+    latent models using it run their simulations serially.
     The RandomSequenceGenerator class does not admit heterogeneous 
     distribution samples so theres a trick here since the template parameter is 
     not what it is used internally.
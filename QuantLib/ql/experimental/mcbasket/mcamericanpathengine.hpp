@@ -75,6 +75,7 @@ namespace QuantLib {
         MakeMCAmericanPathEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCAmericanPathEngine& withMaxSamples(Size samples);
         MakeMCAmericanPathEngine& withSeed(BigNatural seed);
+        MakeMCAmericanPathEngine& withThreads(Size threads);
         MakeMCAmericanPathEngine& withCalibrationSamples(Size samples);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -84,6 +85,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -171,7 +173,7 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       calibrationSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG>
     inline MakeMCAmericanPathEngine<RNG>&
@@ -243,6 +245,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanPathEngine<RNG>&
+    MakeMCAmericanPathEngine<RNG>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG>
     inline MakeMCAmericanPathEngine<RNG>&
     MakeMCAmericanPathEngine<RNG>::withCalibrationSamples(Size samples) {
@@ -258,7 +267,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCAmericanPathEngine<RNG> > engine(new
             MCAmericanPathEngine<RNG>(process_,
                                         steps_,
                                         stepsPerYear_,
@@ -270,6 +279,8 @@ namespace QuantLib {
                                         maxSamples_,
                                         seed_,
                                         calibrationSamples_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
@@ -231,6 +231,7 @@ namespace QuantLib {
         MakeMCPathBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCPathBasketEngine& withMaxSamples(Size samples);
         MakeMCPathBasketEngine& withSeed(BigNatural seed);
+        MakeMCPathBasketEngine& withThreads(Size threads);
         MakeMCPathBasketEngine& withAntitheticVariate(bool b = true);
         MakeMCPathBasketEngine& withControlVariate(bool b = true);
         // conversion to pricing engine
@@ -242,6 +243,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     template <class RNG, class S>
@@ -251,7 +253,7 @@ namespace QuantLib {
       antithetic_(false), controlVariate_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCPathBasketEngine<RNG,S>&
@@ -302,6 +304,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCPathBasketEngine<RNG,S>&
+    MakeMCPathBasketEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCPathBasketEngine<RNG,S>&
     MakeMCPathBasketEngine<RNG,S>::withBrownianBridge(bool brownianBridge) {
@@ -327,7 +336,7 @@ namespace QuantLib {
     inline
     MakeMCPathBasketEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
                                                                        const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCPathBasketEngine<RNG,S> > engine(new
             MCPathBasketEngine<RNG,S>(process_,
                                       steps_,
                                       stepsPerYear_,
@@ -338,6 +347,8 @@ namespace QuantLib {
                                       tolerance_,
                                       maxSamples_,
                                       seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
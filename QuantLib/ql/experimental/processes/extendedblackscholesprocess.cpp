@@ -90,4 +90,14 @@ namespace QuantLib {
         }
     }
 
+    void ExtendedBlackScholesMertonProcess::evolveBatch(Time t0,
+                                                        const Array& x0,
+                                                        Time dt,
+                                                        const Array& dw,
+                                                        Array& x) const {
+        // skip the optimized base-class version; the discretization
+        // used here is the one implemented in evolve()
+        StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x);
+    }
+
 }
@@ -48,6 +48,8 @@ namespace QuantLib {
         Real drift(Time t, Real x) const;
         Real diffusion(Time t, Real x) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        void evolveBatch(Time t0, const Array& x0,
+                         Time dt, const Array& dw, Array& x) const;
       private:
         const Discretization discretization_;
     };
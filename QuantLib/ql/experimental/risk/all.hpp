@@ -2,5 +2,6 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/experimental/risk/curvebucketanalysis.hpp>
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 
@@ -0,0 +1,125 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file curvebucketanalysis.hpp
+    \brief bucket sensitivity analysis on bootstrapped curves
+*/
+
+#ifndef quantlib_curve_bucket_analysis_hpp
+#define quantlib_curve_bucket_analysis_hpp
+
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! bucket PV01 sensitivity analysis on the helpers of a bootstrapped curve
+    /*! returns the first derivatives of the aggregate NPV with
+        respect to the quotes of the alive helpers of the curve, in
+        the order returned by its bootstrapper's aliveHelpers()
+        method.
+
+        Instead of tweaking each quote and bootstrapping the curve
+        again, the nodes of the calculated curve are tweaked one by
+        one (thus repricing the instruments without bootstrapping)
+        and the resulting node sensitivities are combined with the
+        derivatives of the nodes with respect to the quotes, which are
+        obtained once from the converged bootstrap.  The shift is
+        applied to the nodes.
+
+        No bootstrap is performed after the first one: the cost is
+        one Jacobian calculation (cached by the bootstrapper) plus one
+        repricing per node, or two for centered differences, and a
+        single product with the transposed Jacobian.  The repricings
+        can't be avoided since instruments don't provide their
+        sensitivities to the curve nodes.
+
+        Empty quantities vector is considered as unit vector. The same
+        if the vector is of size one.
+
+        \pre the curve must be bootstrapped by IterativeBootstrap.
+    */
+    template <class Curve>
+    std::vector<Real>
+    curveBucketAnalysis(const boost::shared_ptr<Curve>& curve,
+                        const std::vector<boost::shared_ptr<Instrument> >&,
+                        const std::vector<Real>& quantities,
+                        Real shift = 0.0001,
+                        SensitivityAnalysis type = Centered,
+                        Real referenceNpv = Null<Real>());
+
+
+    // template definitions
+
+    template <class Curve>
+    std::vector<Real>
+    curveBucketAnalysis(
+                const boost::shared_ptr<Curve>& curve,
+                const std::vector<boost::shared_ptr<Instrument> >& instruments,
+                const std::vector<Real>& quantities,
+                Real shift,
+                SensitivityAnalysis type,
+                Real referenceNpv) {
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        QL_REQUIRE(curve, "null curve");
+
+        Matrix jacobian = curve->bootstrap().nodeJacobian();
+        Size n = jacobian.rows();
+        if (instruments.empty())
+            return std::vector<Real>(n, 0.0);
+
+        if (referenceNpv==Null<Real>())
+            referenceNpv = aggregateNPV(instruments, quantities);
+
+        const std::vector<Real> nodes = curve->data();
+        Array nodeDeltas(n);
+        Size i = 0;
+        try {
+            for (; i<n; ++i) {
+                curve->bootstrap().setNode(i+1, nodes[i+1]+shift);
+                Real npv = aggregateNPV(instruments, quantities);
+                switch (type) {
+                  case OneSide:
+                    nodeDeltas[i] = (npv-referenceNpv)/shift;
+                    break;
+                  case Centered:
+                    {
+                    curve->bootstrap().setNode(i+1, nodes[i+1]-shift);
+                    Real npv2 = aggregateNPV(instruments, quantities);
+                    nodeDeltas[i] = (npv-npv2)/(2.0*shift);
+                    }
+                    break;
+                  default:
+                      QL_FAIL("unknown SensitivityAnalysis (" <<
+                              Integer(type) << ")");
+                }
+                curve->bootstrap().setNode(i+1, nodes[i+1]);
+            }
+        } catch (...) {
+            if (i<n)
+                curve->bootstrap().setNode(i+1, nodes[i+1]);
+            throw;
+        }
+
+        // chain rule: dNPV/dq_j = sum_i dNPV/dx_i dx_i/dq_j
+        Array deltas = transpose(jacobian) * nodeDeltas;
+        return std::vector<Real>(deltas.begin(), deltas.end());
+    }
+
+}
+
+#endif
@@ -0,0 +1,6 @@
+/* This file is automatically generated; do not edit.     */
+/* Add the files to be included into Makefile.am instead. */
+
+#include <ql/experimental/snapshots/marketsnapshot.hpp>
+#include <ql/experimental/snapshots/snapshot.hpp>
+
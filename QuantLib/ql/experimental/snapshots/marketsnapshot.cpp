@@ -0,0 +1,184 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/snapshots/marketsnapshot.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/quotes/simplequote.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        const std::string fixingsPrefix = "fixings/";
+
+        std::vector<Handle<Quote> > helperQuotes(
+            const std::vector<boost::shared_ptr<CalibrationHelper> >& helpers) {
+            std::vector<Handle<Quote> > quotes(helpers.size());
+            for (Size i=0; i<helpers.size(); ++i) {
+                QL_REQUIRE(helpers[i], "null calibration helper");
+                quotes[i] = helpers[i]->volatility();
+            }
+            return quotes;
+        }
+
+    }
+
+    void saveQuotes(SnapshotWriter& writer,
+                    const std::string& name,
+                    const std::vector<Handle<Quote> >& quotes) {
+        std::vector<Real> values(quotes.size());
+        for (Size i=0; i<quotes.size(); ++i)
+            values[i] = quotes[i]->value();
+        writer.add(name, values);
+    }
+
+    bool quotesMatch(const Snapshot& snapshot,
+                     const std::string& name,
+                     const std::vector<Handle<Quote> >& quotes) {
+        if (!snapshot.has(name) || snapshot.rows(name) != quotes.size())
+            return false;
+        const Real* values = snapshot.begin(name);
+        for (Size i=0; i<quotes.size(); ++i) {
+            if (quotes[i].empty() || !quotes[i]->isValid()
+                || quotes[i]->value() != values[i])
+                return false;
+        }
+        return true;
+    }
+
+    void saveModel(
+            SnapshotWriter& writer,
+            const std::string& name,
+            const CalibratedModel& model,
+            const std::vector<boost::shared_ptr<CalibrationHelper> >& helpers) {
+        Array params = model.params();
+        writer.add(name, std::vector<Real>(params.begin(), params.end()));
+        saveQuotes(writer, name + ".quotes", helperQuotes(helpers));
+    }
+
+    bool restoreModel(
+            const Snapshot& snapshot,
+            const std::string& name,
+            CalibratedModel& model,
+            const std::vector<boost::shared_ptr<CalibrationHelper> >& helpers) {
+        if (!quotesMatch(snapshot, name + ".quotes", helperQuotes(helpers)))
+            return false;
+        Array params(snapshot.rows(name));
+        QL_REQUIRE(params.size() == model.params().size(),
+                   "stored parameters (" << params.size() << ") don't "
+                   "match model parameters (" << model.params().size() << ")");
+        std::copy(snapshot.begin(name), snapshot.end(name), params.begin());
+        model.setParams(params);
+        return true;
+    }
+
+    namespace detail {
+
+        // rows are sorted by swap tenor, then option tenor, as required
+        // by the cube; columns are swap length, option time, alpha,
+        // beta, nu, rho, ATM forward and further calibration results.
+        std::vector<Real> sabrAtmVolatilities(
+                const Matrix& sparseParameters,
+                const Handle<SwaptionVolatilityStructure>& atmVolStructure) {
+            QL_REQUIRE(!atmVolStructure.empty(),
+                       "empty ATM volatility structure");
+            QL_REQUIRE(sparseParameters.columns() >= 7,
+                       "SABR parameters have " << sparseParameters.columns()
+                       << " columns, at least 7 required");
+            std::vector<Real> vols(sparseParameters.rows());
+            for (Size i=0; i<vols.size(); ++i)
+                vols[i] = atmVolStructure->volatility(sparseParameters[i][1],
+                                                      sparseParameters[i][0],
+                                                      sparseParameters[i][6],
+                                                      true);
+            return vols;
+        }
+
+    }
+
+    std::vector<std::vector<Handle<Quote> > > sabrParametersGuess(
+                const Snapshot& snapshot,
+                const std::string& name,
+                const Handle<SwaptionVolatilityStructure>& atmVolStructure,
+                const std::vector<std::vector<Handle<Quote> > >& volSpreads) {
+        std::vector<Handle<Quote> > quotes;
+        for (Size i=0; i<volSpreads.size(); ++i)
+            quotes.insert(quotes.end(),
+                          volSpreads[i].begin(), volSpreads[i].end());
+        if (!quotesMatch(snapshot, name + ".quotes", quotes))
+            return std::vector<std::vector<Handle<Quote> > >();
+
+        Matrix parameters = snapshot.matrix(name);
+        if (!snapshot.has(name + ".atm")
+            || snapshot.values(name + ".atm")
+               != detail::sabrAtmVolatilities(parameters, atmVolStructure))
+            return std::vector<std::vector<Handle<Quote> > >();
+
+        std::vector<std::vector<Handle<Quote> > > guess(parameters.rows());
+        for (Size i=0; i<parameters.rows(); ++i) {
+            guess[i].resize(4);
+            for (Size j=0; j<4; ++j)
+                guess[i][j] = Handle<Quote>(boost::shared_ptr<Quote>(
+                                        new SimpleQuote(parameters[i][j+2])));
+        }
+        return guess;
+    }
+
+    void saveFixings(SnapshotWriter& writer) {
+        IndexManager& manager = IndexManager::instance();
+        std::vector<std::string> names = manager.histories();
+        for (Size i=0; i<names.size(); ++i) {
+            const TimeSeries<Real>& history = manager.getHistory(names[i]);
+            if (history.empty())
+                continue;
+            Matrix fixings(history.size(), 2);
+            Size j = 0;
+            for (TimeSeries<Real>::const_iterator f = history.begin();
+                 f != history.end(); ++f, ++j) {
+                fixings[j][0] = f->first.serialNumber();
+                fixings[j][1] = f->second;
+            }
+            writer.add(fixingsPrefix + names[i], fixings);
+        }
+    }
+
+    Size restoreFixings(const Snapshot& snapshot) {
+        IndexManager& manager = IndexManager::instance();
+        std::vector<std::string> names = snapshot.names();
+        Size restored = 0;
+        for (Size i=0; i<names.size(); ++i) {
+            if (names[i].compare(0, fixingsPrefix.size(), fixingsPrefix) != 0)
+                continue;
+            QL_REQUIRE(snapshot.columns(names[i]) == 2,
+                       "wrong number of columns for " << names[i]);
+            Size n = snapshot.rows(names[i]);
+            const Real* data = snapshot.begin(names[i]);
+            std::vector<Date> dates(n);
+            std::vector<Real> values(n);
+            for (Size j=0; j<n; ++j) {
+                dates[j] = Date(BigInteger(data[2*j]));
+                values[j] = data[2*j+1];
+            }
+            manager.setHistory(names[i].substr(fixingsPrefix.size()),
+                               TimeSeries<Real>(dates.begin(), dates.end(),
+                                                values.begin()));
+            ++restored;
+        }
+        return restored;
+    }
+
+}
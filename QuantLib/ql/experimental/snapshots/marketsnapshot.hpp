@@ -0,0 +1,206 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file marketsnapshot.hpp
+    \brief saving and restoring calculated market objects
+*/
+
+#ifndef quantlib_market_snapshot_hpp
+#define quantlib_market_snapshot_hpp
+
+#include <ql/experimental/snapshots/snapshot.hpp>
+#include <ql/models/model.hpp>
+#include <ql/models/calibrationhelper.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionvolstructure.hpp>
+#include <ql/handle.hpp>
+#include <ql/quote.hpp>
+
+namespace QuantLib {
+
+    /*! \defgroup snapshots Market snapshots
+
+        The functions below store the calculated state of market
+        objects (bootstrapped curves, calibrated models, SABR
+        parameters, fixing histories) in a snapshot and restore it
+        in a later session, so that the objects don't need to be
+        calculated again.  Together with the state, the values of
+        the input quotes are stored; a state is only trusted if
+        they match the current ones.
+
+        Each object is stored under a name chosen by the caller;
+        a few records are created under that name, so different
+        objects should be given different names.
+
+        @{
+    */
+
+    //! stores the current values of the quotes
+    void saveQuotes(SnapshotWriter&,
+                    const std::string& name,
+                    const std::vector<Handle<Quote> >& quotes);
+    /*! returns whether the quotes have the same values as the
+        ones stored under the given name.  Values are compared
+        exactly; invalid quotes never match.
+    */
+    bool quotesMatch(const Snapshot&,
+                     const std::string& name,
+                     const std::vector<Handle<Quote> >& quotes);
+
+    //! stores the state of a curve bootstrapped by IterativeBootstrap
+    /*! The pillar dates, the node values, the helper quotes and the
+        quote errors of the helpers at the calculated curve are
+        stored.
+    */
+    template <class Curve>
+    void saveCurve(SnapshotWriter&,
+                   const std::string& name,
+                   const Curve& curve);
+    //! restores the state of a curve bootstrapped by IterativeBootstrap
+    /*! The stored state is passed to the restore() method of the
+        bootstrapper and the curve is calculated.  The return value
+        tells whether the state was validated against the helpers
+        and accepted; if not (e.g., because the quotes changed) the
+        curve was bootstrapped again, using the stored state as
+        initial guess.
+    */
+    template <class Curve>
+    bool restoreCurve(const Snapshot&,
+                      const std::string& name,
+                      const Curve& curve);
+
+    //! stores the parameters of a calibrated model
+    /*! The values of the volatility quotes of the calibration
+        helpers are also stored.
+    */
+    void saveModel(
+            SnapshotWriter&,
+            const std::string& name,
+            const CalibratedModel& model,
+            const std::vector<boost::shared_ptr<CalibrationHelper> >& helpers
+                      = std::vector<boost::shared_ptr<CalibrationHelper> >());
+    //! restores the parameters of a calibrated model
+    /*! The parameters are set if the volatility quotes of the
+        calibration helpers match the stored ones; the return value
+        tells whether they were set.
+    */
+    bool restoreModel(
+            const Snapshot&,
+            const std::string& name,
+            CalibratedModel& model,
+            const std::vector<boost::shared_ptr<CalibrationHelper> >& helpers
+                      = std::vector<boost::shared_ptr<CalibrationHelper> >());
+
+    //! stores the SABR parameters of a calibrated swaption cube
+    /*! The sparse parameters of a SwaptionVolCube1 are stored
+        together with the values of its volatility-spread quotes,
+        which must be passed in the same layout used for building
+        the cube, and with the ATM volatilities the cube was
+        calibrated to.
+    */
+    template <class Cube>
+    void saveSabrParameters(
+                SnapshotWriter&,
+                const std::string& name,
+                const Cube& cube,
+                const std::vector<std::vector<Handle<Quote> > >& volSpreads);
+    //! returns the stored SABR parameters as guesses for a new cube
+    /*! The result can be passed as \c parametersGuess to the
+        constructor of SwaptionVolCube1; if the parameters are also
+        fixed, the cube is built without calibration.  An empty
+        vector is returned if the volatility-spread quotes don't
+        match the stored ones, or if the ATM structure doesn't
+        return the stored ATM volatilities at the nodes of the
+        parameters (the latter are evaluated at the stored ATM
+        forwards).
+    */
+    std::vector<std::vector<Handle<Quote> > > sabrParametersGuess(
+                const Snapshot&,
+                const std::string& name,
+                const Handle<SwaptionVolatilityStructure>& atmVolStructure,
+                const std::vector<std::vector<Handle<Quote> > >& volSpreads);
+
+    //! stores all non-empty fixing histories in the IndexManager
+    void saveFixings(SnapshotWriter&);
+    /*! sets the fixing histories stored in the snapshot into the
+        IndexManager and returns the number of restored histories;
+        histories not stored in the snapshot are left unchanged.
+    */
+    Size restoreFixings(const Snapshot&);
+
+    /*! @} */
+
+    namespace detail {
+
+        std::vector<Real> sabrAtmVolatilities(
+                const Matrix& sparseParameters,
+                const Handle<SwaptionVolatilityStructure>& atmVolStructure);
+
+    }
+
+
+    // template definitions
+
+    template <class Curve>
+    void saveCurve(SnapshotWriter& writer,
+                   const std::string& name,
+                   const Curve& curve) {
+        std::vector<boost::shared_ptr<typename Curve::traits_type::helper> >
+            helpers = curve.bootstrap().aliveHelpers();
+        std::vector<Real> quotes(helpers.size()), residuals(helpers.size());
+        for (Size i=0; i<helpers.size(); ++i) {
+            quotes[i] = helpers[i]->quote()->value();
+            residuals[i] = helpers[i]->quoteError();
+        }
+        writer.add(name + ".dates", curve.dates());
+        writer.add(name + ".data", curve.data());
+        writer.add(name + ".quotes", quotes);
+        writer.add(name + ".residuals", residuals);
+    }
+
+    template <class Curve>
+    bool restoreCurve(const Snapshot& snapshot,
+                      const std::string& name,
+                      const Curve& curve) {
+        curve.bootstrap().restore(snapshot.dates(name + ".dates"),
+                                  snapshot.values(name + ".data"),
+                                  snapshot.values(name + ".quotes"),
+                                  snapshot.values(name + ".residuals"));
+        curve.nodes();
+        return curve.bootstrap().lastCalculationRestored();
+    }
+
+    template <class Cube>
+    void saveSabrParameters(
+                SnapshotWriter& writer,
+                const std::string& name,
+                const Cube& cube,
+                const std::vector<std::vector<Handle<Quote> > >& volSpreads) {
+        Matrix parameters = cube.sparseSabrParameters();
+        writer.add(name, parameters);
+        writer.add(name + ".atm",
+                   detail::sabrAtmVolatilities(parameters, cube.atmVol()));
+        std::vector<Handle<Quote> > quotes;
+        for (Size i=0; i<volSpreads.size(); ++i)
+            quotes.insert(quotes.end(),
+                          volSpreads[i].begin(), volSpreads[i].end());
+        saveQuotes(writer, name + ".quotes", quotes);
+    }
+
+}
+
+
+#endif
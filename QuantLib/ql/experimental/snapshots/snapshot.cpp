@@ -0,0 +1,242 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/snapshots/snapshot.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/cstdint.hpp>
+#include <fstream>
+#include <cstring>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* File layout (all offsets are multiples of 8 bytes):
+
+           header:  magic (8 bytes), byte-order mark (4 bytes),
+                    size of Real (4 bytes), number of records (8 bytes)
+           records: name length, rows, columns (8 bytes each),
+                    name (padded to 8 bytes),
+                    rows*columns values (padded to 8 bytes)
+        */
+        const char magic[8] = { 'Q', 'L', 'S', 'N', 'A', 'P', '0', '1' };
+        const boost::uint32_t byteOrderMark = 0x01020304;
+
+        struct Header {
+            char magic[8];
+            boost::uint32_t byteOrder;
+            boost::uint32_t realSize;
+            boost::uint64_t records;
+        };
+
+        struct RecordHeader {
+            boost::uint64_t nameLength;
+            boost::uint64_t rows;
+            boost::uint64_t columns;
+        };
+
+        std::size_t padded(std::size_t n) {
+            return (n+7) & ~std::size_t(7);
+        }
+
+        void writePadding(std::ofstream& out, std::size_t n) {
+            static const char zeros[8] = { 0 };
+            out.write(zeros, padded(n)-n);
+        }
+
+    }
+
+
+    void SnapshotWriter::add(const std::string& name,
+                             const std::vector<Real>& values) {
+        Matrix m(values.size(), 1);
+        std::copy(values.begin(), values.end(), m.begin());
+        add(name, m);
+    }
+
+    void SnapshotWriter::add(const std::string& name,
+                             const std::vector<Date>& dates) {
+        Matrix m(dates.size(), 1);
+        for (Size i=0; i<dates.size(); ++i)
+            m[i][0] = dates[i].serialNumber();
+        add(name, m);
+    }
+
+    void SnapshotWriter::add(const std::string& name, const Matrix& values) {
+        QL_REQUIRE(!name.empty(), "empty record name");
+        records_[name] = values;
+    }
+
+    void SnapshotWriter::save(const std::string& filename) const {
+        std::ofstream out(filename.c_str(),
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+        QL_REQUIRE(out, "unable to open " << filename << " for writing");
+
+        Header header;
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.byteOrder = byteOrderMark;
+        header.realSize = sizeof(Real);
+        header.records = records_.size();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+        for (std::map<std::string, Matrix>::const_iterator i =
+                 records_.begin(); i != records_.end(); ++i) {
+            RecordHeader record;
+            record.nameLength = i->first.size();
+            record.rows = i->second.rows();
+            record.columns = i->second.columns();
+            out.write(reinterpret_cast<const char*>(&record),
+                      sizeof(RecordHeader));
+            out.write(i->first.data(), i->first.size());
+            writePadding(out, i->first.size());
+            std::size_t bytes = i->second.rows()*i->second.columns()
+                                                               *sizeof(Real);
+            if (bytes > 0)
+                out.write(reinterpret_cast<const char*>(i->second.begin()),
+                          bytes);
+            writePadding(out, bytes);
+        }
+
+        out.close();
+        QL_REQUIRE(out, "error while writing " << filename);
+    }
+
+
+    class Snapshot::Mapping {
+      public:
+        explicit Mapping(const std::string& filename)
+        : file_(filename.c_str(), boost::interprocess::read_only),
+          region_(file_, boost::interprocess::read_only) {}
+        const char* address() const {
+            return static_cast<const char*>(region_.get_address());
+        }
+        std::size_t size() const { return region_.get_size(); }
+      private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+    };
+
+    Snapshot::Snapshot(const std::string& filename) {
+        try {
+            mapping_ = boost::shared_ptr<Mapping>(new Mapping(filename));
+        } catch (std::exception& e) {
+            QL_FAIL("unable to map snapshot " << filename << ": " << e.what());
+        }
+
+        const char* base = mapping_->address();
+        const std::size_t size = mapping_->size();
+
+        QL_REQUIRE(size >= sizeof(Header),
+                   filename << " is not a snapshot file");
+        const Header* header = reinterpret_cast<const Header*>(base);
+        QL_REQUIRE(std::memcmp(header->magic, magic, sizeof(magic)) == 0,
+                   filename << " is not a snapshot file");
+        QL_REQUIRE(header->byteOrder == byteOrderMark
+                   && header->realSize == sizeof(Real),
+                   filename << " was written on an incompatible platform");
+
+        // the sizes read from the file are checked against the bytes
+        // left in the mapping (size-offset) before being used, so
+        // that corrupted values can't overflow the computations below
+        std::size_t offset = sizeof(Header);
+        for (boost::uint64_t i=0; i<header->records; ++i) {
+            QL_REQUIRE(sizeof(RecordHeader) <= size-offset,
+                       "corrupted snapshot " << filename);
+            const RecordHeader* r =
+                reinterpret_cast<const RecordHeader*>(base+offset);
+            offset += sizeof(RecordHeader);
+
+            QL_REQUIRE(r->nameLength <= size-offset
+                       && padded(std::size_t(r->nameLength)) <= size-offset,
+                       "corrupted snapshot " << filename);
+            std::size_t nameLength = std::size_t(r->nameLength);
+            std::string name(base+offset, nameLength);
+            offset += padded(nameLength);
+
+            const boost::uint64_t available = (size-offset)/sizeof(Real);
+            QL_REQUIRE(r->columns == 0 || r->rows <= available/r->columns,
+                       "corrupted snapshot " << filename);
+            std::size_t bytes =
+                std::size_t(r->rows*r->columns)*sizeof(Real);
+            QL_REQUIRE(padded(bytes) <= size-offset,
+                       "corrupted snapshot " << filename);
+            Record record;
+            record.data = reinterpret_cast<const Real*>(base+offset);
+            record.rows = Size(r->rows);
+            record.columns = Size(r->columns);
+            records_[name] = record;
+            offset += padded(bytes);
+        }
+    }
+
+    bool Snapshot::has(const std::string& name) const {
+        return records_.find(name) != records_.end();
+    }
+
+    std::vector<std::string> Snapshot::names() const {
+        std::vector<std::string> result;
+        result.reserve(records_.size());
+        for (std::map<std::string, Record>::const_iterator i =
+                 records_.begin(); i != records_.end(); ++i)
+            result.push_back(i->first);
+        return result;
+    }
+
+    const Snapshot::Record& Snapshot::record(const std::string& name) const {
+        std::map<std::string, Record>::const_iterator i = records_.find(name);
+        QL_REQUIRE(i != records_.end(), "no record " << name << " in snapshot");
+        return i->second;
+    }
+
+    Size Snapshot::rows(const std::string& name) const {
+        return record(name).rows;
+    }
+
+    Size Snapshot::columns(const std::string& name) const {
+        return record(name).columns;
+    }
+
+    const Real* Snapshot::begin(const std::string& name) const {
+        return record(name).data;
+    }
+
+    const Real* Snapshot::end(const std::string& name) const {
+        const Record& r = record(name);
+        return r.data + r.rows*r.columns;
+    }
+
+    std::vector<Real> Snapshot::values(const std::string& name) const {
+        return std::vector<Real>(begin(name), end(name));
+    }
+
+    std::vector<Date> Snapshot::dates(const std::string& name) const {
+        const Record& r = record(name);
+        std::vector<Date> result(r.rows*r.columns);
+        for (Size i=0; i<result.size(); ++i)
+            result[i] = Date(BigInteger(r.data[i]));
+        return result;
+    }
+
+    Disposable<Matrix> Snapshot::matrix(const std::string& name) const {
+        const Record& r = record(name);
+        Matrix result(r.rows, r.columns);
+        std::copy(r.data, r.data+r.rows*r.columns, result.begin());
+        return result;
+    }
+
+}
@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file snapshot.hpp
+    \brief binary snapshot store for calculated market objects
+*/
+
+#ifndef quantlib_snapshot_hpp
+#define quantlib_snapshot_hpp
+
+#include <ql/time/date.hpp>
+#include <ql/math/matrix.hpp>
+#include <boost/shared_ptr.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! writer of binary snapshots
+    /*! Records are identified by name and contain a matrix of real
+        numbers (vectors are stored as single-column matrices and
+        dates as their serial numbers).  They are collected in memory
+        and written to file by the save() method.
+
+        \warning The file is written in the native binary format of
+                 the machine; it is not meant to be moved across
+                 platforms.
+    */
+    class SnapshotWriter {
+      public:
+        void add(const std::string& name, const std::vector<Real>& values);
+        void add(const std::string& name, const std::vector<Date>& dates);
+        void add(const std::string& name, const Matrix& values);
+        //! writes the records collected so far to the given file
+        void save(const std::string& filename) const;
+      private:
+        std::map<std::string, Matrix> records_;
+    };
+
+
+    //! read-only view of a binary snapshot
+    /*! The file is memory-mapped, so that opening it only requires
+        reading the record headers; the data are read in place when
+        accessed.  Copies of a snapshot share the same mapping, which
+        is released when the last copy is destroyed.
+    */
+    class Snapshot {
+      public:
+        explicit Snapshot(const std::string& filename);
+        //! \name Inspectors
+        //@{
+        bool has(const std::string& name) const;
+        std::vector<std::string> names() const;
+        Size rows(const std::string& name) const;
+        Size columns(const std::string& name) const;
+        //@}
+        //! \name Data access
+        //@{
+        //! the elements of the record, row by row, without copying
+        const Real* begin(const std::string& name) const;
+        const Real* end(const std::string& name) const;
+        std::vector<Real> values(const std::string& name) const;
+        std::vector<Date> dates(const std::string& name) const;
+        Disposable<Matrix> matrix(const std::string& name) const;
+        //@}
+      private:
+        struct Record {
+            const Real* data;
+            Size rows, columns;
+        };
+        const Record& record(const std::string& name) const;
+        class Mapping;
+        boost::shared_ptr<Mapping> mapping_;
+        std::map<std::string, Record> records_;
+    };
+
+}
+
+
+#endif
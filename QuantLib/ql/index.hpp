@@ -91,45 +91,34 @@ namespace QuantLib {
                         ValueIterator vBegin,
                         bool forceOverwrite = false) {
             checkNativeFixingsAllowed();
-            std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
-            bool missingFixing, validFixing;
-            bool noInvalidFixing = true, noDuplicatedFixing = true;
-            Date invalidDate, duplicatedDate;
-            Real nullValue = Null<Real>();
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            bool noInvalidFixing = true;
+            Date invalidDate;
             Real invalidValue = Null<Real>();
-            Real duplicatedValue = Null<Real>();
             while (dBegin != dEnd) {
-                validFixing = isValidFixingDate(*dBegin);
-                Real currentValue = h[*dBegin];
-                missingFixing = forceOverwrite || currentValue == nullValue;
-                if (validFixing) {
-                    if (missingFixing)
-                        h[*(dBegin++)] = *(vBegin++);
-                    else if (close(currentValue,*(vBegin))) {
-                        ++dBegin;
-                        ++vBegin;
-                    } else {
-                        noDuplicatedFixing = false;
-                        duplicatedDate = *(dBegin++);
-                        duplicatedValue = *(vBegin++);
-                    }
+                if (isValidFixingDate(*dBegin)) {
+                    dates.push_back(*(dBegin++));
+                    values.push_back(*(vBegin++));
                 } else {
                     noInvalidFixing = false;
                     invalidDate = *(dBegin++);
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            // the valid fixings are stored in any case; the error on
+            // invalid ones takes precedence over the one on duplicates
+            try {
+                IndexManager::instance().addFixings(name(), dates, values,
+                                                    forceOverwrite);
+            } catch (Error&) {
+                if (noInvalidFixing)
+                    throw;
+            }
             QL_REQUIRE(noInvalidFixing,
                        "At least one invalid fixing provided: " <<
                        invalidDate.weekday() << " " << invalidDate <<
                        ", " << invalidValue);
-            QL_REQUIRE(noDuplicatedFixing,
-                       "At least one duplicated fixing provided: " <<
-                       duplicatedDate << ", " << duplicatedValue <<
-                       " while " << h[duplicatedDate] <<
-                       " value is already present");
         }
         //! clears all stored historical fixings
         void clearFixings();
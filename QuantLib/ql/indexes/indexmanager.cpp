@@ -18,6 +18,7 @@
 */
 
 #include <ql/indexes/indexmanager.hpp>
+#include <ql/math/comparison.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -26,29 +27,266 @@
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <cstdlib>
 
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    namespace {
+
+        Integer digits(const char* begin, const char* end) {
+            Integer n = 0;
+            for (; begin != end; ++begin) {
+                QL_REQUIRE(*begin >= '0' && *begin <= '9',
+                           "invalid date format");
+                n = 10*n + (*begin - '0');
+            }
+            return n;
+        }
+
+        // yyyy-mm-dd
+        Date parseDate(const char* begin, const char* end) {
+            QL_REQUIRE(end-begin == 10 && begin[4] == '-' && begin[7] == '-',
+                       "invalid date format");
+            return Date(digits(begin+8, begin+10),
+                        Month(digits(begin+5, begin+7)),
+                        digits(begin, begin+4));
+        }
+
+        Real parseValue(const char* begin, const char* end) {
+            // the mapped file is not null-terminated
+            char buffer[64];
+            QL_REQUIRE(end > begin && end-begin < 64, "invalid fixing");
+            std::copy(begin, end, buffer);
+            buffer[end-begin] = '\0';
+            char* last;
+            Real value = std::strtod(buffer, &last);
+            while (*last == ' ' || *last == '\t')
+                ++last;
+            QL_REQUIRE(last != buffer && *last == '\0', "invalid fixing");
+            return value;
+        }
+
+        struct Fixings {
+            std::vector<Date> dates;
+            std::vector<Real> values;
+        };
+
+    }
+
+    IndexManager::History::History()
+    : firstSerialNumber(0), notifier(new Observable),
+      timeSeriesUpToDate(true) {}
+
+    IndexManager::History&
+    IndexManager::history(const string& name) const {
+        return data_[to_upper_copy(name)];
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
         return data_.find(to_upper_copy(name)) != data_.end();
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        const History& h = history(name);
+        if (!h.timeSeriesUpToDate) {
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            for (Size i=0; i<h.fixings.size(); ++i) {
+                if (h.fixings[i] != Null<Real>()) {
+                    dates.push_back(Date(h.firstSerialNumber+BigInteger(i)));
+                    values.push_back(h.fixings[i]);
+                }
+            }
+            h.timeSeries = TimeSeries<Real>(dates.begin(), dates.end(),
+                                            values.begin());
+            h.timeSeriesUpToDate = true;
+        }
+        return h.timeSeries;
     }
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        History& h = this->history(name);
+        h.fixings.clear();
+        if (!history.empty()) {
+            h.firstSerialNumber = history.firstDate().serialNumber();
+            h.fixings.resize(history.lastDate().serialNumber()
+                             - h.firstSerialNumber + 1, Null<Real>());
+            for (TimeSeries<Real>::const_iterator i = history.begin();
+                 i != history.end(); ++i)
+                h.fixings[i->first.serialNumber() - h.firstSerialNumber] =
+                    i->second;
+        }
+        h.timeSeries = history;
+        h.timeSeriesUpToDate = true;
+        h.notifier->notifyObservers();
+    }
+
+    Real IndexManager::fixing(const string& name,
+                              const Date& fixingDate) const {
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        if (i == data_.end())
+            return Null<Real>();
+        const History& h = i->second;
+        BigInteger k = fixingDate.serialNumber() - h.firstSerialNumber;
+        if (k < 0 || k >= BigInteger(h.fixings.size()))
+            return Null<Real>();
+        return h.fixings[k];
+    }
+
+    bool IndexManager::store(History& h,
+                             const std::vector<Date>& dates,
+                             const std::vector<Real>& values,
+                             bool forceOverwrite,
+                             Date& duplicatedDate,
+                             Real& duplicatedValue,
+                             Real& storedValue) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "different number of fixings (" << values.size()
+                   << ") and dates (" << dates.size() << ")");
+        if (dates.empty())
+            return true;
+
+        // extend the stored range to cover the new dates
+        BigInteger first = (*std::min_element(dates.begin(), dates.end()))
+                                                             .serialNumber();
+        BigInteger last = (*std::max_element(dates.begin(), dates.end()))
+                                                             .serialNumber();
+        if (h.fixings.empty()) {
+            h.firstSerialNumber = first;
+            h.fixings.resize(last - first + 1, Null<Real>());
+        } else {
+            if (first < h.firstSerialNumber) {
+                h.fixings.insert(h.fixings.begin(),
+                                 Size(h.firstSerialNumber - first), Null<Real>());
+                h.firstSerialNumber = first;
+            }
+            if (last - h.firstSerialNumber >= BigInteger(h.fixings.size()))
+                h.fixings.resize(last - h.firstSerialNumber + 1,
+                                 Null<Real>());
+        }
+
+        bool noDuplicatedFixing = true;
+        for (Size i=0; i<dates.size(); ++i) {
+            Real& current =
+                h.fixings[dates[i].serialNumber() - h.firstSerialNumber];
+            if (forceOverwrite || current == Null<Real>()) {
+                current = values[i];
+            } else if (!close(current, values[i]) && noDuplicatedFixing) {
+                noDuplicatedFixing = false;
+                duplicatedDate = dates[i];
+                duplicatedValue = values[i];
+                storedValue = current;
+            }
+        }
+        h.timeSeriesUpToDate = false;
+        return noDuplicatedFixing;
+    }
+
+    void IndexManager::addFixings(const string& name,
+                                  const std::vector<Date>& dates,
+                                  const std::vector<Real>& values,
+                                  bool forceOverwrite) {
+        History& h = history(name);
+        Date duplicatedDate;
+        Real duplicatedValue, storedValue;
+        bool noDuplicatedFixing = store(h, dates, values, forceOverwrite,
+                                        duplicatedDate, duplicatedValue,
+                                        storedValue);
+        h.notifier->notifyObservers();
+        QL_REQUIRE(noDuplicatedFixing,
+                   "At least one duplicated fixing provided: " <<
+                   duplicatedDate << ", " << duplicatedValue <<
+                   " while " << storedValue <<
+                   " value is already present");
+    }
+
+    Size IndexManager::loadFixings(const string& filename,
+                                   bool forceOverwrite) {
+        boost::interprocess::file_mapping file;
+        boost::interprocess::mapped_region region;
+        try {
+            boost::interprocess::file_mapping(
+                filename.c_str(), boost::interprocess::read_only).swap(file);
+            boost::interprocess::mapped_region(
+                file, boost::interprocess::read_only).swap(region);
+        } catch (std::exception& e) {
+            QL_FAIL("unable to map " << filename << ": " << e.what());
+        }
+        const char* p = static_cast<const char*>(region.get_address());
+        const char* end = p + region.get_size();
+
+        // the fixings are collected by index; files are usually
+        // sorted by index, so the last one is looked up only when
+        // the name changes
+        std::map<string, Fixings> loaded;
+        string lastName;
+        Fixings* current = 0;
+        Size n = 0, line = 0;
+        while (p < end) {
+            const char* eol = std::find(p, end, '\n');
+            const char* e = (eol > p && eol[-1] == '\r') ? eol-1 : eol;
+            ++line;
+            if (e != p && *p != '#') {
+                try {
+                    const char* c1 = std::find(p, e, ',');
+                    const char* c2 = (c1 == e) ? e : std::find(c1+1, e, ',');
+                    QL_REQUIRE(c2 != e, "three comma-separated fields "
+                               "expected");
+                    if (current == 0 || lastName.compare(0, string::npos,
+                                                         p, c1-p) != 0) {
+                        lastName.assign(p, c1);
+                        QL_REQUIRE(!lastName.empty(), "missing index name");
+                        current = &loaded[to_upper_copy(lastName)];
+                    }
+                    current->dates.push_back(parseDate(c1+1, c2));
+                    current->values.push_back(parseValue(c2+1, e));
+                    ++n;
+                } catch (std::exception& ex) {
+                    QL_FAIL(filename << ", line " << line << ": "
+                            << ex.what());
+                }
+            }
+            p = (eol == end) ? end : eol+1;
+        }
+
+        // all the fixings are stored before reporting duplicates
+        string duplicatedName;
+        Date duplicatedDate;
+        Real duplicatedValue, storedValue;
+        for (std::map<string, Fixings>::const_iterator i = loaded.begin();
+             i != loaded.end(); ++i) {
+            History& h = data_[i->first];
+            Date d;
+            Real v, s;
+            if (!store(h, i->second.dates, i->second.values, forceOverwrite,
+                       d, v, s) && duplicatedName.empty()) {
+                duplicatedName = i->first;
+                duplicatedDate = d;
+                duplicatedValue = v;
+                storedValue = s;
+            }
+            h.notifier->notifyObservers();
+        }
+        QL_REQUIRE(duplicatedName.empty(),
+                   "At least one duplicated fixing provided for " <<
+                   duplicatedName << ": " <<
+                   duplicatedDate << ", " << duplicatedValue <<
+                   " while " << storedValue <<
+                   " value is already present");
+        return n;
     }
 
     boost::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return history(name).notifier;
     }
 
     std::vector<string> IndexManager::histories() const {
@@ -32,7 +32,13 @@
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! The fixings of each index are stored in a vector indexed by
+        the serial number of their dates, so that looking up a fixing
+        doesn't require a search; the TimeSeries returned by
+        getHistory is built from it when requested.
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
@@ -44,6 +50,31 @@ namespace QuantLib {
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
+        //! returns the stored fixing, or Null<Real>() if there's none
+        Real fixing(const std::string& name, const Date& fixingDate) const;
+        //! stores historical fixings of the index
+        /*! Fixings already stored are replaced if forceOverwrite
+            is true, or if they're null.  Otherwise they're kept,
+            and an exception is raised after storing the others if
+            any of them differs from the corresponding new value.
+            Observers are notified once.
+        */
+        void addFixings(const std::string& name,
+                        const std::vector<Date>& dates,
+                        const std::vector<Real>& values,
+                        bool forceOverwrite = false);
+        //! stores the historical fixings read from a file
+        /*! Each line of the file contains the index name, the date
+            in ISO format and the fixing, separated by commas, e.g.,
+            <tt>Euribor6M Actual/360,2015-06-30,0.0005</tt>; empty
+            lines and lines starting with <tt>#</tt> are skipped.
+            The file is memory-mapped and read in a single pass; the
+            fixings are stored as by addFixings, with a single
+            notification for each index.  The number of fixings read
+            is returned.
+        */
+        Size loadFixings(const std::string& filename,
+                         bool forceOverwrite = false);
         //! observer notifying of changes in the index fixings
         boost::shared_ptr<Observable> notifier(const std::string& name) const;
         //! returns all names of the indexes for which fixings were stored
@@ -53,8 +84,27 @@ namespace QuantLib {
         //! clears all stored fixings
         void clearHistories();
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
-                                                                  history_map;
+        struct History {
+            History();
+            // fixings from the date with the given serial number
+            // on, with Null<Real>() for missing ones
+            BigInteger firstSerialNumber;
+            std::vector<Real> fixings;
+            boost::shared_ptr<Observable> notifier;
+            mutable TimeSeries<Real> timeSeries;
+            mutable bool timeSeriesUpToDate;
+        };
+        typedef std::map<std::string, History> history_map;
+        History& history(const std::string& name) const;
+        // returns whether there were no conflicting fixings; if
+        // there were, the first one is returned in the arguments
+        static bool store(History& h,
+                          const std::vector<Date>& dates,
+                          const std::vector<Real>& values,
+                          bool forceOverwrite,
+                          Date& duplicatedDate,
+                          Real& duplicatedValue,
+                          Real& storedValue);
         mutable history_map data_;
     };
 
@@ -142,7 +142,7 @@ namespace QuantLib {
             // we're not sure, but the fixing might be there so we
             // check.  Todo: check which fixings are not possible, to
             // avoid using fixings in the future
-            Real f = timeSeries()[latestNeededDate];
+            Real f = IndexManager::instance().fixing(name(), latestNeededDate);
             return (f == Null<Real>());
         }
     }
@@ -127,7 +127,7 @@ namespace QuantLib {
     inline Rate InterestRateIndex::pastFixing(const Date& fixingDate) const {
         QL_REQUIRE(isValidFixingDate(fixingDate),
                    fixingDate << " is not a valid fixing date");
-        return timeSeries()[fixingDate];
+        return IndexManager::instance().fixing(name(), fixingDate);
     }
 
 }
@@ -165,7 +165,13 @@ namespace QuantLib {
         engine_->reset();
         setupArguments(engine_->getArguments());
         engine_->getArguments()->validate();
-        engine_->calculate();
+        {
+            #if defined(QL_ENABLE_PROFILING)
+            detail::ProfiledScope profiled(Profiler::EngineCalculation,
+                                           typeid(*engine_));
+            #endif
+            engine_->calculate();
+        }
         fetchResults(engine_->getResults());
     }
 
@@ -22,6 +22,7 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -36,6 +37,29 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // the array versions of the inverse cumulatives work on
+        // blocks of this size, copied on the stack; the loops on a
+        // whole block have a fixed length and no aliasing, so that
+        // the compiler can vectorize them.
+        const Size blockSize = 64;
+
+    }
+
+    /* Where GCC supports function multiversioning, the array
+       versions are also compiled for AVX2 and the one fitting the
+       processor is chosen at run time.  AVX-512 is not targeted
+       since GCC enables FMA along with it, which would change the
+       results in the last bit with respect to the scalar versions. */
+    #if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 6) \
+        && defined(__x86_64__) && defined(__linux__)
+    #define QL_ARRAY_VERSION_TARGETS \
+        __attribute__((target_clones("avx2","default")))
+    #else
+    #define QL_ARRAY_VERSION_TARGETS
+    #endif
+
     Real CumulativeNormalDistribution::operator()(Real z) const {
         //QL_REQUIRE(!(z >= average_ && 2.0*average_-z > average_),
         //           "not a real number. ");
@@ -63,6 +87,15 @@ namespace QuantLib {
         return result;
     }
 
+    void CumulativeNormalDistribution::operator()(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) const {
+        // the error function is piecewise, so each argument is
+        // evaluated separately
+        for (; begin != end; ++begin, ++out)
+            *out = (*this)(*begin);
+    }
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
@@ -126,6 +159,49 @@ namespace QuantLib {
         return z;
     }
 
+    QL_ARRAY_VERSION_TARGETS
+    void InverseCumulativeNormal::standard_values(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) {
+        Real x[blockSize], z[blockSize];
+        while (begin != end) {
+            const Size n = std::min<Size>(end-begin, blockSize);
+            std::copy(begin, begin+n, x);
+            std::fill(x+n, x+blockSize, 0.5);
+
+            // the central region is evaluated for the whole block...
+            for (Size i=0; i<blockSize; ++i) {
+                const Real t = x[i] - 0.5;
+                const Real r = t*t;
+                z[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*t /
+                    (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+            }
+
+            // ...and the values in the tails are replaced afterwards
+            for (Size i=0; i<n; ++i) {
+                if (x[i] < x_low_ || x_high_ < x[i])
+                    z[i] = tail_value(x[i]);
+                #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+                const Real r =
+                    (f_(z[i]) - x[i]) * M_SQRT2 * M_SQRTPI * exp(0.5*z[i]*z[i]);
+                z[i] -= r/(1+0.5*z[i]*r);
+                #endif
+                out[i] = z[i];
+            }
+
+            begin += n;
+            out += n;
+        }
+    }
+
+    void InverseCumulativeNormal::operator()(const Real* begin,
+                                             const Real* end,
+                                             Real* out) const {
+        standard_values(begin, end, out);
+        for (Real* last = out + (end-begin); out != last; ++out)
+            *out = average_ + sigma_*(*out);
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -177,6 +253,44 @@ namespace QuantLib {
         return average_ + result*sigma_;
     }
 
+    QL_ARRAY_VERSION_TARGETS
+    void MoroInverseCumulativeNormal::operator()(const Real* begin,
+                                                 const Real* end,
+                                                 Real* out) const {
+        Real x[blockSize], z[blockSize];
+        while (begin != end) {
+            const Size n = std::min<Size>(end-begin, blockSize);
+            std::copy(begin, begin+n, x);
+            std::fill(x+n, x+blockSize, 0.5);
+
+            // Beasley and Springer for the whole block...
+            for (Size i=0; i<blockSize; ++i) {
+                const Real temp = x[i] - 0.5;
+                const Real r = temp*temp;
+                z[i] = temp*
+                    (((a3_*r+a2_)*r+a1_)*r+a0_) /
+                    ((((b3_*r+b2_)*r+b1_)*r+b0_)*r+1.0);
+            }
+
+            // ...and Moro's approximation where needed
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(x[i] > 0.0 && x[i] < 1.0,
+                           "MoroInverseCumulativeNormal(" << x[i]
+                           << ") undefined: must be 0<x<1");
+                if (std::fabs(x[i]-0.5) >= 0.42) {
+                    Real r = std::log(-std::log(x[i]<0.5 ? x[i] : 1.0-x[i]));
+                    r = c0_+r*(c1_+r*(c2_+r*(c3_+r*(c4_+r*(c5_+r*
+                                              (c6_+r*(c7_+r*c8_)))))));
+                    z[i] = x[i]<0.5 ? -r : r;
+                }
+                out[i] = average_ + z[i]*sigma_;
+            }
+
+            begin += n;
+            out += n;
+        }
+    }
+
     MaddockInverseCumulativeNormal::MaddockInverseCumulativeNormal(
         Real average, Real sigma)
     : average_(average), sigma_(sigma) {}
@@ -73,6 +73,11 @@ namespace QuantLib {
         // function
         Real operator()(Real x) const;
         Real derivative(Real x) const;
+        /*! writes to out the values of the function for the
+            arguments in [begin,end); out can be equal to begin.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
       private:
         Real average_, sigma_;
         NormalDistribution gaussian_;
@@ -136,6 +141,18 @@ namespace QuantLib {
 
             return z;
         }
+        /*! writes to out the values of the function for the
+            arguments in [begin,end); out can be equal to begin.
+            The results are the same returned by operator(); the
+            central region is evaluated for blocks of arguments in
+            loops without branches, which the compiler can
+            vectorize, and the tails are then corrected.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
+        //! array version of standard_value
+        static void standard_values(const Real* begin, const Real* end,
+                                    Real* out);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -204,6 +221,13 @@ namespace QuantLib {
                                     Real sigma   = 1.0);
         // function
         Real operator()(Real x) const;
+        /*! writes to out the values of the function for the
+            arguments in [begin,end); out can be equal to begin.
+            As for InverseCumulativeNormal, the central region is
+            evaluated in loops the compiler can vectorize.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
       private:
         Real average_, sigma_;
         static const Real a0_;
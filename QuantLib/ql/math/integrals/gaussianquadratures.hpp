@@ -59,8 +59,8 @@ namespace QuantLib {
         }
 
         Size order() const { return x_.size(); }
-        const Array& weights() { return w_; }
-        const Array& x()       { return x_; }
+        const Array& weights() const { return w_; }
+        const Array& x() const       { return x_; }
         
       protected:
         Array x_, w_;
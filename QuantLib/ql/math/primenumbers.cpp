@@ -45,14 +45,20 @@ namespace QuantLib {
     std::vector<BigNatural> PrimeNumbers::primeNumbers_;
 
     BigNatural PrimeNumbers::get(Size absoluteIndex) {
-        if (primeNumbers_.empty()) {
-            Size n = sizeof(firstPrimes)/sizeof(firstPrimes[0]);
-            primeNumbers_.insert(primeNumbers_.end(),
-                                 firstPrimes, firstPrimes+n);
+        BigNatural p;
+        // the table is shared by all the threads building sequences
+        #pragma omp critical(ql_prime_numbers)
+        {
+            if (primeNumbers_.empty()) {
+                Size n = sizeof(firstPrimes)/sizeof(firstPrimes[0]);
+                primeNumbers_.insert(primeNumbers_.end(),
+                                     firstPrimes, firstPrimes+n);
+            }
+            while (primeNumbers_.size()<=absoluteIndex)
+                nextPrimeNumber();
+            p = primeNumbers_[absoluteIndex];
         }
-        while (primeNumbers_.size()<=absoluteIndex)
-            nextPrimeNumber();
-        return primeNumbers_[absoluteIndex];
+        return p;
     }
 
     BigNatural PrimeNumbers::nextPrimeNumber() {
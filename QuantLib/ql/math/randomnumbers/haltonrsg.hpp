@@ -51,6 +51,8 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skips the next n samples in the low-discrepancy sequence
+        void skip(Size n) { sequenceCounter_ += n; }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
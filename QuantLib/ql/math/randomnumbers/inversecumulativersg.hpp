@@ -26,10 +26,40 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // a generic inverse cumulative is applied to each value...
+        template <class IC>
+        inline void applyInverseCumulative(const IC& ic,
+                                           const Real* begin,
+                                           const Real* end,
+                                           Real* out) {
+            for (; begin != end; ++begin, ++out)
+                *out = ic(*begin);
+        }
+
+        // ...while the normal ones have array versions
+        inline void applyInverseCumulative(
+                                      const InverseCumulativeNormal& ic,
+                                      const Real* begin, const Real* end,
+                                      Real* out) {
+            ic(begin, end, out);
+        }
+
+        inline void applyInverseCumulative(
+                                  const MoroInverseCumulativeNormal& ic,
+                                  const Real* begin, const Real* end,
+                                  Real* out) {
+            ic(begin, end, out);
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -43,6 +73,11 @@ namespace QuantLib {
             USG::sample_type USG::nextSequence() const;
             Size USG::dimension() const;
         \endcode
+        If a client of this class wants to use the skip method,
+        class USG must also implement
+        \code
+            void USG::skip(Size n);
+        \endcode
 
         The inverse cumulative distribution is supplied by IC.
 
@@ -51,6 +86,9 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+        The whole sequence is transformed in a single call when IC
+        is InverseCumulativeNormal or MoroInverseCumulativeNormal,
+        which provide array versions of operator().
     */
     template <class USG, class IC>
     class InverseCumulativeRsg {
@@ -62,6 +100,8 @@ namespace QuantLib {
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
+        //! skips the next n samples
+        void skip(Size n) { uniformSequenceGenerator_.skip(n); }
         Size dimension() const { return dimension_; }
       private:
         USG uniformSequenceGenerator_;
@@ -87,11 +127,13 @@ namespace QuantLib {
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
+        const typename USG::sample_type& sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
+        if (dimension_ > 0) {
+            const Real* u = &sample.value[0];
+            detail::applyInverseCumulative(ICD_, u, u + dimension_,
+                                           &x_.value[0]);
         }
         return x_;
     }
@@ -83,6 +83,11 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skips the next n sequences
+        void skip(Size n) {
+            for (Size i=0; i<n*dimensionality_; i++)
+                rng_.next();
+        }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
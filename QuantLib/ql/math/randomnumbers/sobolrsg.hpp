@@ -128,6 +128,8 @@ namespace QuantLib {
             return sequence_;
         }
         const sample_type& lastSequence() const { return sequence_; }
+        //! skips the next n samples in the low-discrepancy sequence
+        void skip(Size n) { skipTo(sequenceCounter_+n); }
         Size dimension() const { return dimensionality_; }
       private:
         static const int bits_;
@@ -26,6 +26,7 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 
 namespace QuantLib {
 
@@ -123,6 +124,16 @@ namespace QuantLib {
     */
     typedef GenericRiskStatistics<GaussianStatistics> RiskStatistics;
 
+    //! risk measures tool with bounded memory
+    /*! The measures based on the empirical distribution are
+        approximated as described for TDigestStatistics.
+
+        \test the returned values are checked against those
+              returned by RiskStatistics.
+    */
+    typedef GenericRiskStatistics<GenericGaussianStatistics<TDigestStatistics> >
+                                                        TDigestRiskStatistics;
+
 
 
     // inline definitions
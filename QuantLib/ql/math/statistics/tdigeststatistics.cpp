@@ -0,0 +1,278 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class C>
+        bool meanLess(const C& c1, const C& c2) {
+            return c1.mean < c2.mean;
+        }
+
+    }
+
+    TDigestStatistics::TDigestStatistics(Real compression)
+    : compression_(compression),
+      bufferSize_(static_cast<Size>(5.0*compression)) {
+        QL_REQUIRE(compression >= 10.0,
+                   "compression (" << compression << ") must be at least 10");
+        reset();
+    }
+
+    Real TDigestStatistics::mean() const {
+        QL_REQUIRE(samples() != 0, "empty sample set");
+        QL_REQUIRE(weightSum_ > 0.0, "null sum of weights");
+        return mean_;
+    }
+
+    Real TDigestStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        return (m2_/weightSum_)*N/(N-1.0);
+    }
+
+    Real TDigestStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real TDigestStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    Real TDigestStatistics::percentile(Real percent) const {
+        return quantile(percent, false);
+    }
+
+    Real TDigestStatistics::topPercentile(Real percent) const {
+        return quantile(percent, true);
+    }
+
+    Real TDigestStatistics::quantile(Real percent, bool fromTop) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+
+        QL_REQUIRE(weightSum_ > 0.0,
+                   "empty sample set");
+
+        compress();
+
+        // the centroids are visited in increasing or decreasing order
+        const Size n = centroids_.size();
+        const Centroid* first =
+            fromTop ? &centroids_.back() : &centroids_.front();
+        const std::ptrdiff_t step = fromTop ? -1 : 1;
+
+        // find the centroid containing the percentile, as
+        // GeneralStatistics does with single samples...
+        Real integral = 0.0, target = percent*weightSum_;
+        Size k = 0;
+        for (;;) {
+            integral += first[step*std::ptrdiff_t(k)].weight;
+            if (integral >= target || k == n-1)
+                break;
+            ++k;
+        }
+        const Centroid& c = first[step*std::ptrdiff_t(k)];
+        if (c.count == 1)
+            return c.mean;
+
+        // ...and interpolate between the mean of its samples, placed
+        // at the middle of its weight, and those of its neighbours.
+        // A neighbour made of a single sample is placed at the edge,
+        // since all its weight is at its value.
+        Real center = integral - 0.5*c.weight;
+        if (target < center) {
+            Real x, q;
+            if (k == 0) {
+                x = fromTop ? max_ : min_;
+                q = 0.0;
+            } else {
+                const Centroid& p = first[step*std::ptrdiff_t(k-1)];
+                x = p.mean;
+                q = integral - c.weight;
+                if (p.count > 1)
+                    q -= 0.5*p.weight;
+            }
+            return x + (c.mean-x)*(target-q)/(center-q);
+        } else {
+            Real x, q;
+            if (k == n-1) {
+                x = fromTop ? min_ : max_;
+                q = integral;
+            } else {
+                const Centroid& p = first[step*std::ptrdiff_t(k+1)];
+                x = p.mean;
+                q = integral;
+                if (p.count > 1)
+                    q += 0.5*p.weight;
+            }
+            return c.mean + (x-c.mean)*(target-center)/(q-center);
+        }
+    }
+
+    void TDigestStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+        ++samples_;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        // null weights don't contribute to the distribution
+        if (weight == 0.0)
+            return;
+
+        addMoments(weight, value, 0.0, 0.0, 0.0);
+        Centroid c = { value, weight, 1 };
+        buffer_.push_back(c);
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void TDigestStatistics::merge(const TDigestStatistics& other) {
+        if (&other == this) {
+            TDigestStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        if (other.samples_ == 0)
+            return;
+
+        samples_ += other.samples_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        addMoments(other.weightSum_, other.mean_,
+                   other.m2_, other.m3_, other.m4_);
+
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void TDigestStatistics::reset() {
+        centroids_ = std::vector<Centroid>();
+        buffer_ = std::vector<Centroid>();
+        buffer_.reserve(bufferSize_);
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+    }
+
+    void TDigestStatistics::addMoments(Real weight, Real mean,
+                                       Real m2, Real m3, Real m4) {
+        // pairwise update of the central moments, see P. Pebay,
+        // Formulas for robust, one-pass parallel computation of
+        // covariances and arbitrary-order statistical moments,
+        // Sandia Report SAND2008-6212 (2008)
+        if (weight == 0.0)
+            return;
+        if (weightSum_ == 0.0) {
+            weightSum_ = weight;
+            mean_ = mean;
+            m2_ = m2;
+            m3_ = m3;
+            m4_ = m4;
+            return;
+        }
+
+        const Real wa = weightSum_, wb = weight, w = wa + wb;
+        const Real delta = mean - mean_;
+        const Real d = delta/w;
+        const Real wab = wa*wb;
+
+        m4_ += m4 + delta*d*d*d*wab*(wa*wa - wab + wb*wb)
+            + 6.0*d*d*(wa*wa*m2 + wb*wb*m2_)
+            + 4.0*d*(wa*m3 - wb*m3_);
+        m3_ += m3 + delta*d*d*wab*(wa - wb)
+            + 3.0*d*(wa*m2 - wb*m2_);
+        m2_ += m2 + delta*d*wab;
+        mean_ += wb*d;
+        weightSum_ = w;
+    }
+
+    void TDigestStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(), meanLess<Centroid>);
+
+        Real total = 0.0;
+        for (Size i=0; i<buffer_.size(); ++i)
+            total += buffer_[i].weight;
+
+        // The scale function k(q) = delta/(2 pi) asin(2q-1) limits
+        // each centroid to a unit increase of k; centroids are thus
+        // small near the tails, where q is close to 0 or 1.
+        const Real scale = compression_/(2.0*M_PI);
+        centroids_.clear();
+        Centroid current = buffer_.front();
+        Real q0 = 0.0, qLimit = 0.0;
+        bool limitSet = false;
+        for (Size i=1; i<buffer_.size(); ++i) {
+            if (!limitSet) {
+                const Real k =
+                    scale*std::asin(std::min(2.0*q0-1.0, 1.0)) + 1.0;
+                qLimit = k/scale >= M_PI_2 ?
+                    1.0 : 0.5*(std::sin(k/scale)+1.0);
+                limitSet = true;
+            }
+            const Centroid& next = buffer_[i];
+            const Real q = q0 + (current.weight + next.weight)/total;
+            if (q <= qLimit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean)
+                              * next.weight/current.weight;
+                current.count += next.count;
+            } else {
+                q0 += current.weight/total;
+                centroids_.push_back(current);
+                current = next;
+                limitSet = false;
+            }
+        }
+        centroids_.push_back(current);
+
+        buffer_.clear();
+    }
+
+}
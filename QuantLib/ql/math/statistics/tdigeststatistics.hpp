@@ -0,0 +1,255 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigeststatistics.hpp
+    \brief statistics tool with bounded memory based on a t-digest
+*/
+
+#ifndef quantlib_tdigest_statistics_hpp
+#define quantlib_tdigest_statistics_hpp
+
+#include <ql/utilities/null.hpp>
+#include <ql/errors.hpp>
+#include <vector>
+#include <utility>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory
+    /*! This class can be used in place of GeneralStatistics when the
+        number of samples is too large to store them all.  Mean,
+        variance, skewness, kurtosis, minimum and maximum are
+        accumulated exactly.  The empirical distribution is
+        summarized by a t-digest, i.e., a sorted set of centroids
+        whose size is small in the tails and larger in the body of
+        the distribution; percentiles and expectation values over a
+        range are approximated from the centroids.  The number of
+        centroids, and thus the memory used, is bounded by a small
+        multiple of the compression parameter regardless of the
+        number of samples.
+
+        Two instances can be merged, e.g., after accumulating
+        samples separately on different threads.
+
+        References:
+
+        T. Dunning and O. Ertl, Computing Extremely Accurate Quantiles
+        Using t-Digests, 2019 (<https://arxiv.org/abs/1902.04023>)
+
+        \test the returned values are checked against the ones
+              returned by GeneralStatistics for the same samples.
+    */
+    class TDigestStatistics {
+      public:
+        typedef Real value_type;
+        /*! Larger compressions lead to more centroids and more
+            accurate percentiles. */
+        explicit TDigestStatistics(Real compression = 1000.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+
+        //! sum of data weights
+        Real weightSum() const;
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Approximate expectation value of a function \f$ f \f$ on
+            a given range, with the same interface as
+            GeneralStatistics::expectationValue.  The sum runs over
+            the centroids, each one taken as a single point at its
+            mean; the returned number of observations is the number
+            of samples in the centroids within the range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            std::vector<Centroid>::const_iterator i;
+            for (i=centroids_.begin(); i!=centroids_.end(); ++i) {
+                Real x = i->mean, w = i->weight;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += i->count;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! approximate \f$ y \f$-th percentile, defined as in
+            GeneralStatistics.  The result is exact as long as
+            the percentile falls on a centroid made of a single
+            sample, which is always the case for fewer samples than
+            the compression; otherwise, it is interpolated between
+            the means of adjacent centroids.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! approximate \f$ y \f$-th top percentile, defined as in
+            GeneralStatistics.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! compression parameter
+        Real compression() const;
+
+        //! number of centroids currently summarizing the data
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+
+        //! adds the data collected by another instance
+        /*! The compression of this instance is kept. */
+        void merge(const TDigestStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size count;
+        };
+        // merges the buffered samples into the centroids
+        void compress() const;
+        // percentile counted from the bottom or from the top
+        Real quantile(Real percent, bool fromTop) const;
+        // updates the moments with those of a set of samples
+        void addMoments(Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+
+        Real compression_;
+        Size bufferSize_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+    };
+
+
+    // inline definitions
+
+    inline Size TDigestStatistics::samples() const {
+        return samples_;
+    }
+
+    inline Real TDigestStatistics::weightSum() const {
+        return weightSum_;
+    }
+
+    inline Real TDigestStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real TDigestStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real TDigestStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real TDigestStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    inline Real TDigestStatistics::compression() const {
+        return compression_;
+    }
+
+    inline Size TDigestStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+}
+
+
+#endif
@@ -45,6 +45,10 @@ namespace QuantLib {
       dxMap_ (FirstDerivativeOp(direction, mesher)),
       dxxMap_(SecondDerivativeOp(direction, mesher)),
       mapT_  (direction, mesher),
+      dxxMapT_(direction, mesher),
+      variance_(mesher->layout()->size()),
+      drift_ (mesher->layout()->size()),
+      discount_(1),
       strike_(strike),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
       direction_(direction) {
@@ -58,7 +62,7 @@ namespace QuantLib {
             const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
             const FdmLinearOpIterator endIter = layout->end();
 
-            Array v(layout->size());
+            Array& v = variance_;
             for (FdmLinearOpIterator iter = layout->begin();
                  iter!=endIter; ++iter) {
                 const Size i = iter.index();
@@ -77,16 +81,22 @@ namespace QuantLib {
 
                 }
             }
-            mapT_.axpyb(r - q - 0.5*v, dxMap_,
-                        dxxMap_.mult(0.5*v), Array(1, -r));
         }
         else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
-            mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
-                        dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
-                        Array(1, -r));
+            std::fill(variance_.begin(), variance_.end(), v);
         }
+
+        // the members are used as workspace to avoid allocations,
+        // since this method is called at each time step
+        for (Size i=0; i < variance_.size(); ++i) {
+            drift_[i] = r - q - 0.5*variance_[i];
+            variance_[i] *= 0.5;
+        }
+        discount_[0] = -r;
+        dxxMap_.mult(variance_, dxxMapT_);
+        mapT_.axpyb(drift_, dxMap_, dxxMapT_, discount_);
     }
 
     Size FdmBlackScholesOp::size() const {
@@ -127,6 +137,41 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply(const Array& r, Array& out) const {
+        mapT_.apply(r, out);
+    }
+
+    void FdmBlackScholesOp::apply_direction(Size direction,
+                                            const Array& r,
+                                            Array& out) const {
+        if (direction == direction_)
+            mapT_.apply(r, out);
+        else
+            std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_mixed(const Array&, Array& out) const {
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction,
+                                            const Array& r, Real dt,
+                                            Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, dt, 1.0, out);
+        else
+            std::copy(r.begin(), r.end(), out.begin());
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction,
+                                            const Array& r, Real dt,
+                                            Array& out, Array& work) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, dt, 1.0, out, work);
+        else
+            std::copy(r.begin(), r.end(), out.begin());
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmBlackScholesOp::toMatrixDecomp() const {
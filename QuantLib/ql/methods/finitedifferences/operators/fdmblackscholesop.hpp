@@ -55,6 +55,15 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction,
+                             const Array& r, Real s, Array& out) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& out, Array& work) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -67,6 +76,8 @@ namespace QuantLib {
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
+        TripleBandLinearOp dxxMapT_;
+        Array variance_, drift_, discount_;
         const Real strike_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
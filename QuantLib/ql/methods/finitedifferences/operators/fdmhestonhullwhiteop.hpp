@@ -50,12 +50,15 @@ namespace QuantLib {
 
       protected:
         const Array x_;
-        Array varianceValues_, volatilityValues_;
+        Array varianceValues_, volatilityValues_, drift_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
 
         const boost::shared_ptr<HullWhite> hwModel_;
+        // kept, so that setTime doesn't allocate at each step
+        const boost::shared_ptr<OneFactorModel::ShortRateDynamics>
+                                                                dynamics_;
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<YieldTermStructure> qTS_;
     };
@@ -80,6 +83,18 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction,
+                             const Array& r, Real s, Array& out) const;
+
+        void apply(const Array& r, Array& out, Array& work) const;
+        void apply_mixed(const Array& r, Array& out, Array& work) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& out, Array& work) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -33,6 +33,8 @@ namespace QuantLib {
         const boost::shared_ptr<YieldTermStructure>& qTS,
         const boost::shared_ptr<FdmQuantoHelper>& quantoHelper)
     : varianceValues_(0.5*mesher->locations(1)),
+      drift_(mesher->layout()->size()),
+      discount_(1),
       dxMap_ (FirstDerivativeOp(0, mesher)),
       dxxMap_(SecondDerivativeOp(0, mesher).mult(0.5*mesher->locations(1))),
       mapT_  (0, mesher),
@@ -60,14 +62,18 @@ namespace QuantLib {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
+        discount_[0] = -0.5*r;
         if (quantoHelper_) {
             mapT_.axpyb(r - q - varianceValues_
                 - quantoHelper_->quantoAdjustment(
                 volatilityValues_, t1, t2),
-                dxMap_, dxxMap_, Array(1, -0.5*r));
+                dxMap_, dxxMap_, discount_);
         }
         else {
-            mapT_.axpyb(r - q - varianceValues_, dxMap_, dxxMap_, Array(1, -0.5*r));
+            // avoid temporaries, this is called at each time step
+            for (Size i=0; i < drift_.size(); ++i)
+                drift_[i] = r - q - varianceValues_[i];
+            mapT_.axpyb(drift_, dxMap_, dxxMap_, discount_);
         }
     }
 
@@ -84,12 +90,14 @@ namespace QuantLib {
              .add(FirstDerivativeOp(1, mesher)
                   .mult(kappa*(theta - mesher->locations(1))))),
       mapT_(1, mesher),
+      discount_(1),
       rTS_(rTS) {
     }
 
     void FdmHestonVariancePart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
-        mapT_.axpyb(Array(), dyMap_, dyMap_, Array(1,-0.5*r));
+        discount_[0] = -0.5*r;
+        mapT_.axpyb(Array(), dyMap_, dyMap_, discount_);
     }
 
     const TripleBandLinearOp& FdmHestonVariancePart::getMap() const {
@@ -162,6 +170,55 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply(const Array& u, Array& out) const {
+        Array work(u.size());
+        apply(u, out, work);
+    }
+
+    void FdmHestonOp::apply(const Array& u, Array& out, Array& work) const {
+        dyMap_.getMap().apply(u, out);
+        dxMap_.getMap().apply(u, work);
+        out += work;
+        correlationMap_.apply(u, work);
+        out += work;
+    }
+
+    void FdmHestonOp::apply_direction(Size direction,
+                                      const Array& r, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, out);
+        else if (direction == 1)
+            dyMap_.getMap().apply(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::apply_mixed(const Array& r, Array& out) const {
+        correlationMap_.apply(r, out);
+    }
+
+    void FdmHestonOp::solve_splitting(Size direction,
+                                      const Array& r, Real a,
+                                      Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, out);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting(r, a, 1.0, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting(Size direction,
+                                      const Array& r, Real a,
+                                      Array& out, Array& work) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, out, work);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting(r, a, 1.0, out, work);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonOp::toMatrixDecomp() const {
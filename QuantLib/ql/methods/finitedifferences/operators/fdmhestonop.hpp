@@ -48,6 +48,7 @@ namespace QuantLib {
 
       protected:
         Array varianceValues_, volatilityValues_;
+        Array drift_, discount_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
@@ -70,6 +71,7 @@ namespace QuantLib {
       protected:
         const TripleBandLinearOp dyMap_;
         TripleBandLinearOp mapT_;
+        Array discount_;
 
         const boost::shared_ptr<YieldTermStructure> rTS_;
     };
@@ -95,6 +97,17 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction,
+                             const Array& r, Real s, Array& out) const;
+
+        void apply(const Array& r, Array& out, Array& work) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& out, Array& work) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -40,7 +40,9 @@ namespace QuantLib {
                     .mult(0.5*model->sigma()*model->sigma()
                           *Array(mesher->layout()->size(), 1.0)))),
       mapT_(direction, mesher),
-      model_(model) {
+      shortRate_(mesher->layout()->size()),
+      model_(model),
+      dynamics_(model->dynamics()) {
     }
 
     Size FdmHullWhiteOp::size() const {
@@ -49,13 +51,12 @@ namespace QuantLib {
 
     void FdmHullWhiteOp::setTime(Time t1, Time t2) {
 
-        const boost::shared_ptr<OneFactorModel::ShortRateDynamics> dynamics =
-            model_->dynamics();
+        const Real phi = 0.5*(  dynamics_->shortRate(t1, 0.0)
+                              + dynamics_->shortRate(t2, 0.0));
 
-        const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0)
-                              + dynamics->shortRate(t2, 0.0));
-
-        mapT_.axpyb(Array(), dzMap_, dzMap_, -(x_+phi));
+        for (Size i=0; i < shortRate_.size(); ++i)
+            shortRate_[i] = -(x_[i]+phi);
+        mapT_.axpyb(Array(), dzMap_, dzMap_, shortRate_);
     }
 
     Disposable<Array> FdmHullWhiteOp::apply(const Array& r) const {
@@ -94,6 +95,40 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply(const Array& r, Array& out) const {
+        mapT_.apply(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixed(const Array&, Array& out) const {
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction(Size direction,
+                                         const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.apply(r, out);
+        else
+            std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::solve_splitting(Size direction,
+                                         const Array& r, Real a,
+                                         Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, a, 1.0, out);
+        else
+            std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::solve_splitting(Size direction,
+                                         const Array& r, Real a,
+                                         Array& out, Array& work) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, a, 1.0, out, work);
+        else
+            std::fill(out.begin(), out.end(), 0.0);
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHullWhiteOp::toMatrixDecomp() const {
@@ -26,6 +26,7 @@
 
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/models/shortrate/onefactormodel.hpp>
 
 namespace QuantLib {
 
@@ -52,6 +53,15 @@ namespace QuantLib {
             solve_splitting(Size direction, const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction,
+                             const Array& r, Real s, Array& out) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& out, Array& work) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -60,7 +70,11 @@ namespace QuantLib {
         const Array x_;
         const TripleBandLinearOp dzMap_;
         TripleBandLinearOp mapT_;
+        Array shortRate_;
         const boost::shared_ptr<HullWhite> model_;
+        // kept, so that setTime doesn't allocate at each step
+        const boost::shared_ptr<OneFactorModel::ShortRateDynamics>
+                                                                dynamics_;
     };
 }
 
@@ -36,6 +36,17 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() { }
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
+        /*! writes the result of apply(r) into the given array,
+            which must be of the right size and different from r.
+            Operators overriding this method don't allocate the result;
+            they might allocate scratch space, since they can be called
+            concurrently and can't keep it as a member.  Composite
+            operators can also be given the scratch space by the
+            caller; see FdmLinearOpComposite.
+        */
+        virtual void apply(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
@@ -51,6 +51,48 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place versions
+            The results are written into the given array, which must
+            be of the right size and different from the input.  The
+            default implementations call the methods above; operators
+            overriding them don't allocate the result, but might
+            allocate scratch space.
+        */
+        //@{
+        virtual void apply_mixed(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction(Size direction,
+                                     const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting(Size direction, const Array& r, Real s,
+                                     Array& out) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
+        /*! \name In-place versions with workspace
+            Same as above, with an additional array of the same size
+            as r (and different from both r and out) that operators
+            can use as scratch space instead of allocating it; this
+            allows schemes to perform their steps without allocating
+            memory.  The default implementations ignore it.
+        */
+        //@{
+        using FdmLinearOp::apply;
+        virtual void apply(const Array& r, Array& out, Array&) const {
+            apply(r, out);
+        }
+        virtual void apply_mixed(const Array& r, Array& out, Array&) const {
+            apply_mixed(r, out);
+        }
+        virtual void solve_splitting(Size direction, const Array& r, Real s,
+                                     Array& out, Array&) const {
+            solve_splitting(direction, r, s, out);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
@@ -131,11 +131,19 @@ namespace QuantLib {
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
 
+        Array retVal(u.size());
+        apply(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply(const Array& u, Array& retVal) const {
+
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(retVal.size() == u.size(), "inconsistent length of result");
+        QL_REQUIRE(&retVal != &u, "result must be different from r");
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -156,7 +164,6 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -26,6 +26,14 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // below this size, the overhead of starting threads
+        // outweighs the gain of solving lines in parallel
+        const Size minParallelSize = 4096;
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -178,57 +186,90 @@ namespace QuantLib {
         }
     }
 
+    void TripleBandLinearOp::checkTarget(const TripleBandLinearOp& out) const {
+        QL_REQUIRE(out.mesher_ == mesher_ && out.direction_ == direction_,
+                   "target operator defined on a different mesher "
+                   "or direction");
+    }
+
     Disposable<TripleBandLinearOp>
     TripleBandLinearOp::add(const TripleBandLinearOp& m) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
+        add(m, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::add(const TripleBandLinearOp& m,
+                                 TripleBandLinearOp& out) const {
+        checkTarget(out);
+
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
-            retVal.lower_[i]= lower_[i] + m.lower_[i];
-            retVal.diag_[i] = diag_[i]  + m.diag_[i];
-            retVal.upper_[i]= upper_[i] + m.upper_[i];
+            out.lower_[i]= lower_[i] + m.lower_[i];
+            out.diag_[i] = diag_[i]  + m.diag_[i];
+            out.upper_[i]= upper_[i] + m.upper_[i];
         }
-
-        return retVal;
     }
 
-
     Disposable<TripleBandLinearOp> TripleBandLinearOp::mult(const Array& u) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
+        mult(u, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::mult(const Array& u,
+                                  TripleBandLinearOp& out) const {
+        checkTarget(out);
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
             const Real s = u[i];
-            retVal.lower_[i]= lower_[i]*s;
-            retVal.diag_[i] = diag_[i]*s;
-            retVal.upper_[i]= upper_[i]*s;
+            out.lower_[i]= lower_[i]*s;
+            out.diag_[i] = diag_[i]*s;
+            out.upper_[i]= upper_[i]*s;
         }
-
-        return retVal;
     }
 
     Disposable<TripleBandLinearOp> TripleBandLinearOp::add(const Array& u) const {
 
         TripleBandLinearOp retVal(direction_, mesher_);
+        add(u, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::add(const Array& u,
+                                 TripleBandLinearOp& out) const {
+        checkTarget(out);
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
-            retVal.lower_[i]= lower_[i];
-            retVal.upper_[i]= upper_[i];
-            retVal.diag_[i] = diag_[i]+u[i];
+            out.lower_[i]= lower_[i];
+            out.upper_[i]= upper_[i];
+            out.diag_[i] = diag_[i]+u[i];
         }
+    }
+
+    Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        array_type retVal(r.size());
+        apply(r, retVal);
 
         return retVal;
     }
 
-    Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+    void TripleBandLinearOp::apply(const Array& r, Array& out) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(out.size() == r.size(), "inconsistent length of result");
+        QL_REQUIRE(&out != &r, "result must be different from r");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -236,13 +277,10 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
         //#pragma omp parallel for
         for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+            out[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
-
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -264,8 +302,25 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size());
+        solve_splitting(r, a, b, retVal);
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b,
+                                             Array& retVal) const {
+        Array work(r.size());
+        solve_splitting(r, a, b, retVal, work);
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b,
+                                             Array& retVal,
+                                             Array& tmp) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(retVal.size() == r.size(), "inconsistent size of result");
+        QL_REQUIRE(tmp.size() == r.size(), "inconsistent size of workspace");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -278,36 +333,56 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
-
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        // The lines along the direction are independent tridiagonal
+        // systems, stored consecutively in the reverse index; they
+        // are solved in parallel when OpenMP is enabled.  Lines
+        // assigned to the same thread are contiguous and thus
+        // neighbours in memory, which improves cache reuse.
+        const Size size = layout->size();
+        const Size length = layout->dim()[direction_];
+        const Size lines = size/length;
+        Size failures = 0;
+
+        #pragma omp parallel for schedule(static) \
+                                 if (lines > 1 && size >= minParallelSize)
+        for (Size l=0; l < lines; ++l) {
+            const Size* index = reverseIndex_.get() + l*length;
+            Real* t = tmp.begin() + l*length;
+
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            Size rim1 = index[0];
+            Real bet=1.0/(a*dptr[rim1]+b);
+            if (bet == 0.0) {
+                #pragma omp atomic
+                ++failures;
+                continue;
+            }
+            retVal[rim1] = r[rim1]*bet;
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+            for (Size k=1; k < length; ++k) {
+                const Size ri = index[k];
+                t[k] = a*uptr[rim1]*bet;
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                bet=b+a*(dptr[ri]-t[k]*lptr[ri]);
+                if (bet == 0.0) {
+                    #pragma omp atomic
+                    ++failures;
+                    break;
+                }
+                bet=1.0/bet;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
+                rim1 = ri;
+            }
+            for (Size k=length-1; k > 0; --k)
+                retVal[index[k-1]] -= t[k]*retVal[index[k]];
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
-
-        return retVal;
+        QL_ENSURE(failures == 0, "division by zero");
     }
 }
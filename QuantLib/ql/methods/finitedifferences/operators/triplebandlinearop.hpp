@@ -51,6 +51,31 @@ namespace QuantLib {
         Disposable<TripleBandLinearOp> add(const TripleBandLinearOp& m) const;
         Disposable<TripleBandLinearOp> add(const Array& u) const;
 
+        /*! \name In-place versions
+            The results are written into the last argument, which must
+            be of the right size (for arrays) or be defined on the same
+            mesher and direction (for operators).  No memory is
+            allocated, except for the scratch space of the tridiagonal
+            solver when solve_splitting is not given one; the operator
+            doesn't keep it as a member, so that it can be used
+            concurrently.
+        */
+        //@{
+        //! \pre out must be different from r
+        void apply(const Array& r, Array& out) const;
+        //! out can be the same array as r
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& out) const;
+        /*! \pre work must be of the same size as r and different
+                 from both r and out
+        */
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& out, Array& work) const;
+        void mult(const Array& u, TripleBandLinearOp& out) const;
+        void add(const TripleBandLinearOp& m, TripleBandLinearOp& out) const;
+        void add(const Array& u, TripleBandLinearOp& out) const;
+        //@}
+
         // some very basic linear algebra routines
         void axpyb(const Array& a, const TripleBandLinearOp& x,
                    const TripleBandLinearOp& y, const Array& b);
@@ -70,6 +95,9 @@ namespace QuantLib {
         boost::shared_array<Real> lower_, diag_, upper_;
 
         boost::shared_ptr<FdmMesher> mesher_;
+
+      private:
+        void checkTarget(const TripleBandLinearOp& out) const;
     };
 }
 
@@ -37,17 +37,29 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        if (y_.size() != n) {
+            Array(n).swap(y_);
+            Array(n).swap(rhs_);
+            Array(n).swap(tmp_);
+            Array(n).swap(work_);
+        }
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply(a, tmp_, work_);
+        for (Size j=0; j < n; ++j)
+            y_[j] = a[j] + dt_*tmp_[j];
+        bcSet_.applyAfterApplying(y_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, a, tmp_);
+            for (Size j=0; j < n; ++j)
+                rhs_[j] = y_[j] - theta_*dt_*tmp_[j];
+            map_->solve_splitting(i, rhs_, -theta_*dt_, y_, work_);
         }
-        bcSet_.applyAfterSolving(y);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        a.swap(y_);
     }
 
     void DouglasScheme::setStep(Time dt) {
@@ -54,6 +54,8 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace, reused across steps
+        Array y_, rhs_, tmp_, work_;
     };
 }
 
@@ -33,8 +33,15 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t - dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        if (tmp_.size() != a.size()) {
+            Array(a.size()).swap(tmp_);
+            Array(a.size()).swap(work_);
+        }
+
         bcSet_.applyBeforeApplying(*map_);
-        a += dt_ * map_->apply(a);
+        map_->apply(a, tmp_, work_);
+        for (Size j=0; j < a.size(); ++j)
+            a[j] += dt_*tmp_[j];
         bcSet_.applyAfterApplying(a);
     }
 
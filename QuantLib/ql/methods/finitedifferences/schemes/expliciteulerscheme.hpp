@@ -53,6 +53,8 @@ namespace QuantLib {
         Time dt_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace, reused across steps
+        Array tmp_, work_;
     };
 }
 
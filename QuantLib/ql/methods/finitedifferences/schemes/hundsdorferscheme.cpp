@@ -40,28 +40,48 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        if (y_.size() != n) {
+            Array(n).swap(y_);
+            Array(n).swap(y0_);
+            Array(n).swap(yt_);
+            Array(n).swap(rhs_);
+            Array(n).swap(tmp_);
+            Array(n).swap(work_);
+        }
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply(a, tmp_, work_);
+        for (Size j=0; j < n; ++j)
+            y_[j] = a[j] + dt_*tmp_[j];
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        std::copy(y_.begin(), y_.end(), y0_.begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, a, tmp_);
+            for (Size j=0; j < n; ++j)
+                rhs_[j] = y_[j] - theta_*dt_*tmp_[j];
+            map_->solve_splitting(i, rhs_, -theta_*dt_, y_, work_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply(y-a);
-        bcSet_.applyAfterApplying(yt);
+        for (Size j=0; j < n; ++j)
+            rhs_[j] = y_[j] - a[j];
+        map_->apply(rhs_, tmp_, work_);
+        for (Size j=0; j < n; ++j)
+            yt_[j] = y0_[j] + mu_*dt_*tmp_[j];
+        bcSet_.applyAfterApplying(yt_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, y);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, y_, tmp_);
+            for (Size j=0; j < n; ++j)
+                rhs_[j] = yt_[j] - theta_*dt_*tmp_[j];
+            map_->solve_splitting(i, rhs_, -theta_*dt_, yt_, work_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        a.swap(yt_);
     }
 
     void HundsdorferScheme::setStep(Time dt) {
@@ -60,6 +60,8 @@ namespace QuantLib {
         const Real mu_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace, reused across steps
+        Array y_, y0_, yt_, rhs_, tmp_, work_;
     };
 }
 
@@ -28,6 +28,7 @@
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -51,6 +52,18 @@ namespace QuantLib {
                         Array& newValues) const;
         \endcode
 
+        Unless stepback is redefined, the probabilities, descendants
+        and discounts of the nodes at a given step are read from the
+        implementation the first time the step is rolled back, and
+        stored in contiguous arrays; the stored arrays are used by
+        all the assets rolled back afterwards on the same lattice.
+        Therefore, the results of the above methods must not change
+        after the first rollback.
+
+        \warning the arrays are filled lazily; different threads
+                 should not roll back assets on the same lattice at
+                 the same time.
+
         \ingroup lattices
     */
     template <class Impl>
@@ -87,8 +100,19 @@ namespace QuantLib {
         mutable std::vector<Array> statePrices_;
 
       private:
+        // branching data of the nodes at a given step
+        struct Step {
+            // the data for the n branches of node j are stored at
+            // indices j*n to j*n+n-1
+            std::vector<Size> descendants;
+            std::vector<Real> probabilities;
+            Array discounts;
+        };
+        const Step& step(Size i) const;
+
         Size n_;
         mutable Size statePricesLimit_;
+        mutable std::vector<Step> steps_;
     };
 
 
@@ -163,17 +187,45 @@ namespace QuantLib {
         }
     }
 
+    template <class Impl>
+    const typename TreeLattice<Impl>::Step&
+    TreeLattice<Impl>::step(Size i) const {
+        if (steps_.empty())
+            steps_.resize(t_.size());
+        Step& data = steps_[i];
+        if (data.discounts.empty()) {
+            Size size = this->impl().size(i);
+            data.descendants.resize(size*n_);
+            data.probabilities.resize(size*n_);
+            data.discounts = Array(size);
+            #pragma omp parallel for
+            for (Size j=0; j<size; j++) {
+                for (Size l=0; l<n_; l++) {
+                    data.descendants[j*n_+l] =
+                        this->impl().descendant(i,j,l);
+                    data.probabilities[j*n_+l] =
+                        this->impl().probability(i,j,l);
+                }
+                data.discounts[j] = this->impl().discount(i,j);
+            }
+        }
+        return data;
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
+        const Step& data = step(i);
+        const Size* descendants = &data.descendants[0];
+        const Real* probabilities = &data.probabilities[0];
         #pragma omp parallel for
-        for (Size j=0; j<this->impl().size(i); j++) {
+        for (Size j=0; j<data.discounts.size(); j++) {
+            const Size* d = descendants + j*n_;
+            const Real* p = probabilities + j*n_;
             Real value = 0.0;
-            for (Size l=0; l<n_; l++) {
-                value += this->impl().probability(i,j,l) *
-                         values[this->impl().descendant(i,j,l)];
-            }
-            value *= this->impl().discount(i,j);
+            for (Size l=0; l<n_; l++)
+                value += p[l] * values[d[l]];
+            value *= data.discounts[j];
             newValues[j] = value;
         }
     }
@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/statistics/generalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
@@ -48,17 +49,128 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        //! least-squares regression accumulated one sample at a time
+        /*! The upper triangular factor of the QR decomposition of the
+            augmented design matrix \f$ [A\;y] \f$ is updated with a
+            Givens rotation for each added row; blocks accumulated
+            separately (e.g., on different threads) can be merged by
+            adding the rows of one factor to the other.  The
+            coefficients are then obtained from the SVD of the
+            factor, which has the same singular values and right
+            singular vectors as \f$ A \f$, with the same threshold as
+            GeneralLinearLeastSquares.
+        */
+        class LsmRegressionBlock {
+          public:
+            explicit LsmRegressionBlock(Size dimension)
+            : r_(dimension+1, dimension+1, 0.0), samples_(0) {}
+            //! number of samples added so far
+            Size samples() const { return samples_; }
+            /*! adds a sample; the first elements of the row are the
+                basis functions evaluated at the regressor, the last
+                is the value to be regressed.  The row is modified.
+            */
+            void add(Array& row) {
+                rotate(row);
+                ++samples_;
+            }
+            //! adds the samples accumulated by another block
+            void add(const LsmRegressionBlock& other) {
+                Array row(r_.columns());
+                for (Size i=0; i<other.r_.rows(); ++i) {
+                    std::copy(other.r_.row_begin(i), other.r_.row_end(i),
+                              row.begin());
+                    rotate(row);
+                }
+                samples_ += other.samples_;
+            }
+            Disposable<Array> coefficients() const {
+                const Size m = r_.columns()-1;
+                Matrix R(m, m);
+                Array z(m);
+                for (Size i=0; i<m; ++i) {
+                    std::copy(r_.row_begin(i), r_.row_begin(i)+m,
+                              R.row_begin(i));
+                    z[i] = r_[i][m];
+                }
+
+                const SVD svd(R);
+                const Matrix& V = svd.V();
+                const Matrix& U = svd.U();
+                const Array& w = svd.singularValues();
+                const Real threshold = samples_*QL_EPSILON;
+
+                Array a(m, 0.0);
+                for (Size i=0; i<m; ++i) {
+                    if (w[i] > threshold) {
+                        const Real u = std::inner_product(U.column_begin(i),
+                                                          U.column_end(i),
+                                                          z.begin(), 0.0)/w[i];
+                        for (Size j=0; j<m; ++j)
+                            a[j] += u*V[j][i];
+                    }
+                }
+                return a;
+            }
+          private:
+            void rotate(Array& row) {
+                const Size n = r_.columns();
+                for (Size j=0; j<n; ++j) {
+                    if (row[j] == 0.0)
+                        continue;
+                    const Real d = r_[j][j];
+                    const Real h = std::sqrt(d*d + row[j]*row[j]);
+                    const Real c = d/h, s = row[j]/h;
+                    r_[j][j] = h;
+                    for (Size l=j+1; l<n; ++l) {
+                        const Real t = r_[j][l];
+                        r_[j][l] = c*t + s*row[l];
+                        row[l] = c*row[l] - s*t;
+                    }
+                }
+            }
+            Matrix r_;
+            Size samples_;
+        };
+
+    }
+
     //! Longstaff-Schwarz path pricer for early exercise options
-    /*! References:
+    /*! During the calibration phase, only the exercise values and
+        the states of each path at the exercise times are stored; the
+        paths themselves are discarded.
+
+        If more than one thread is set (and the library was compiled
+        with OpenMP support) the regression at each exercise time is
+        accumulated over fixed-size chunks of the calibration paths
+        in parallel, and the chunks are merged in their original
+        order; the continuation values are also calculated in
+        parallel.  The exercise times are still processed backwards
+        one after the other, since each regression depends on the
+        prices rolled back from the later ones.  The coefficients are
+        the same for any number of threads larger than one, and agree
+        with those obtained by a single thread (which uses
+        GeneralLinearLeastSquares) up to rounding errors.
+
+        References:
 
         Francis Longstaff, Eduardo Schwartz, 2001. Valuing American Options
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        \warning the calibration paths must be passed to the pricer
+                 from a single thread; the pricing paths can be
+                 passed from several threads.
+
         \ingroup mcarlo
 
-        \test the correctness of the returned value is tested by
-              reproducing results available in web/literature
+        \test
+        - the correctness of the returned value is tested by
+          reproducing results available in web/literature
+        - the results of a multi-threaded calibration are checked
+          against those of a single-threaded one.
     */
     template <class PathType>
     class LongstaffSchwartzPathPricer : public PathPricer<PathType> {
@@ -75,6 +187,13 @@ namespace QuantLib {
 
         Real exerciseProbability() const;
 
+        //! sets the number of threads used for the calibration
+        void setThreads(Size threads) {
+            QL_REQUIRE(threads > 0, "at least one thread required");
+            threads_ = threads;
+        }
+        Size threads() const { return threads_; }
+
       protected:
         virtual void post_processing(const Size i,
                                      const std::vector<StateType> &state,
@@ -89,10 +208,19 @@ namespace QuantLib {
         boost::scoped_array<Array> coeff_;
         boost::scoped_array<DiscountFactor> dF_;
 
-        mutable std::vector<PathType> paths_;
+        // exercise values and states of the calibration paths at
+        // times 1 to len_-1, stored path after path
+        mutable std::vector<Real> exercise_;
+        mutable std::vector<StateType> states_;
         const   std::vector<boost::function1<Real, StateType> > v_;
 
         const Size len_;
+        Size threads_;
+
+      private:
+        void regress(Size i, const Array& prices);
+        void regressInParallel(Size i, const Array& prices);
+        void rollBack(Size i, Array& prices) const;
     };
 
     template <class PathType> inline
@@ -106,7 +234,8 @@ namespace QuantLib {
       coeff_     (new Array[times.size()-2]),
       dF_        (new DiscountFactor[times.size()-1]),
       v_         (pathPricer_->basisSystem()),
-      len_       (times.size()) {
+      len_       (times.size()),
+      threads_   (1) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -118,8 +247,11 @@ namespace QuantLib {
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
         if (calibrationPhase_) {
-            // store paths for the calibration
-            paths_.push_back(path);
+            // store what the calibration needs
+            for (Size i=1; i<len_; ++i) {
+                exercise_.push_back((*pathPricer_)(path, i));
+                states_.push_back(pathPricer_->state(path, i));
+            }
             // result doesn't matter
             return 0.0;
         }
@@ -150,6 +282,7 @@ namespace QuantLib {
             }
         }
 
+        #pragma omp critical(ql_lsm_exercise_probability)
         exerciseProbability_.add(exercised ? 1.0 : 0.0);
 
         return price*dF_[0];
@@ -157,68 +290,159 @@ namespace QuantLib {
 
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
-        const Size n = paths_.size();
-        Array prices(n), exercise(n);
+        const Size m = len_-1;
+        const Size n = exercise_.size()/m;
+        Array prices(n);
         std::vector<StateType> p_state(n);
         std::vector<Real> p_price(n), p_exercise(n);
 
-        for (Size i=0; i<n; ++i) {
-            p_state[i] = pathPricer_->state(paths_[i],len_-1);
-            prices[i] = p_price[i] = (*pathPricer_)(paths_[i], len_-1);
-            p_exercise[i] = prices[i];
+        for (Size j=0; j<n; ++j) {
+            p_state[j] = states_[j*m+m-1];
+            prices[j] = p_price[j] = exercise_[j*m+m-1];
+            p_exercise[j] = prices[j];
         }
 
         post_processing(len_ - 1, p_state, p_price, p_exercise);
 
-        std::vector<Real>      y;
-        std::vector<StateType> x;
         for (Size i=len_-2; i>0; --i) {
-            y.clear();
-            x.clear();
+            if (threads_ > 1)
+                regressInParallel(i, prices);
+            else
+                regress(i, prices);
+
+            rollBack(i, prices);
 
-            //roll back step
             for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
-                if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
-                    y.push_back(dF_[i]*prices[j]);
-                }
+                p_state[j] = states_[j*m+i-1];
+                p_price[j] = prices[j];
+                p_exercise[j] = exercise_[j*m+i-1];
             }
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i-1] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            post_processing(i, p_state, p_price, p_exercise);
+        }
+
+        // remove calibration data and release memory
+        std::vector<Real> noExercise;
+        exercise_.swap(noExercise);
+        std::vector<StateType> noStates;
+        states_.swap(noStates);
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::regress(Size i,
+                                                        const Array& prices) {
+        const Size m = len_-1;
+        const Size n = prices.size();
+
+        std::vector<Real>      y;
+        std::vector<StateType> x;
+        for (Size j=0; j<n; ++j) {
+            if (exercise_[j*m+i-1]>0.0) {
+                x.push_back(states_[j*m+i-1]);
+                y.push_back(dF_[i]*prices[j]);
             }
-            else {
-            // if number of itm paths is smaller then the number of
-            // calibration functions then early exercise if exerciseValue > 0
-                coeff_[i-1] = Array(v_.size(), 0.0);
+        }
+
+        if (v_.size() <=  x.size()) {
+            coeff_[i-1] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+        }
+        else {
+        // if number of itm paths is smaller then the number of
+        // calibration functions then early exercise if exerciseValue > 0
+            coeff_[i-1] = Array(v_.size(), 0.0);
+        }
+    }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::regressInParallel(
+                                                      Size i,
+                                                      const Array& prices) {
+        const Size m = len_-1;
+        const Size n = prices.size();
+        const Size k = v_.size();
+
+        // the chunks don't depend on the number of threads, so that
+        // neither do the results
+        const Size chunkSize = 256;
+        const Size chunks = (n+chunkSize-1)/chunkSize;
+        std::vector<detail::LsmRegressionBlock> blocks(
+                                         chunks, detail::LsmRegressionBlock(k));
+        std::vector<std::string> errors(chunks);
+
+        #pragma omp parallel for num_threads(threads_) schedule(dynamic)
+        for (Size c=0; c<chunks; ++c) {
+            try {
+                Array row(k+1);
+                const Size end = std::min(n, (c+1)*chunkSize);
+                for (Size j=c*chunkSize; j<end; ++j) {
+                    if (exercise_[j*m+i-1]>0.0) {
+                        const StateType& x = states_[j*m+i-1];
+                        for (Size l=0; l<k; ++l)
+                            row[l] = v_[l](x);
+                        row[k] = dF_[i]*prices[j];
+                        blocks[c].add(row);
+                    }
+                }
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            } catch (...) {
+                errors[c] = "unknown error";
             }
+        }
+
+        for (Size c=0; c<chunks; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+
+        detail::LsmRegressionBlock regression(k);
+        for (Size c=0; c<chunks; ++c)
+            regression.add(blocks[c]);
+
+        if (k <= regression.samples()) {
+            coeff_[i-1] = regression.coefficients();
+        }
+        else {
+            coeff_[i-1] = Array(k, 0.0);
+        }
+    }
 
-            for (Size j=0, k=0; j<n; ++j) {
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::rollBack(Size i,
+                                                         Array& prices) const {
+        const Size m = len_-1;
+        const Size n = prices.size();
+        const Array& coeff = coeff_[i-1];
+        std::string error;
+
+        #pragma omp parallel for num_threads(threads_) schedule(static) \
+                                 if(threads_ > 1)
+        for (Size j=0; j<n; ++j) {
+            try {
                 prices[j]*=dF_[i];
-                if (exercise[j]>0.0) {
+                const Real exercise = exercise_[j*m+i-1];
+                if (exercise>0.0) {
+                    const StateType& x = states_[j*m+i-1];
                     Real continuationValue = 0.0;
                     for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i-1][l] * v_[l](x[k]);
+                        continuationValue += coeff[l] * v_[l](x);
                     }
-                    if (continuationValue < exercise[j]) {
-                        prices[j] = exercise[j];
+                    if (continuationValue < exercise) {
+                        prices[j] = exercise;
                     }
-                    ++k;
                 }
-                p_state[j] = pathPricer_->state(paths_[j],i);
-                p_price[j] = prices[j];
-                p_exercise[j] = exercise[j];
+            } catch (std::exception& e) {
+                #pragma omp critical(ql_lsm_roll_back)
+                if (error.empty())
+                    error = e.what();
+            } catch (...) {
+                #pragma omp critical(ql_lsm_roll_back)
+                if (error.empty())
+                    error = "unknown error";
             }
-
-            post_processing(i, p_state, p_price, p_exercise);
         }
 
-        // remove calibration paths and release memory
-        std::vector<PathType> empty;
-        paths_.swap(empty);
-        // entering the calculation phase
-        calibrationPhase_ = false;
+        QL_REQUIRE(error.empty(), error);
     }
 
     template <class PathType> inline
@@ -226,7 +450,6 @@ namespace QuantLib {
         return exerciseProbability_.mean();
     }
 
-
 }
 
 
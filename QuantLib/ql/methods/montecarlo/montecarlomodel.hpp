@@ -28,9 +28,37 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // tells whether a sequence generator provides void skip(Size)
+        template <class GSG>
+        class has_skip {
+            typedef char yes;
+            typedef char (&no)[2];
+            template <class U, void (U::*)(Size)> struct check;
+            template <class U> static yes test(check<U, &U::skip>*);
+            template <class U> static no test(...);
+          public:
+            static const bool value = sizeof(test<GSG>(0)) == sizeof(yes);
+        };
+
+        // InverseCumulativeRsg always declares skip(), but can only
+        // use it if the underlying uniform generator provides one
+        template <class USG, class IC>
+        class has_skip<InverseCumulativeRsg<USG,IC> > {
+          public:
+            static const bool value = has_skip<USG>::value;
+        };
+
+    }
+
     //! General-purpose Monte Carlo model for path samples
     /*! The template arguments of this class correspond to available
         policies for the particular model to be instantiated---i.e.,
@@ -45,6 +73,28 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        If more than one thread is requested (and the library was
+        compiled with OpenMP support) the samples of each call to
+        addSamples() are split into contiguous chunks, each of which
+        is simulated by a copy of the path generator moved forward
+        with skip-ahead; the resulting values are then added to the
+        accumulator in their original order. Therefore, the results
+        are the same as in the single-threaded case regardless of the
+        number of threads used.  This requires the sequence generator
+        RNG::rsg_type to implement
+        \code
+            void GSG::skip(Size n);
+        \endcode
+        otherwise, the constructor refuses more than one thread.
+        Low-discrepancy generators skip in constant time; the
+        pseudo-random RandomSequenceGenerator draws and discards the
+        skipped numbers, so that the start-up cost of each chunk
+        grows with its position.
+
+        \warning in multi-threaded mode the path pricers and the
+                 underlying stochastic process are called concurrently
+                 and must not modify their state.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,12 +117,18 @@ namespace QuantLib {
                         = boost::shared_ptr<path_pricer_type>(),
                   result_type cvOptionValue = result_type(),
                   const boost::shared_ptr<path_generator_type>& cvPathGenerator
-                        = boost::shared_ptr<path_generator_type>())
+                        = boost::shared_ptr<path_generator_type>(),
+                  Size threads = 1)
         : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator), threads_(threads) {
+            QL_REQUIRE(threads_ > 0, "at least one thread required");
+            QL_REQUIRE(threads_ == 1 ||
+                       detail::has_skip<typename RNG::rsg_type>::value,
+                       "multi-threaded simulation requires a sequence "
+                       "generator implementing skip()");
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
@@ -80,7 +136,18 @@ namespace QuantLib {
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        Size threads() const { return threads_; }
       private:
+        typedef boost::integral_constant<
+            bool, detail::has_skip<typename RNG::rsg_type>::value> can_skip;
+        void addSamplesInParallel(Size samples, boost::true_type);
+        void addSamplesInParallel(Size, boost::false_type) {
+            QL_FAIL("multi-threaded simulation requires a sequence "
+                    "generator implementing skip()");
+        }
+        result_type nextValue(const path_generator_type& pathGenerator,
+                              const path_generator_type* cvPathGenerator,
+                              Real& weight) const;
         boost::shared_ptr<path_generator_type> pathGenerator_;
         boost::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -89,42 +156,112 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         boost::shared_ptr<path_generator_type> cvPathGenerator_;
+        Size threads_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (threads_ > 1 && samples > 1) {
+            addSamplesInParallel(samples, can_skip());
+            return;
+        }
+
         for(Size j = 1; j <= samples; j++) {
+            Real weight;
+            result_type price = nextValue(*pathGenerator_,
+                                          cvPathGenerator_.get(), weight);
+            sampleAccumulator_.add(price, weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInParallel(
+                                             Size samples, boost::true_type) {
+        std::vector<result_type> values(samples);
+        std::vector<Real> weights(samples);
 
-            sample_type path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        // lazy objects in the process or in the pricers are not thread
+        // safe; the first sample is drawn here so that any pending
+        // calculation is triggered before entering the parallel loop
+        values[0] = nextValue(*pathGenerator_, cvPathGenerator_.get(),
+                              weights[0]);
 
-            if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
-                else {
-                    sample_type cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+        const Size remaining = samples-1;
+        const Size chunks = std::min(threads_, remaining);
+        std::vector<std::string> errors(chunks);
+
+        #pragma omp parallel for num_threads(threads_) schedule(static,1)
+        for (Size c=0; c<chunks; ++c) {
+            const Size begin = (c*remaining)/chunks,
+                       end = ((c+1)*remaining)/chunks;
+            try {
+                path_generator_type generator(*pathGenerator_);
+                generator.skip(begin);
+                boost::shared_ptr<path_generator_type> cvGenerator;
+                if (cvPathGenerator_) {
+                    cvGenerator = boost::shared_ptr<path_generator_type>(
+                                   new path_generator_type(*cvPathGenerator_));
+                    cvGenerator->skip(begin);
                 }
+                for (Size j=begin+1; j<=end; ++j)
+                    values[j] = nextValue(generator, cvGenerator.get(),
+                                          weights[j]);
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            } catch (...) {
+                errors[c] = "unknown error";
             }
+        }
 
-            if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(path.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
+        for (Size c=0; c<chunks; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+
+        pathGenerator_->skip(remaining);
+        if (cvPathGenerator_)
+            cvPathGenerator_->skip(remaining);
+
+        for (Size j=0; j<samples; ++j)
+            sampleAccumulator_.add(values[j], weights[j]);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MonteCarloModel<MC,RNG,S>::result_type
+    MonteCarloModel<MC,RNG,S>::nextValue(
+                            const path_generator_type& pathGenerator,
+                            const path_generator_type* cvPathGenerator,
+                            Real& weight) const {
+
+        sample_type path = pathGenerator.next();
+        result_type price = (*pathPricer_)(path.value);
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+        if (isControlVariate_) {
+            if (!cvPathGenerator) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
             }
+            else {
+                sample_type cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
+
+        if (isAntitheticVariate_) {
+            path = pathGenerator.antithetic();
+            result_type price2 = (*pathPricer_)(path.value);
+            if (isControlVariate_) {
+                if (!cvPathGenerator)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
+                else {
+                    sample_type cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                }
+            }
+
+            weight = path.weight;
+            return (price+price2)/2.0;
+        } else {
+            weight = path.weight;
+            return price;
         }
     }
 
@@ -45,6 +45,8 @@ namespace QuantLib {
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
+        \test paths generated in batches are checked against the
+              ones generated sequentially
     */
     template <class GSG>
     class MultiPathGenerator {
@@ -56,12 +58,46 @@ namespace QuantLib {
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! skips the next n multipaths
+        /*! This requires the sequence generator to implement
+            \code
+                void GSG::skip(Size n);
+            \endcode
+        */
+        void skip(Size n) { generator_.skip(n); }
+        //! \name batch generation
+        //@{
+        /*! generates the next n multipaths at once. On return,
+            paths contains one matrix per asset; each of them has
+            one row per time in the grid and one column per path,
+            so that the values of all paths at a given time are
+            stored contiguously. weights[j] is the weight of the
+            j-th multipath. The containers are resized if needed.
+
+            The multipaths are the same that would be returned by
+            n successive calls to next(); however, the process is
+            evolved through StochasticProcess::evolveBatch(), which
+            allows it to perform path-independent calculations only
+            once per time step.
+        */
+        void nextBatch(Size n,
+                       std::vector<Matrix>& paths,
+                       Array& weights) const;
+        /*! generates the antithetic multipaths of those returned
+            by the last call to nextBatch().
+        */
+        void antitheticBatch(std::vector<Matrix>& paths,
+                             Array& weights) const;
+        //@}
       private:
         const sample_type& next(bool antithetic) const;
+        void evolveBatch(bool antithetic, std::vector<Matrix>& paths) const;
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        mutable Matrix batchDraws_, batchState_, batchIncrements_;
+        mutable Array batchWeights_;
     };
 
 
@@ -150,6 +186,92 @@ namespace QuantLib {
         }
     }
 
+    template <class GSG>
+    void MultiPathGenerator<GSG>::nextBatch(Size n,
+                                            std::vector<Matrix>& paths,
+                                            Array& weights) const {
+        QL_REQUIRE(n > 0, "null number of paths given");
+        QL_REQUIRE(!brownianBridge_, "Brownian bridge not supported");
+
+        typedef typename GSG::sample_type sequence_type;
+        if (batchDraws_.columns() != n)
+            batchDraws_ = Matrix(generator_.dimension(), n);
+        if (batchWeights_.size() != n)
+            batchWeights_ = Array(n);
+
+        for (Size j=0; j<n; j++) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            std::copy(sequence_.value.begin(),
+                      sequence_.value.end(),
+                      batchDraws_.column_begin(j));
+            batchWeights_[j] = sequence_.weight;
+        }
+
+        weights = batchWeights_;
+        evolveBatch(false, paths);
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::antitheticBatch(std::vector<Matrix>& paths,
+                                                  Array& weights) const {
+        QL_REQUIRE(!batchDraws_.empty(), "no batch generated yet");
+        weights = batchWeights_;
+        evolveBatch(true, paths);
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::evolveBatch(
+                                       bool antithetic,
+                                       std::vector<Matrix>& paths) const {
+        Size m = process_->size();
+        Size n = process_->factors();
+        Size nPaths = batchDraws_.columns();
+
+        const TimeGrid& timeGrid = next_.value[0].timeGrid();
+        Size pathSize = timeGrid.size();
+
+        paths.resize(m);
+        for (Size k=0; k<m; k++)
+            if (paths[k].rows() != pathSize || paths[k].columns() != nPaths)
+                paths[k] = Matrix(pathSize, nPaths);
+        if (batchState_.columns() != nPaths) {
+            batchState_ = Matrix(m, nPaths);
+            batchIncrements_ = Matrix(n, nPaths);
+        }
+
+        Array asset = process_->initialValues();
+        for (Size k=0; k<m; k++) {
+            std::fill(batchState_.row_begin(k), batchState_.row_end(k),
+                      asset[k]);
+            std::copy(batchState_.row_begin(k), batchState_.row_end(k),
+                      paths[k].row_begin(0));
+        }
+
+        Time t, dt;
+        for (Size i = 1; i < pathSize; i++) {
+            Size offset = (i-1)*n;
+            t = timeGrid[i-1];
+            dt = timeGrid.dt(i-1);
+            for (Size l=0; l<n; l++) {
+                if (antithetic)
+                    std::transform(batchDraws_.row_begin(offset+l),
+                                   batchDraws_.row_end(offset+l),
+                                   batchIncrements_.row_begin(l),
+                                   std::negate<Real>());
+                else
+                    std::copy(batchDraws_.row_begin(offset+l),
+                              batchDraws_.row_end(offset+l),
+                              batchIncrements_.row_begin(l));
+            }
+
+            process_->evolveBatch(t, batchState_, dt, batchIncrements_,
+                                  batchState_);
+            for (Size k=0; k<m; k++)
+                std::copy(batchState_.row_begin(k), batchState_.row_end(k),
+                          paths[k].row_begin(i));
+        }
+    }
+
 }
 
 #endif
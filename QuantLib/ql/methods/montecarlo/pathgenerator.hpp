@@ -39,6 +39,8 @@ namespace QuantLib {
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
+        \test paths generated in batches are checked against the
+              ones generated sequentially
     */
     template <class GSG>
     class PathGenerator {
@@ -61,8 +63,37 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! skips the next n paths
+        /*! This requires the sequence generator to implement
+            \code
+                void GSG::skip(Size n);
+            \endcode
+        */
+        void skip(Size n) { generator_.skip(n); }
+        //! \name batch generation
+        //@{
+        /*! generates the next n paths at once. On return, paths
+            has one row per time in the grid and one column per
+            path, so that the values of all paths at a given time
+            are stored contiguously; weights[j] is the weight of
+            the j-th path. The matrix and the array are resized if
+            needed.
+
+            The paths are the same that would be returned by n
+            successive calls to next(); however, the process is
+            evolved through StochasticProcess1D::evolveBatch(),
+            which allows it to perform path-independent
+            calculations only once per time step.
+        */
+        void nextBatch(Size n, Matrix& paths, Array& weights) const;
+        /*! generates the antithetic paths of those returned by the
+            last call to nextBatch().
+        */
+        void antitheticBatch(Matrix& paths, Array& weights) const;
+        //@}
       private:
         const sample_type& next(bool antithetic) const;
+        void evolveBatch(bool antithetic, Matrix& paths) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -71,6 +102,8 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        mutable Matrix batchDraws_;
+        mutable Array batchWeights_, batchState_, batchIncrements_;
     };
 
 
@@ -154,6 +187,78 @@ namespace QuantLib {
         return next_;
     }
 
+    template <class GSG>
+    void PathGenerator<GSG>::nextBatch(Size n, Matrix& paths,
+                                       Array& weights) const {
+        QL_REQUIRE(n > 0, "null number of paths given");
+
+        typedef typename GSG::sample_type sequence_type;
+        if (batchDraws_.columns() != n)
+            batchDraws_ = Matrix(dimension_, n);
+        if (batchWeights_.size() != n)
+            batchWeights_ = Array(n);
+
+        for (Size j=0; j<n; j++) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            if (brownianBridge_) {
+                bb_.transform(sequence_.value.begin(),
+                              sequence_.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+            }
+            std::copy(temp_.begin(), temp_.end(),
+                      batchDraws_.column_begin(j));
+            batchWeights_[j] = sequence_.weight;
+        }
+
+        weights = batchWeights_;
+        evolveBatch(false, paths);
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::antitheticBatch(Matrix& paths,
+                                             Array& weights) const {
+        QL_REQUIRE(!batchDraws_.empty(), "no batch generated yet");
+        weights = batchWeights_;
+        evolveBatch(true, paths);
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::evolveBatch(bool antithetic,
+                                         Matrix& paths) const {
+        const Size n = batchDraws_.columns();
+        if (paths.rows() != timeGrid_.size() || paths.columns() != n)
+            paths = Matrix(timeGrid_.size(), n);
+        if (batchState_.size() != n) {
+            batchState_ = Array(n);
+            batchIncrements_ = Array(n);
+        }
+
+        std::fill(batchState_.begin(), batchState_.end(), process_->x0());
+        std::copy(batchState_.begin(), batchState_.end(), paths.row_begin(0));
+
+        for (Size i=1; i<timeGrid_.size(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            if (antithetic)
+                std::transform(batchDraws_.row_begin(i-1),
+                               batchDraws_.row_end(i-1),
+                               batchIncrements_.begin(),
+                               std::negate<Real>());
+            else
+                std::copy(batchDraws_.row_begin(i-1),
+                          batchDraws_.row_end(i-1),
+                          batchIncrements_.begin());
+            process_->evolveBatch(t, batchState_, dt, batchIncrements_,
+                                  batchState_);
+            std::copy(batchState_.begin(), batchState_.end(),
+                      paths.row_begin(i));
+        }
+    }
+
 }
 
 
@@ -21,6 +21,7 @@
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -80,6 +81,12 @@ namespace QuantLib {
 
     Real HestonModelHelper::modelValue() const {
         calculate();
+        // helpers sharing an analytic engine and an exercise date are
+        // priced together, evaluating the characteristic function once
+        boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        if (engine && engine->allowsBatchPricing() && !option_->isExpired())
+            return engine->batchedPrice(exerciseDate_, strikePrice_, type_);
         option_->setPricingEngine(engine_);
         return option_->NPV();
     }
@@ -23,19 +23,22 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
     AccountingEngine::AccountingEngine(
                          const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
-                         Real initialNumeraireValue)
+                         Real initialNumeraireValue,
+                         Size threads)
     : evolver_(evolver), product_(product),
       initialNumeraireValue_(initialNumeraireValue),
-      numberProducts_(product->numberOfProducts()),
+      numberProducts_(product->numberOfProducts()), threads_(threads),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
       cashFlowsGenerated_(product->numberOfProducts()) {
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
         for (Size i=0; i<numberProducts_; ++i)
             cashFlowsGenerated_[i].resize(
                        product_->maxNumberOfCashFlowsPerProductPerStep());
@@ -115,6 +118,11 @@ namespace QuantLib {
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
+        if (threads_ > 1 && numberOfPaths > 1) {
+            multiplePathValuesInParallel(stats, numberOfPaths);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts());
         for (Size i=0; i<numberOfPaths; ++i) {
             Real weight = singlePathValues(values);
@@ -122,4 +130,46 @@ namespace QuantLib {
         }
     }
 
+    void AccountingEngine::multiplePathValuesInParallel(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        const Size n = numberProducts_;
+        std::vector<Real> values(numberOfPaths*n), weights(numberOfPaths);
+
+        const Size chunks = std::min(threads_, numberOfPaths);
+        std::vector<std::string> errors(chunks);
+
+        #pragma omp parallel for num_threads(threads_) schedule(static,1)
+        for (Size c=0; c<chunks; ++c) {
+            const Size begin = (c*numberOfPaths)/chunks,
+                       end = ((c+1)*numberOfPaths)/chunks;
+            try {
+                boost::shared_ptr<MarketModelEvolver> evolver(
+                                                evolver_->clone().release());
+                evolver->skip(begin);
+                AccountingEngine engine(evolver, product_,
+                                        initialNumeraireValue_);
+                std::vector<Real> pathValues(n);
+                for (Size j=begin; j<end; ++j) {
+                    weights[j] = engine.singlePathValues(pathValues);
+                    std::copy(pathValues.begin(), pathValues.end(),
+                              values.begin()+j*n);
+                }
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            } catch (...) {
+                errors[c] = "unknown error";
+            }
+        }
+
+        for (Size c=0; c<chunks; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+
+        evolver_->skip(numberOfPaths);
+
+        for (Size j=0; j<numberOfPaths; ++j)
+            stats.add(values.begin()+j*n, values.begin()+(j+1)*n,
+                      weights[j]);
+    }
+
 }
@@ -41,21 +41,39 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! If more than one thread is requested (and the library was
+        compiled with OpenMP support) the paths of each call to
+        multiplePathValues() are split into contiguous chunks.  Each
+        chunk is evolved by a clone of the evolver, moved forward
+        with skip-ahead, and priced with a clone of the product; the
+        resulting values are then added to the statistics in their
+        original order.  Therefore, the results are the same as in
+        the single-threaded case regardless of the number of threads
+        used.
+
+        \warning in multi-threaded mode, the evolver must implement
+                 the clone() and skip() methods.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
-                         Real initialNumeraireValue);
+                         Real initialNumeraireValue,
+                         Size threads = 1);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        Size threads() const { return threads_; }
       private:
         Real singlePathValues(std::vector<Real>& values);
+        void multiplePathValuesInParallel(SequenceStatisticsInc& stats,
+                                          Size numberOfPaths);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
 
         Real initialNumeraireValue_;
         Size numberProducts_;
+        Size threads_;
 
         // workspace
         std::vector<Real> numerairesHeld_;
@@ -22,7 +22,9 @@
 #define quantlib_brownian_generator_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <vector>
 
 namespace QuantLib {
@@ -37,6 +39,19 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+
+        //! skips the given number of paths
+        /*! The default implementation draws and discards them;
+            derived classes can provide a faster one.
+        */
+        virtual void skip(Size paths) {
+            for (Size i=0; i<paths; ++i)
+                nextPath();
+        }
+        //! returns a copy of the generator in its current state
+        virtual std::auto_ptr<BrownianGenerator> clone() const {
+            QL_FAIL("cloning not supported by this Brownian generator");
+        }
     };
 
     class BrownianGeneratorFactory {
@@ -56,6 +56,15 @@ namespace QuantLib {
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void MTBrownianGenerator::skip(Size paths) {
+        generator_.skip(paths);
+        lastStep_ = 0;
+    }
+
+    std::auto_ptr<BrownianGenerator> MTBrownianGenerator::clone() const {
+        return std::auto_ptr<BrownianGenerator>(new MTBrownianGenerator(*this));
+    }
+
 
     MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
     : seed_(seed) {}
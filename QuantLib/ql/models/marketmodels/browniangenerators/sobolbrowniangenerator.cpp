@@ -208,6 +208,16 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void SobolBrownianGenerator::skip(Size paths) {
+        generator_.skip(paths);
+        lastStep_ = 0;
+    }
+
+    std::auto_ptr<BrownianGenerator> SobolBrownianGenerator::clone() const {
+        return std::auto_ptr<BrownianGenerator>(
+                                           new SobolBrownianGenerator(*this));
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
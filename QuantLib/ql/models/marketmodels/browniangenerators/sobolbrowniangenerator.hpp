@@ -59,6 +59,8 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+        void skip(Size paths);
+        std::auto_ptr<BrownianGenerator> clone() const;
         
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
@@ -21,6 +21,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <ql/models/marketmodels/driftcomputation/cmsmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/curvestates/cmswapcurvestate.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -36,9 +38,9 @@ namespace QuantLib {
       numeraire_(numeraire), alive_(alive),
       displacements_(displacements), oneOverTaus_(taus.size()),
       pseudo_(pseudo), tmp_(taus.size(), 0.0),
-      PjPnWk_(numberOfFactors_,1+taus.size()),
-      wkaj_(numberOfFactors_, taus.size()),
-      wkajN_(numberOfFactors_, taus.size()),
+      PjPnWk_(1+taus.size(), numberOfFactors_),
+      wkaj_(taus.size(), numberOfFactors_),
+      wkajN_(taus.size(), numberOfFactors_),
       downs_(taus.size()), ups_(taus.size()),
       spanningFwds_(spanningFwds) {
 
@@ -82,56 +84,65 @@ namespace QuantLib {
         const std::vector<Time>& taus = cs.rateTaus();
         // final bond is numeraire
 
-        // Compute cross variations
-        for (Size k=0; k<PjPnWk_.rows(); ++k) {
-            PjPnWk_[k][numberOfRates_]=0.0;
-            wkaj_[k][numberOfRates_-1]=0.0;
+        // Compute cross variations; the work matrices are stored rate
+        // by rate, so that the swap rates and annuities are calculated
+        // once per rate and the loops over the factors run on
+        // contiguous memory.
+        std::fill(PjPnWk_.row_begin(numberOfRates_),
+                  PjPnWk_.row_end(numberOfRates_), 0.0);
+        std::fill(wkaj_.row_begin(numberOfRates_-1),
+                  wkaj_.row_end(numberOfRates_-1), 0.0);
+
+        for (Integer j=static_cast<Integer>(numberOfRates_)-2;
+             j>=static_cast<Integer>(alive_)-1; --j)
+        {
+            Real sr = cs.cmSwapRate(j+1,spanningFwds_);
+            Integer endIndex =
+                std::min<Integer>(j + static_cast<Integer>(spanningFwds_) + 1,
+                                  static_cast<Integer>(numberOfRates_));
+            Real annuity = cs.cmSwapAnnuity(numberOfRates_,j+1,spanningFwds_);
+            Real displacement = displacements_[j+1];
+            Matrix::const_row_iterator a = pseudo_.row_begin(j+1);
+            Matrix::const_row_iterator waNext = wkaj_.row_begin(j+1);
+            Matrix::const_row_iterator pEnd = PjPnWk_.row_begin(endIndex);
+            Matrix::row_iterator p = PjPnWk_.row_begin(j+1);
+            for (Size k=0; k<numberOfFactors_; ++k) {
+                Real first = sr * waNext[k];
+                Real second = annuity * (sr+displacement) * a[k];
+                Real third = pEnd[k];
+                p[k] = first + second + third;
+            }
 
-            for (Integer j=static_cast<Integer>(numberOfRates_)-2;
-                 j>=static_cast<Integer>(alive_)-1; --j)
+            if (j>=static_cast<Integer>(alive_))
             {
-                Real sr = cs.cmSwapRate(j+1,spanningFwds_);
-                Integer endIndex =
-                    std::min<Integer>(j + static_cast<Integer>(spanningFwds_) + 1,
-                             static_cast<Integer>(numberOfRates_));
-                Real first = sr * wkaj_[k][j+1];
-                Real second = cs.cmSwapAnnuity(numberOfRates_,j+1,spanningFwds_)
-                * (sr+displacements_[j+1])
-                *pseudo_[j+1][k];
-                Real third = PjPnWk_[k][endIndex];
-                PjPnWk_[k][j+1] = first
-                + second
-                + third;
-
-                if (j>=static_cast<Integer>(alive_))
-                {
-                    wkaj_[k][j] = wkaj_[k][j+1] + PjPnWk_[k][j+1]*taus[j];
-
-                    if (j+spanningFwds_+1 <= numberOfRates_)
-                        wkaj_[k][j] -= PjPnWk_[k][endIndex]*taus[endIndex-1];
+                Real tau = taus[j];
+                Matrix::row_iterator wa = wkaj_.row_begin(j);
+                for (Size k=0; k<numberOfFactors_; ++k)
+                    wa[k] = waNext[k] + p[k]*tau;
+
+                if (j+spanningFwds_+1 <= numberOfRates_) {
+                    Real tauEnd = taus[endIndex-1];
+                    for (Size k=0; k<numberOfFactors_; ++k)
+                        wa[k] -= pEnd[k]*tauEnd;
                 }
-
             }
         }
 
         Real PnOverPN = cs.discountRatio(numberOfRates_, numeraire_);
         //Real PnOverPN = 1.0;
-
-        for (Size j=alive_; j<numberOfRates_; ++j)
-            for (Size k=0; k<numberOfFactors_; ++k)
-                wkajN_[k][j] =  wkaj_[k][j]*PnOverPN
-                    -PjPnWk_[k][numeraire_]*PnOverPN*cs.cmSwapAnnuity(numeraire_,j,spanningFwds_);
-
-
+        Matrix::const_row_iterator pN = PjPnWk_.row_begin(numeraire_);
 
         for (Size j=alive_; j<numberOfRates_; ++j)
         {
-            drifts[j]=0.0;
+            Real annuity = cs.cmSwapAnnuity(numeraire_,j,spanningFwds_);
+            Matrix::const_row_iterator wa = wkaj_.row_begin(j);
+            Matrix::row_iterator wn = wkajN_.row_begin(j);
             for (Size k=0; k<numberOfFactors_; ++k)
-            {
-                drifts[j] += pseudo_[j][k]*wkajN_[k][j];
-            }
-            drifts[j] /= -cs.cmSwapAnnuity(numeraire_,j,spanningFwds_);
+                wn[k] = wa[k]*PnOverPN - pN[k]*PnOverPN*annuity;
+
+            drifts[j] = std::inner_product(pseudo_.row_begin(j),
+                                           pseudo_.row_end(j), wn, 0.0);
+            drifts[j] /= -annuity;
         }
     }
 
@@ -59,9 +59,10 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
-        mutable Matrix PjPnWk_; // < Wk, P_{j}/P_n> (k, j)
-        mutable Matrix wkaj_;    // < Wk , Aj/Pn> (k, j)
-        mutable Matrix wkajN_;    // < Wk , Aj/PN> (k, j)
+        // stored by rate, i.e., (j, k), for contiguous access to factors
+        mutable Matrix PjPnWk_; // < Wk, P_{j}/P_n> (j, k)
+        mutable Matrix wkaj_;    // < Wk , Aj/Pn> (j, k)
+        mutable Matrix wkajN_;    // < Wk , Aj/PN> (j, k)
 
         std::vector<Size> downs_, ups_;
         Size spanningFwds_;
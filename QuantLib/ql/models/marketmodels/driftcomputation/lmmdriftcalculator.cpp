@@ -23,6 +23,8 @@
 
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -37,7 +39,7 @@ namespace QuantLib {
       numeraire_(numeraire), alive_(alive),
       displacements_(displacements), oneOverTaus_(taus.size()),
       pseudo_(pseudo), tmp_(taus.size(), 0.0),
-      e_(pseudo_.columns(), pseudo_.rows(), 0.0),
+      e_(pseudo_.rows(), pseudo_.columns(), 0.0),
       downs_(taus.size()), ups_(taus.size()) {
 
         // Check requirements
@@ -129,8 +131,8 @@ namespace QuantLib {
                 (oneOverTaus_[i]+forwards[i]);
 
         // Enforce initialization
-        for (Size r=0; r<numberOfFactors_; ++r)
-            e_[r][std::max(0,static_cast<Integer>(numeraire_)-1)] = 0.0;
+        Size n = std::max(0,static_cast<Integer>(numeraire_)-1);
+        std::fill(e_.row_begin(n), e_.row_end(n), 0.0);
 
         // Now compute drifts: take the numeraire P_N (numeraire_=N)
         // as the reference point, divide the summation into 3 steps,
@@ -140,44 +142,42 @@ namespace QuantLib {
         // (if N=0 no drift is null, if N=numberOfRates_ the last drift is null).
         if (numeraire_>0) drifts[numeraire_-1] = 0.0;
 
+        // The e_ are stored rate by rate, so that the loops over the
+        // factors below run on contiguous memory and can be vectorized
+        // by the compiler; the drifts are summed in the same order
+        // as before.
+
         // 2nd step: then, move backward from N-2 (included) back to
         // alive (included) (if N=0 jumps to 3rd step, if N=numberOfRates_ the
-        // e_[r][N-1] are correctly initialized):
+        // e_[N-1][r] are correctly initialized):
 
         for (Integer i=static_cast<Integer>(numeraire_)-2;
              i>=static_cast<Integer>(alive_); --i) {
-            drifts[i] = 0.0;
-            for (Size r=0; r<numberOfFactors_; ++r) {
-                e_[r][i] = e_[r][i+1] + tmp_[i+1] * pseudo_[i+1][r];
-                drifts[i] -= e_[r][i]*pseudo_[i][r];
-            }
-
-            /*
-            Matrix::column_iterator p1 = e_.column_begin(i);
-            Matrix::column_iterator end = e_.column_end(i);
-            Matrix::const_column_iterator p2 = e_.column_begin(i+1);
-            Matrix::const_row_iterator q1 = pseudo_.row_begin(i);
-            Matrix::const_row_iterator q2 = pseudo_.row_begin(i+1);
             Real x = tmp_[i+1];
-            while (p1 != end) {
-                *p1 = *p2 + x*(*q2);
-                drifts[i] -= *p1*(*q1);
-                ++p1; ++p2; ++q1; ++q2;
-            }
-            */
+            Matrix::const_row_iterator a = pseudo_.row_begin(i+1);
+            Matrix::const_row_iterator eNext = e_.row_begin(i+1);
+            Matrix::row_iterator e = e_.row_begin(i);
+            for (Size r=0; r<numberOfFactors_; ++r)
+                e[r] = eNext[r] + x * a[r];
+            drifts[i] = -std::inner_product(e, e+numberOfFactors_,
+                                            pseudo_.row_begin(i), 0.0);
         }
 
         // 3rd step: now, move forward from N (included) up to n (excluded)
         // (if N=0 this is the only relevant computation):
         for (Size i=numeraire_; i<numberOfRates_; ++i) {
-            drifts[i] = 0.0;
-            for (Size r=0; r<numberOfFactors_; ++r) {
-                if (i==0)
-                    e_[r][i] = tmp_[i] * pseudo_[i][r];
-                else
-                    e_[r][i] = e_[r][i-1] + tmp_[i] * pseudo_[i][r];
-                drifts[i] += e_[r][i]*pseudo_[i][r];
+            Real x = tmp_[i];
+            Matrix::const_row_iterator a = pseudo_.row_begin(i);
+            Matrix::row_iterator e = e_.row_begin(i);
+            if (i==0) {
+                for (Size r=0; r<numberOfFactors_; ++r)
+                    e[r] = x * a[r];
+            } else {
+                Matrix::const_row_iterator ePrev = e_.row_begin(i-1);
+                for (Size r=0; r<numberOfFactors_; ++r)
+                    e[r] = ePrev[r] + x * a[r];
             }
+            drifts[i] = std::inner_product(e, e+numberOfFactors_, a, 0.0);
         }
     }
 
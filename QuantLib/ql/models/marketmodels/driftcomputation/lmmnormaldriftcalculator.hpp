@@ -74,6 +74,7 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
+        // stored by rate, i.e., (i, r), for contiguous access to factors
         mutable Matrix e_;
         std::vector<Size> downs_, ups_;
     };
@@ -56,6 +56,7 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
+        // stored by rate, i.e., (j, k), for contiguous access to factors
         mutable Matrix wkaj_;  // < W(k) | A(j)/P(n) >
         mutable Matrix wkpj_; // < W(k) | P(j)/P(n) >
         mutable Matrix wkajshifted_;
@@ -22,6 +22,8 @@
 #define quantlib_market_model_evolver_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <memory>
 #include <vector>
 
 namespace QuantLib {
@@ -42,6 +44,17 @@ namespace QuantLib {
         virtual Size currentStep() const = 0;
         virtual const CurveState& currentState() const = 0;
         virtual void setInitialState(const CurveState&) = 0;
+        //! skips the given number of paths
+        virtual void skip(Size) {
+            QL_FAIL("skipping paths not supported by this evolver");
+        }
+        /*! returns a copy of the evolver in its current state, with
+            its own copy of the Brownian generator; this allows
+            different threads to evolve different paths.
+        */
+        virtual std::auto_ptr<MarketModelEvolver> clone() const {
+            QL_FAIL("cloning not supported by this evolver");
+        }
     };
 
 }
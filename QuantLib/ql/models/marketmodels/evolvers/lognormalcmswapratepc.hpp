@@ -48,6 +48,8 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skip(Size paths);
+        std::auto_ptr<MarketModelEvolver> clone() const;
         //@}
       private:
         void setCMSwapRates(const std::vector<Real>& swapRates);
@@ -157,4 +157,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalCotSwapRatePc::skip(Size paths) {
+        generator_->skip(paths);
+    }
+
+    std::auto_ptr<MarketModelEvolver> LogNormalCotSwapRatePc::clone() const {
+        std::auto_ptr<LogNormalCotSwapRatePc> evolver(
+                                            new LogNormalCotSwapRatePc(*this));
+        evolver->generator_ =
+            boost::shared_ptr<BrownianGenerator>(generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
 }
@@ -46,6 +46,8 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skip(Size paths);
+        std::auto_ptr<MarketModelEvolver> clone() const;
         //@}
 
         //! accessor methods useful for doing pathwise vegas
@@ -156,4 +156,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalFwdRateiBalland::skip(Size paths) {
+        generator_->skip(paths);
+    }
+
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRateiBalland::clone() const {
+        std::auto_ptr<LogNormalFwdRateiBalland> evolver(
+                                          new LogNormalFwdRateiBalland(*this));
+        evolver->generator_ =
+            boost::shared_ptr<BrownianGenerator>(generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
 }
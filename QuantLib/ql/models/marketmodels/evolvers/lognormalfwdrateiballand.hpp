@@ -45,6 +45,8 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        void skip(Size paths);
+        std::auto_ptr<MarketModelEvolver> clone() const;
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
@@ -151,4 +151,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalFwdRateIpc::skip(Size paths) {
+        generator_->skip(paths);
+    }
+
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRateIpc::clone() const {
+        std::auto_ptr<LogNormalFwdRateIpc> evolver(
+                                               new LogNormalFwdRateIpc(*this));
+        evolver->generator_ =
+            boost::shared_ptr<BrownianGenerator>(generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
 }
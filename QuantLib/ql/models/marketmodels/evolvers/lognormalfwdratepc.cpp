@@ -152,4 +152,16 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalFwdRatePc::skip(Size paths) {
+        generator_->skip(paths);
+    }
+
+    std::auto_ptr<MarketModelEvolver> LogNormalFwdRatePc::clone() const {
+        std::auto_ptr<LogNormalFwdRatePc> evolver(
+                                                new LogNormalFwdRatePc(*this));
+        evolver->generator_ =
+            boost::shared_ptr<BrownianGenerator>(generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
 }
@@ -143,4 +143,15 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void NormalFwdRatePc::skip(Size paths) {
+        generator_->skip(paths);
+    }
+
+    std::auto_ptr<MarketModelEvolver> NormalFwdRatePc::clone() const {
+        std::auto_ptr<NormalFwdRatePc> evolver(new NormalFwdRatePc(*this));
+        evolver->generator_ =
+            boost::shared_ptr<BrownianGenerator>(generator_->clone().release());
+        return std::auto_ptr<MarketModelEvolver>(evolver.release());
+    }
+
 }
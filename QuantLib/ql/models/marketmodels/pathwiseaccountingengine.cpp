@@ -24,22 +24,26 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
     PathwiseAccountingEngine::PathwiseAccountingEngine(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver, // method relies heavily on LMM Euler
         const Clone<MarketModelPathwiseMultiProduct>& product,
         const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
-        Real initialNumeraireValue)
+        Real initialNumeraireValue,
+        Size threads)
         : evolver_(evolver), product_(product),pseudoRootStructure_(pseudoRootStructure),
         initialNumeraireValue_(initialNumeraireValue),
         numberProducts_(product->numberOfProducts()),
+        threads_(threads),
         doDeflation_(!product->alreadyDeflated()),
         numerairesHeld_(product->numberOfProducts()),
         numberCashFlowsThisStep_(product->numberOfProducts()),
         cashFlowsGenerated_(product->numberOfProducts()) ,
         deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
     {
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
 
         numberRates_ = pseudoRootStructure_->numberOfRates();
         numberSteps_ = pseudoRootStructure_->numberOfSteps();
@@ -312,6 +316,11 @@ namespace QuantLib {
     void PathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
         Size numberOfPaths)
     {
+        if (threads_ > 1 && numberOfPaths > 1) {
+            multiplePathValuesInParallel(stats, numberOfPaths);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -320,6 +329,51 @@ namespace QuantLib {
         }
     }
 
+    void PathwiseAccountingEngine::multiplePathValuesInParallel(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        const Size n = numberProducts_*(numberRates_+1);
+        std::vector<Real> values(numberOfPaths*n), weights(numberOfPaths);
+
+        const Size chunks = std::min(threads_, numberOfPaths);
+        std::vector<std::string> errors(chunks);
+
+        #pragma omp parallel for num_threads(threads_) schedule(static,1)
+        for (Size c=0; c<chunks; ++c) {
+            const Size begin = (c*numberOfPaths)/chunks,
+                       end = ((c+1)*numberOfPaths)/chunks;
+            try {
+                boost::shared_ptr<LogNormalFwdRateEuler> evolver(
+                    dynamic_cast<LogNormalFwdRateEuler*>(
+                                               evolver_->clone().release()));
+                QL_REQUIRE(evolver, "unexpected type of cloned evolver");
+                evolver->skip(begin);
+                PathwiseAccountingEngine engine(evolver, product_,
+                                                pseudoRootStructure_,
+                                                initialNumeraireValue_);
+                std::vector<Real> pathValues(n);
+                for (Size j=begin; j<end; ++j) {
+                    weights[j] = engine.singlePathValues(pathValues);
+                    std::copy(pathValues.begin(), pathValues.end(),
+                              values.begin()+j*n);
+                }
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            } catch (...) {
+                errors[c] = "unknown error";
+            }
+        }
+
+        for (Size c=0; c<chunks; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+
+        evolver_->skip(numberOfPaths);
+
+        for (Size j=0; j<numberOfPaths; ++j)
+            stats.add(values.begin()+j*n, values.begin()+(j+1)*n,
+                      weights[j]);
+    }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
  
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
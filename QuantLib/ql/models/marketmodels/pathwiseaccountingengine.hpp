@@ -41,18 +41,24 @@ namespace QuantLib {
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, and requires knowledge of pseudo-roots and displacements 
     // This is tested in MarketModelTest::testPathwiseGreeks
+    // With more than one thread, the paths are split in chunks as in
+    // AccountingEngine; the results don't depend on the number of threads
     class PathwiseAccountingEngine 
     {
       public:
         PathwiseAccountingEngine(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver, // method relies heavily on LMM Euler
                          const Clone<MarketModelPathwiseMultiProduct>& product,
                          const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
-                         Real initialNumeraireValue);
+                         Real initialNumeraireValue,
+                         Size threads = 1);
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        Size threads() const { return threads_; }
       private:
           Real singlePathValues(std::vector<Real>& values);
+          void multiplePathValuesInParallel(SequenceStatisticsInc& stats,
+                                            Size numberOfPaths);
 
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -63,6 +69,7 @@ namespace QuantLib {
         Size numberRates_;
         Size numberCashFlowTimes_;
         Size numberSteps_;
+        Size threads_;
 
         std::vector<Real> currentForwards_, lastForwards_;
 
@@ -22,6 +22,8 @@
 #include <ql/math/optimization/problem.hpp>
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
+#include <ql/pricingengines/portfoliocalculator.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 using std::vector;
 using boost::shared_ptr;
@@ -29,13 +31,43 @@ using boost::shared_ptr;
 namespace QuantLib {
 
     namespace {
+
         void no_deletion(CalibratedModel*) {}
+
+        // calculates the calibration errors of the helpers; errors
+        // are collected, since they can't escape a parallel region.
+        class ErrorCalculation {
+          public:
+            ErrorCalculation(
+                       const vector<shared_ptr<CalibrationHelper> >& helpers,
+                       Array& errors,
+                       vector<std::string>& failures)
+            : helpers_(helpers), errors_(errors), failures_(failures) {}
+            void operator()(Size i) const {
+                try {
+                    errors_[i] = helpers_[i]->calibrationError();
+                } catch (std::exception& e) {
+                    failures_[i] = e.what();
+                    if (failures_[i].empty())
+                        failures_[i] = "unknown error";
+                } catch (...) {
+                    failures_[i] = "unknown error";
+                }
+            }
+          private:
+            const vector<shared_ptr<CalibrationHelper> >& helpers_;
+            Array& errors_;
+            vector<std::string>& failures_;
+        };
+
     }
 
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None),
+      functionEvaluation_(0), gradientEvaluation_(0), calibrationTime_(0.0),
+      calibrationThreads_(1) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -44,15 +76,34 @@ namespace QuantLib {
                             const vector<Real>& weights,
                             const Projection& projection)
         : model_(model, no_deletion), instruments_(h),
-          weights_(weights), projection_(projection) { }
+          weights_(weights), projection_(projection) {
+            if (model->calibrationThreads_ > 1) {
+                // each helper is evaluated together with its engine
+                vector<detail::ParallelCalculation::task_type> tasks(
+                                                                h.size());
+                for (Size i=0; i<h.size(); ++i) {
+                    QL_REQUIRE(h[i], "null calibration helper given");
+                    tasks[i].push_back(h[i]);
+                    shared_ptr<Observer> engine =
+                        boost::dynamic_pointer_cast<Observer>(
+                                                       h[i]->pricingEngine());
+                    if (engine)
+                        tasks[i].push_back(engine);
+                }
+                calculation_ = shared_ptr<detail::ParallelCalculation>(
+                    new detail::ParallelCalculation(
+                                         tasks, model->calibrationThreads_));
+            }
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(projection_.include(params));
+            Array errors = calibrationErrors();
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
             return std::sqrt(value);
@@ -60,10 +111,9 @@ namespace QuantLib {
 
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = calibrationErrors();
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
             return values;
         }
@@ -71,10 +121,29 @@ namespace QuantLib {
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        Disposable<Array> calibrationErrors() const {
+            Array errors(instruments_.size());
+            if (!calculation_) {
+                for (Size i=0; i<instruments_.size(); i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                return errors;
+            }
+
+            vector<std::string> failures(instruments_.size());
+            calculation_->calculateDependencies();
+            calculation_->run(ErrorCalculation(instruments_, errors,
+                                               failures));
+            // the first error is reported, as in sequential evaluation
+            for (Size i=0; i<failures.size(); i++)
+                QL_REQUIRE(failures[i].empty(), failures[i]);
+            return errors;
+        }
+
         shared_ptr<CalibratedModel> model_;
         const vector<shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        shared_ptr<detail::ParallelCalculation> calculation_;
     };
 
     void CalibratedModel::calibrate(
@@ -85,6 +154,9 @@ namespace QuantLib {
                     const vector<Real>& weights,
                     const vector<bool>& fixParameters) {
 
+        const boost::posix_time::ptime start =
+            boost::posix_time::microsec_clock::universal_time();
+
         QL_REQUIRE(weights.empty() || weights.size() == instruments.size(),
                    "mismatch between number of instruments (" <<
                    instruments.size() << ") and weights(" <<
@@ -107,7 +179,12 @@ namespace QuantLib {
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
         Array result(prob.currentValue());
         setParams(proj.include(result));
-        Array shortRateProblemValues_ = prob.values(result);
+        problemValues_ = prob.values(result);
+        functionEvaluation_ = prob.functionEvaluation();
+        gradientEvaluation_ = prob.gradientEvaluation();
+        calibrationTime_ =
+            (boost::posix_time::microsec_clock::universal_time() - start)
+            .total_microseconds() * 1.0e-6;
 
         notifyObservers();
     }
@@ -121,6 +198,11 @@ namespace QuantLib {
         return f.value(params);
     }
 
+    void CalibratedModel::setCalibrationThreads(Size threads) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        calibrationThreads_ = threads;
+    }
+
     Disposable<Array> CalibratedModel::params() const {
         Size size = 0, i;
         for (i=0; i<arguments_.size(); i++)
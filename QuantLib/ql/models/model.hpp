@@ -95,6 +95,21 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If more than one calibration thread is set and the
+            library was compiled with OpenMP support, the calibration
+            errors of the instruments are evaluated in parallel at
+            each evaluation of the cost function, including the ones
+            made for finite-difference Jacobians and gradients.  The
+            lazy objects upon which the instruments depend (e.g.,
+            bootstrapped curves) are calculated beforehand by the
+            calling thread.  Instruments sharing a pricing engine are
+            evaluated by the same thread; each of them should be
+            given its own engine for the calibration to scale.
+
+            \warning the objects used by the instruments must be safe
+                     for concurrent reading once calculated; see
+                     PortfolioCalculator for details.
         */
         virtual void calibrate(
                 const std::vector<boost::shared_ptr<CalibrationHelper> >&,
@@ -109,8 +124,43 @@ namespace QuantLib {
 
         const boost::shared_ptr<Constraint>& constraint() const;
 
+        //! \name Calibration results
+        //@{
         //! Returns end criteria result
         EndCriteria::Type endCriteria() const { return shortRateEndCriteria_; }
+        //! Returns the weighted errors of the instruments after calibration
+        const Array& problemValues() const { return problemValues_; }
+        //! Returns the number of cost-function evaluations
+        Integer functionEvaluation() const { return functionEvaluation_; }
+        //! Returns the number of gradient evaluations
+        Integer gradientEvaluation() const { return gradientEvaluation_; }
+        //! Returns the wall-clock time taken by the calibration in seconds
+        Real calibrationTime() const { return calibrationTime_; }
+        //@}
+
+        //! \name Parallel calibration
+        //@{
+        //! Sets the number of threads used for calibrating the model
+        /*! The calibration helpers are evaluated in parallel.
+            However, helpers sharing a pricing engine or a coupon
+            pricer, whose state is modified during calculation, are
+            evaluated by the same thread.  Helpers are commonly
+            given a single engine; in that case, the calibration is
+            serial regardless of the number of threads.  To run it
+            in parallel, each helper must be given its own engine,
+            e.g.,
+            \code
+            for (Size i=0; i<helpers.size(); ++i)
+                helpers[i]->setPricingEngine(
+                    boost::shared_ptr<PricingEngine>(
+                        new AnalyticHestonEngine(model)));
+            \endcode
+            Engines are not copied automatically, since pricing
+            engines can't be cloned in general.
+        */
+        void setCalibrationThreads(Size threads);
+        Size calibrationThreads() const { return calibrationThreads_; }
+        //@}
 
         //! Returns array of arguments on which calibration is done
         Disposable<Array> params() const;
@@ -122,8 +172,12 @@ namespace QuantLib {
         std::vector<Parameter> arguments_;
         boost::shared_ptr<Constraint> constraint_;
         EndCriteria::Type shortRateEndCriteria_;
+        Array problemValues_;
+        Integer functionEvaluation_, gradientEvaluation_;
+        Real calibrationTime_;
 
       private:
+        Size calibrationThreads_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
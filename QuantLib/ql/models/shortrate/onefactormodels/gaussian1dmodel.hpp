@@ -209,20 +209,27 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
     }
 
     // retrieve underlying swap from cache if possible, otherwise
-    // create it and store it in the cache
+    // create it and store it in the cache.  Access to the cache is
+    // serialized, since models can be used concurrently during a
+    // parallel calibration.
     boost::shared_ptr<VanillaSwap>
     underlyingSwap(const boost::shared_ptr<SwapIndex> &index,
                    const Date &expiry, const Period &tenor) const {
 
         CachedSwapKey k = {index, expiry, tenor};
-        CacheType::iterator i = swapCache_.find(k);
-        if (i == swapCache_.end()) {
-            boost::shared_ptr<VanillaSwap> underlying =
-                index->clone(tenor)->underlyingSwap(expiry);
+        boost::shared_ptr<VanillaSwap> underlying;
+#pragma omp critical(ql_gaussian1d_model_swap_cache)
+        {
+            CacheType::iterator i = swapCache_.find(k);
+            if (i != swapCache_.end())
+                underlying = i->second;
+        }
+        if (!underlying) {
+            underlying = index->clone(tenor)->underlyingSwap(expiry);
+#pragma omp critical(ql_gaussian1d_model_swap_cache)
             swapCache_.insert(std::make_pair(k, underlying));
-            return underlying;
         }
-        return i->second;
+        return underlying;
     }
 
     boost::shared_ptr<StochasticProcess1D> stateProcess_;
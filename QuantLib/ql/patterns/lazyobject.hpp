@@ -25,13 +25,19 @@
 #define quantlib_lazy_object_h
 
 #include <ql/patterns/observable.hpp>
+#if defined(QL_ENABLE_PROFILING)
+#include <ql/utilities/profiling.hpp>
+#endif
 
 namespace QuantLib {
 
+    namespace detail { class ParallelCalculation; }
+
     //! Framework for calculation on demand and result caching.
     /*! \ingroup patterns */
     class LazyObject : public virtual Observable,
                        public virtual Observer {
+        friend class detail::ParallelCalculation;
       public:
         LazyObject();
         virtual ~LazyObject() {}
@@ -147,6 +153,10 @@ namespace QuantLib {
             calculated_ = true;   // prevent infinite recursion in
                                   // case of bootstrapping
             try {
+                #if defined(QL_ENABLE_PROFILING)
+                detail::ProfiledScope profiled(Profiler::Calculation,
+                                               typeid(*this));
+                #endif
                 performCalculations();
             } catch (...) {
                 calculated_ = false;
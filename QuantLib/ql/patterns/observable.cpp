@@ -20,6 +20,9 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 
 #include <ql/patterns/observable.hpp>
+#if defined(QL_ENABLE_PROFILING)
+#include <ql/utilities/profiling.hpp>
+#endif
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
@@ -34,8 +37,15 @@ namespace QuantLib {
             bool successful = true;
             std::string errMsg;
 
+            // the deferred notifications are sent in a single cascade
+            const bool coalesced = updatesCoalesced_;
+            if (coalesced)
+                beginNotification();
+
             for (iterator i=deferredObservers_.begin();
                 i!=deferredObservers_.end(); ++i) {
+                if (coalesced && !markNotified(*i))
+                    continue;
                 try {
                     (*i)->update();
                 } catch (std::exception& e) {
@@ -46,6 +56,8 @@ namespace QuantLib {
                 }
             }
 
+            if (coalesced)
+                endNotification();
             deferredObservers_.clear();
 
             QL_ENSURE(successful,
@@ -61,9 +73,22 @@ namespace QuantLib {
             settings_.registerDeferredObservers(observers_);
         }
         else if (observers_.size()) {
+            #if defined(QL_ENABLE_PROFILING)
+            detail::ProfiledScope profiled(Profiler::Notification,
+                                           typeid(*this));
+            #endif
             bool successful = true;
             std::string errMsg;
+            const bool coalesced = settings_.updatesCoalesced();
+            if (coalesced)
+                settings_.beginNotification();
             for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+                // skip observers already notified in this cascade
+                if (coalesced && !settings_.markNotified(*i))
+                    continue;
+                #if defined(QL_ENABLE_PROFILING)
+                profiled.addObserver(typeid(**i));
+                #endif
                 try {
                     (*i)->update();
                 } catch (std::exception& e) {
@@ -80,6 +105,8 @@ namespace QuantLib {
                     successful = false;
                 }
             }
+            if (coalesced)
+                settings_.endNotification();
             QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
         }
@@ -150,14 +177,32 @@ namespace QuantLib {
                              observerProxy.get()));
     }
 
+    void Observable::sendNotification() {
+        #if defined(QL_ENABLE_PROFILING)
+        detail::ProfiledScope profiled(Profiler::Notification,
+                                       typeid(*this));
+        #endif
+        if (!settings_.updatesCoalesced())
+            return sig_->operator()();
+
+        settings_.beginNotification();
+        try {
+            sig_->operator()();
+        } catch (...) {
+            settings_.endNotification();
+            throw;
+        }
+        settings_.endNotification();
+    }
+
     void Observable::notifyObservers() {
         if (settings_.updatesEnabled()) {
-            return sig_->operator()();
+            return sendNotification();
         }
 
         boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
         if (settings_.updatesEnabled()) {
-            return sig_->operator()();
+            return sendNotification();
         }
         else if (settings_.updatesDeferred()) {
             boost::lock_guard<boost::recursive_mutex> lock(mutex_);
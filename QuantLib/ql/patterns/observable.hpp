@@ -64,20 +64,49 @@ namespace QuantLib {
 
         bool updatesEnabled()  {return updatesEnabled_;}
         bool updatesDeferred() {return updatesDeferred_;}
+
+        /*! When updates are coalesced, each observer receives at
+            most one notification per notification cascade, i.e., per
+            call to notifyObservers() not made from within an update()
+            method, or per call to enableUpdates() sending deferred
+            notifications.  This avoids repeated notifications
+            through diamond-shaped dependencies; in particular,
+            disabling and deferring updates while setting a number of
+            quotes and then re-enabling them sends the notifications
+            in a single pass over the dependency graph.
+
+            \warning This is only correct if the update() method of
+                     the observers involved raises a flag and forwards
+                     the notification without triggering any
+                     calculation, as recommended.
+        */
+        void coalesceUpdates(bool flag = true) {
+            updatesCoalesced_ = flag;
+        }
+        bool updatesCoalesced() {return updatesCoalesced_;}
       private:
         ObservableSettings()
         : updatesEnabled_(true),
-          updatesDeferred_(false) {}
+          updatesDeferred_(false),
+          updatesCoalesced_(false),
+          notificationEpoch_(0), notificationDepth_(0) {}
 
         void registerDeferredObservers(
             const boost::unordered_set<Observer*>& observers);
         void unregisterDeferredObserver(Observer*);
 
+        // coalesced notifications
+        void beginNotification();
+        void endNotification();
+        bool markNotified(Observer*);
+
         typedef boost::unordered_set<Observer*> set_type;
         typedef set_type::iterator iterator;
         set_type deferredObservers_;
 
-        bool updatesEnabled_,  updatesDeferred_;
+        bool updatesEnabled_,  updatesDeferred_, updatesCoalesced_;
+        BigNatural notificationEpoch_;
+        Size notificationDepth_;
     };
 
     //! Object that notifies its changes to a set of observers
@@ -105,6 +134,7 @@ namespace QuantLib {
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer {
+        friend class ObservableSettings;
       public:
 #if BOOST_VERSION < 104700
         typedef std::set<boost::shared_ptr<Observable> > set_type;
@@ -114,7 +144,7 @@ namespace QuantLib {
         typedef set_type::iterator iterator;
 
         // constructors, assignment, destructor
-        Observer() {}
+        Observer() : notificationEpoch_(0) {}
         Observer(const Observer&);
         Observer& operator=(const Observer&);
         virtual ~Observer();
@@ -129,6 +159,8 @@ namespace QuantLib {
         void registerWithObservables(const boost::shared_ptr<Observer>&);
         Size unregisterWith(const boost::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! the observables the instance is registered with
+        const set_type& observables() const { return observables_; }
 
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
@@ -139,6 +171,8 @@ namespace QuantLib {
 
       private:
         set_type observables_;
+        // last notification cascade in which update() was called
+        BigNatural notificationEpoch_;
     };
 
 
@@ -155,6 +189,23 @@ namespace QuantLib {
         deferredObservers_.erase(o);
     }
 
+    inline void ObservableSettings::beginNotification() {
+        // only the outermost notification starts a new cascade
+        if (notificationDepth_++ == 0)
+            ++notificationEpoch_;
+    }
+
+    inline void ObservableSettings::endNotification() {
+        --notificationDepth_;
+    }
+
+    inline bool ObservableSettings::markNotified(Observer* o) {
+        if (o->notificationEpoch_ == notificationEpoch_)
+            return false;
+        o->notificationEpoch_ = notificationEpoch_;
+        return true;
+    }
+
     inline Observable::Observable(const Observable&)
     : settings_(ObservableSettings::instance()) {
         // the observer set is not copied; no observer asked to
@@ -191,7 +242,7 @@ namespace QuantLib {
 
 
     inline Observer::Observer(const Observer& o)
-    : observables_(o.observables_) {
+    : observables_(o.observables_), notificationEpoch_(0) {
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->registerObserver(this);
     }
@@ -250,6 +301,7 @@ namespace QuantLib {
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/tss.hpp>
 #include <boost/smart_ptr/owner_less.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <set>
@@ -282,6 +334,8 @@ namespace QuantLib {
         void registerWithObservables(const boost::shared_ptr<Observer>&);
         Size unregisterWith(const boost::shared_ptr<Observable>&);
         void unregisterWithAll();
+        //! the observables the instance is registered with
+        set_type observables() const;
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
             instead, it will be called by the observables the instance
@@ -292,26 +346,9 @@ namespace QuantLib {
 
         class Proxy {
           public:
-            Proxy(Observer* const observer)
-             : active_  (true),
-               observer_(observer) {
-            }
+            Proxy(Observer* const observer);
 
-            void update() const {
-                boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-                if (active_) {
-                    const boost::weak_ptr<Observer> o
-                        = observer_->weak_from_this();
-                    if (!o._empty()) {
-                        const boost::shared_ptr<Observer> obs(o.lock());
-                        if (obs)
-                            obs->update();
-                    }
-                    else {
-                        observer_->update();
-                    }
-                }
-            }
+            void update() const;
 
             void deactivate() {
                 boost::lock_guard<boost::recursive_mutex> lock(mutex_);
@@ -322,6 +359,9 @@ namespace QuantLib {
             bool active_;
             mutable boost::recursive_mutex mutex_;
             Observer* const observer_;
+            ObservableSettings& settings_;
+            // last notification cascade in which update() was called
+            mutable boost::atomic<BigNatural> notificationEpoch_;
         };
 
         boost::shared_ptr<Proxy> proxy_;
@@ -355,6 +395,7 @@ namespace QuantLib {
       private:
         void registerObserver(const boost::shared_ptr<Observer::Proxy>&);
         void unregisterObserver(const boost::shared_ptr<Observer::Proxy>&);
+        void sendNotification();
 
         boost::shared_ptr<detail::Signal> sig_;
 
@@ -378,8 +419,35 @@ namespace QuantLib {
 
         bool updatesEnabled()  {return (updatesType_ & UpdatesEnabled) != 0; }
         bool updatesDeferred() {return (updatesType_ & UpdatesDeferred) != 0; }
+
+        /*! When updates are coalesced, each observer receives at
+            most one notification per notification cascade, i.e., per
+            call to notifyObservers() not made from within an update()
+            method, or per call to enableUpdates() sending deferred
+            notifications.  This avoids repeated notifications
+            through diamond-shaped dependencies; in particular,
+            disabling and deferring updates while setting a number of
+            quotes and then re-enabling them sends the notifications
+            in a single pass over the dependency graph.  Observers
+            already notified are skipped without locking.
+
+            Cascades are tracked separately for each thread.
+
+            \warning This is only correct if the update() method of
+                     the observers involved raises a flag and forwards
+                     the notification without triggering any
+                     calculation, as recommended.
+        */
+        void coalesceUpdates(bool flag = true) {
+            updatesCoalesced_ = flag;
+        }
+        bool updatesCoalesced() {return updatesCoalesced_; }
       private:
-        ObservableSettings() : updatesType_(UpdatesEnabled) {}
+        ObservableSettings()
+        : updatesType_(UpdatesEnabled), updatesCoalesced_(false),
+          notificationEpoch_(0) {}
+
+        friend class Observer::Proxy;
 
         typedef std::set<boost::weak_ptr<Observer::Proxy>,
                          boost::owner_less<boost::weak_ptr<Observer::Proxy> > >
@@ -390,11 +458,25 @@ namespace QuantLib {
         void unregisterDeferredObserver(
             const boost::shared_ptr<Observer::Proxy>& proxy);
 
+        // coalesced notifications
+        void beginNotification();
+        void endNotification();
+        BigNatural notificationEpoch() const;
+
+        struct Cascade {
+            Cascade() : epoch(0), depth(0) {}
+            BigNatural epoch;
+            Size depth;
+        };
+
         set_type deferredObservers_;
         mutable boost::mutex mutex_;
 
         enum UpdateType { UpdatesEnabled = 1, UpdatesDeferred = 2} ;
         boost::atomic<int> updatesType_;
+        boost::atomic<bool> updatesCoalesced_;
+        boost::atomic<BigNatural> notificationEpoch_;
+        boost::thread_specific_ptr<Cascade> cascade_;
     };
 
 
@@ -410,6 +492,26 @@ namespace QuantLib {
         deferredObservers_.erase(o);
     }
 
+    inline void ObservableSettings::beginNotification() {
+        Cascade* cascade = cascade_.get();
+        if (!cascade) {
+            cascade = new Cascade;
+            cascade_.reset(cascade);
+        }
+        // only the outermost notification starts a new cascade
+        if (cascade->depth++ == 0)
+            cascade->epoch = ++notificationEpoch_;
+    }
+
+    inline void ObservableSettings::endNotification() {
+        --(cascade_->depth);
+    }
+
+    inline BigNatural ObservableSettings::notificationEpoch() const {
+        const Cascade* cascade = cascade_.get();
+        return (cascade && cascade->depth > 0) ? cascade->epoch : 0;
+    }
+
     inline void ObservableSettings::enableUpdates() {
         boost::lock_guard<boost::mutex> lock(mutex_);
 
@@ -420,6 +522,11 @@ namespace QuantLib {
             bool successful = true;
             std::string errMsg;
 
+            // the deferred notifications are sent in a single cascade
+            const bool coalesced = updatesCoalesced_;
+            if (coalesced)
+                beginNotification();
+
             for (iterator i=deferredObservers_.begin();
                 i!=deferredObservers_.end(); ++i) {
                 try {
@@ -434,6 +541,8 @@ namespace QuantLib {
                 }
             }
 
+            if (coalesced)
+                endNotification();
             deferredObservers_.clear();
 
             QL_ENSURE(successful,
@@ -442,6 +551,37 @@ namespace QuantLib {
     }
 
 
+    inline Observer::Proxy::Proxy(Observer* const observer)
+    : active_  (true),
+      observer_(observer),
+      settings_(ObservableSettings::instance()),
+      notificationEpoch_(0) {
+    }
+
+    inline void Observer::Proxy::update() const {
+        if (settings_.updatesCoalesced()) {
+            // skip observers already notified in this cascade
+            // before contending for the lock
+            const BigNatural epoch = settings_.notificationEpoch();
+            if (epoch != 0 && notificationEpoch_.exchange(epoch) == epoch)
+                return;
+        }
+
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        if (active_) {
+            const boost::weak_ptr<Observer> o
+                = observer_->weak_from_this();
+            if (!o._empty()) {
+                const boost::shared_ptr<Observer> obs(o.lock());
+                if (obs)
+                    obs->update();
+            }
+            else {
+                observer_->update();
+            }
+        }
+    }
+
     /*! \warning notification is sent before the copy constructor has
              a chance of actually change the data
              members. Therefore, observers whose update() method
@@ -544,6 +684,11 @@ namespace QuantLib {
 
         observables_.clear();
     }
+
+    inline Observer::set_type Observer::observables() const {
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        return observables_;
+    }
 }
 #endif
 #endif
@@ -132,6 +132,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticASEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCDiscreteArithmeticASEngine& withMaxSamples(Size samples);
         MakeMCDiscreteArithmeticASEngine& withSeed(BigNatural seed);
+        MakeMCDiscreteArithmeticASEngine& withThreads(Size threads);
         MakeMCDiscreteArithmeticASEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -142,6 +143,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     template <class RNG, class S>
@@ -150,7 +152,7 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
@@ -188,6 +190,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
+    MakeMCDiscreteArithmeticASEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
     MakeMCDiscreteArithmeticASEngine<RNG,S>::withBrownianBridge(bool b) {
@@ -206,13 +215,15 @@ namespace QuantLib {
     inline
     MakeMCDiscreteArithmeticASEngine<RNG,S>::
     operator boost::shared_ptr<PricingEngine>() const {
-        return boost::shared_ptr<PricingEngine>(
+        boost::shared_ptr<MCDiscreteArithmeticASEngine<RNG,S> > engine(
             new MCDiscreteArithmeticASEngine<RNG,S>(process_,
                                                     brownianBridge_,
                                                     antithetic_,
                                                     samples_, tolerance_,
                                                     maxSamples_,
                                                     seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
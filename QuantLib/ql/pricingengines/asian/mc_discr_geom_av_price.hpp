@@ -143,6 +143,7 @@ namespace QuantLib {
         MakeMCDiscreteGeometricAPEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCDiscreteGeometricAPEngine& withMaxSamples(Size samples);
         MakeMCDiscreteGeometricAPEngine& withSeed(BigNatural seed);
+        MakeMCDiscreteGeometricAPEngine& withThreads(Size threads);
         MakeMCDiscreteGeometricAPEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -153,6 +154,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     template <class RNG, class S>
@@ -161,7 +163,7 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
@@ -199,6 +201,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
+    MakeMCDiscreteGeometricAPEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
     MakeMCDiscreteGeometricAPEngine<RNG,S>::withBrownianBridge(bool b) {
@@ -217,13 +226,15 @@ namespace QuantLib {
     inline
     MakeMCDiscreteGeometricAPEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
                                                                       const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCDiscreteGeometricAPEngine<RNG,S> > engine(new
             MCDiscreteGeometricAPEngine<RNG,S>(process_,
                                                brownianBridge_,
                                                antithetic_,
                                                samples_, tolerance_,
                                                maxSamples_,
                                                seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
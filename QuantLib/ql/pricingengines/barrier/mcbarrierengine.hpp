@@ -126,6 +126,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +135,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -278,7 +280,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -350,6 +352,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -358,7 +367,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCBarrierEngine<RNG,S> > engine(new
             MCBarrierEngine<RNG,S>(process_,
                                    steps_,
                                    stepsPerYear_,
@@ -368,6 +377,8 @@ namespace QuantLib {
                                    maxSamples_,
                                    biased_,
                                    seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
@@ -79,6 +79,7 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCAmericanBasketEngine& withMaxSamples(Size samples);
         MakeMCAmericanBasketEngine& withSeed(BigNatural seed);
+        MakeMCAmericanBasketEngine& withThreads(Size threads);
         MakeMCAmericanBasketEngine& withCalibrationSamples(Size samples);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -88,6 +89,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -181,7 +183,7 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       calibrationSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG>
     inline MakeMCAmericanBasketEngine<RNG>&
@@ -246,6 +248,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG>
     inline MakeMCAmericanBasketEngine<RNG>&
     MakeMCAmericanBasketEngine<RNG>::withCalibrationSamples(Size samples) {
@@ -261,7 +270,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCAmericanBasketEngine<RNG> > engine(new
             MCAmericanBasketEngine<RNG>(process_,
                                         steps_,
                                         stepsPerYear_,
@@ -272,6 +281,8 @@ namespace QuantLib {
                                         maxSamples_,
                                         seed_,
                                         calibrationSamples_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
@@ -115,6 +115,7 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanBasketEngine& withMaxSamples(Size samples);
         MakeMCEuropeanBasketEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanBasketEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -123,6 +124,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -214,7 +216,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>&
@@ -279,6 +281,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanBasketEngine<RNG,S>::operator
@@ -287,7 +296,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCEuropeanBasketEngine<RNG,S> > engine(new
             MCEuropeanBasketEngine<RNG,S>(process_,
                                           steps_,
                                           stepsPerYear_,
@@ -296,6 +305,8 @@ namespace QuantLib {
                                           samples_, tolerance_,
                                           maxSamples_,
                                           seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
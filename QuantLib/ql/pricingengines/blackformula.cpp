@@ -52,6 +52,15 @@ namespace {
                                                      << displacement
                                                      << ") must be positive");
     }
+
+    void checkSize(QuantLib::Size size,
+                   QuantLib::Size expected,
+                   const char* name)
+    {
+        QL_REQUIRE(size == expected, "wrong number of " << name << " ("
+                                         << size << ", " << expected
+                                         << " required)");
+    }
 }
 
 namespace QuantLib {
@@ -585,4 +594,197 @@ namespace QuantLib {
     }
 
 
+
+    std::vector<Real> blackFormula(
+                               const std::vector<Option::Type>& optionTypes,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               Real displacement) {
+        const Size n = optionTypes.size();
+        checkSize(strikes.size(), n, "strikes");
+        checkSize(forwards.size(), n, "forwards");
+        checkSize(stdDevs.size(), n, "standard deviations");
+        checkSize(discounts.size(), n, "discounts");
+
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i)
+            results[i] = blackFormula(optionTypes[i], strikes[i], forwards[i],
+                                      stdDevs[i], discounts[i], displacement);
+        return results;
+    }
+
+    std::vector<Real> blackFormulaStdDevDerivative(
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts,
+                                       Real displacement) {
+        const Size n = strikes.size();
+        checkSize(forwards.size(), n, "forwards");
+        checkSize(stdDevs.size(), n, "standard deviations");
+        checkSize(discounts.size(), n, "discounts");
+
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i)
+            results[i] = blackFormulaStdDevDerivative(strikes[i], forwards[i],
+                                                      stdDevs[i], discounts[i],
+                                                      displacement);
+        return results;
+    }
+
+    std::vector<Real> bachelierBlackFormula(
+                               const std::vector<Option::Type>& optionTypes,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts) {
+        const Size n = optionTypes.size();
+        checkSize(strikes.size(), n, "strikes");
+        checkSize(forwards.size(), n, "forwards");
+        checkSize(stdDevs.size(), n, "standard deviations");
+        checkSize(discounts.size(), n, "discounts");
+
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i)
+            results[i] = bachelierBlackFormula(optionTypes[i], strikes[i],
+                                               forwards[i], stdDevs[i],
+                                               discounts[i]);
+        return results;
+    }
+
+    std::vector<Real> bachelierBlackFormulaStdDevDerivative(
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts) {
+        const Size n = strikes.size();
+        checkSize(forwards.size(), n, "forwards");
+        checkSize(stdDevs.size(), n, "standard deviations");
+        checkSize(discounts.size(), n, "discounts");
+
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i)
+            results[i] = bachelierBlackFormulaStdDevDerivative(
+                         strikes[i], forwards[i], stdDevs[i], discounts[i]);
+        return results;
+    }
+
+    namespace {
+
+        /* Halley iterations on the undiscounted price of an
+           out-of-the-money option, with strike and forward already
+           displaced; they use the second derivative of the price
+           with respect to the standard deviation, i.e., vega times
+           d1*d2/stdDev.  Null<Real>() is returned if they don't
+           converge within the given number of steps. */
+        Real halleyImpliedStdDev(Option::Type optionType,
+                                 Real strike,
+                                 Real forward,
+                                 Real undiscountedPrice,
+                                 Real guess,
+                                 Real accuracy,
+                                 Size maxSteps,
+                                 const CumulativeNormalDistribution& N) {
+            const Real maxStdDev = 24.0; // as in the scalar version
+            if (!(guess > 0.0 && guess < maxStdDev))
+                return Null<Real>();
+
+            const Real moneyness = std::log(forward/strike);
+            Real stdDev = guess;
+            for (Size k=0; k<maxSteps; ++k) {
+                const Real d1 = moneyness/stdDev + 0.5*stdDev;
+                const Real d2 = d1 - stdDev;
+                const Real vega = forward*N.derivative(d1);
+                if (!(vega > 0.0))
+                    return Null<Real>();
+                const Real f = optionType*(forward*N(optionType*d1)
+                                           - strike*N(optionType*d2))
+                    - undiscountedPrice;
+                const Real newtonStep = f/vega;
+                // fall back to Newton if the correction is too large
+                const Real c = 1.0 - 0.5*newtonStep*d1*d2/stdDev;
+                Real next = stdDev - (c > 0.5 ? newtonStep/c : newtonStep);
+                if (next <= 0.0)
+                    next = 0.5*stdDev;
+                else if (next >= maxStdDev)
+                    next = 0.5*(stdDev+maxStdDev);
+                if (std::fabs(next-stdDev) < accuracy)
+                    return next;
+                stdDev = next;
+            }
+            return Null<Real>();
+        }
+
+    }
+
+    std::vector<Real> blackFormulaImpliedStdDev(
+                               const std::vector<Option::Type>& optionTypes,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& blackPrices,
+                               const std::vector<Real>& discounts,
+                               Real displacement,
+                               Real accuracy,
+                               Natural maxIterations) {
+        const Size n = optionTypes.size();
+        checkSize(strikes.size(), n, "strikes");
+        checkSize(forwards.size(), n, "forwards");
+        checkSize(blackPrices.size(), n, "prices");
+        checkSize(discounts.size(), n, "discounts");
+
+        // Halley's method converges in two or three steps from the
+        // initial guess in all but pathological cases
+        const Size maxHalleySteps = 8;
+
+        CumulativeNormalDistribution N;
+        std::vector<Real> results(n);
+        for (Size i=0; i<n; ++i) {
+            Option::Type optionType = optionTypes[i];
+            const Real strike = strikes[i], forward = forwards[i];
+            const Real discount = discounts[i];
+            Real blackPrice = blackPrices[i];
+
+            checkParameters(strike, forward, displacement);
+            QL_REQUIRE(discount>0.0,
+                       "discount (" << discount << ") must be positive");
+            QL_REQUIRE(blackPrice>=0.0,
+                       "option price (" << blackPrice
+                       << ") must be non-negative");
+            Real otherOptionPrice =
+                blackPrice - optionType*(forward-strike)*discount;
+            QL_REQUIRE(otherOptionPrice>=0.0,
+                       "negative " << Option::Type(-1*optionType) <<
+                       " price (" << otherOptionPrice <<
+                       ") implied by put-call parity. No solution exists for " <<
+                       optionType << " strike " << strike <<
+                       ", forward " << forward <<
+                       ", price " << blackPrice <<
+                       ", deflator " << discount);
+
+            // as in the scalar version, solve for the out-of-the-money
+            // option
+            if ((optionType==Option::Put && strike>forward) ||
+                (optionType==Option::Call && strike<forward)) {
+                optionType = Option::Type(-1*optionType);
+                blackPrice = otherOptionPrice;
+            }
+
+            Real guess = blackFormulaImpliedStdDevApproximation(
+                optionType, strike, forward, blackPrice, discount, displacement);
+            results[i] = halleyImpliedStdDev(optionType,
+                                             strike + displacement,
+                                             forward + displacement,
+                                             blackPrice/discount, guess,
+                                             accuracy, maxHalleySteps, N);
+            if (results[i] == Null<Real>())
+                results[i] = blackFormulaImpliedStdDev(
+                    optionTypes[i], strike, forward, blackPrices[i], discount,
+                    displacement, Null<Real>(), accuracy, maxIterations);
+        }
+        return results;
+    }
+
+
 }
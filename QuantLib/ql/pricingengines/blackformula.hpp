@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -57,6 +58,22 @@ namespace QuantLib {
                       Real discount = 1.0,
                       Real displacement = 0.0);
 
+    /*! Black 1976 formula for a set of options; the i-th result
+        equals blackFormula(optionTypes[i], strikes[i], forwards[i],
+        stdDevs[i], discounts[i], displacement).  All the arrays
+        must have the same size.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    std::vector<Real> blackFormula(
+                               const std::vector<Option::Type>& optionTypes,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               Real displacement = 0.0);
+
 
     /*! Approximated Black 1976 implied standard deviation,
         i.e. volatility*sqrt(timeToMaturity).
@@ -144,6 +161,27 @@ namespace QuantLib {
                         Real accuracy = 1.0e-6,
                         Natural maxIterations = 100);
 
+    /*! Black 1976 implied standard deviations for a set of options,
+        i.e. volatility*sqrt(timeToMaturity).  All the arrays must
+        have the same size.
+
+        Starting from the approximation by Corrado and Miller, each
+        standard deviation is refined by a few Halley steps, which
+        usually reach the required accuracy in two or three
+        iterations; when they don't, the result is obtained as in
+        the scalar version.  The results are the same as those of
+        the scalar version within the given accuracy.
+    */
+    std::vector<Real> blackFormulaImpliedStdDev(
+                               const std::vector<Option::Type>& optionTypes,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& blackPrices,
+                               const std::vector<Real>& discounts,
+                               Real displacement = 0.0,
+                               Real accuracy = 1.0e-6,
+                               Natural maxIterations = 100);
+
 
     /*! Black 1976 probability of being in the money (in the bond martingale
         measure), i.e. N(d2).
@@ -207,6 +245,20 @@ namespace QuantLib {
                         Real discount = 1.0,
                         Real displacement = 0.0);
 
+    /*! Black 1976 formula for standard deviation derivative for a
+        set of options.  All the arrays must have the same size.
+
+        \warning instead of volatility it uses standard deviation, i.e.
+                 volatility*sqrt(timeToMaturity), and it returns the
+                 derivative with respect to the standard deviation.
+    */
+    std::vector<Real> blackFormulaStdDevDerivative(
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts,
+                                       Real displacement = 0.0);
+
     /*! Black 1976 formula for second derivative by standard deviation
         \warning instead of volatility it uses standard deviation, i.e.
                  volatility*sqrt(timeToMaturity), and it returns the
@@ -255,6 +307,23 @@ namespace QuantLib {
                         Real forward,
                         Real stdDev,
                         Real discount = 1.0);
+
+    /*! Bachelier formula for a set of options; the i-th result
+        equals bachelierBlackFormula(optionTypes[i], strikes[i],
+        forwards[i], stdDevs[i], discounts[i]).  All the arrays must
+        have the same size.
+
+        \warning Bachelier model needs absolute volatility, not
+                 percentage volatility. Standard deviation is
+                 absoluteVolatility*sqrt(timeToMaturity)
+    */
+    std::vector<Real> bachelierBlackFormula(
+                               const std::vector<Option::Type>& optionTypes,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts);
+
     /*! Approximated Bachelier implied volatility
 
         It is calculated using  the analytic implied volatility approximation
@@ -287,6 +356,15 @@ namespace QuantLib {
                                                 Real stdDev,
                                                 Real discount = 1.0);
 
+    /*! Bachelier formula for standard deviation derivative for a
+        set of options.  All the arrays must have the same size.
+    */
+    std::vector<Real> bachelierBlackFormulaStdDevDerivative(
+                                       const std::vector<Real>& strikes,
+                                       const std::vector<Real>& forwards,
+                                       const std::vector<Real>& stdDevs,
+                                       const std::vector<Real>& discounts);
+
 }
 
 #endif
@@ -162,6 +162,7 @@ namespace QuantLib {
         MakeMCHullWhiteCapFloorEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCHullWhiteCapFloorEngine& withMaxSamples(Size samples);
         MakeMCHullWhiteCapFloorEngine& withSeed(BigNatural seed);
+        MakeMCHullWhiteCapFloorEngine& withThreads(Size threads);
         MakeMCHullWhiteCapFloorEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -172,6 +173,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -183,7 +185,7 @@ namespace QuantLib {
                                     const boost::shared_ptr<HullWhite>& model)
     : model_(model), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCHullWhiteCapFloorEngine<RNG,S>&
@@ -221,6 +223,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCHullWhiteCapFloorEngine<RNG,S>&
+    MakeMCHullWhiteCapFloorEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCHullWhiteCapFloorEngine<RNG,S>&
     MakeMCHullWhiteCapFloorEngine<RNG,S>::withBrownianBridge(bool b) {
@@ -238,11 +247,13 @@ namespace QuantLib {
     template <class RNG, class S>
     inline MakeMCHullWhiteCapFloorEngine<RNG,S>::
     operator boost::shared_ptr<PricingEngine>() const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCHullWhiteCapFloorEngine<RNG,S> > engine(new
             MCHullWhiteCapFloorEngine<RNG,S>(model_,
                                              brownianBridge_, antithetic_,
                                              samples_, tolerance_,
                                              maxSamples_, seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
@@ -92,6 +92,7 @@ namespace QuantLib {
         MakeMCPerformanceEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCPerformanceEngine& withMaxSamples(Size samples);
         MakeMCPerformanceEngine& withSeed(BigNatural seed);
+        MakeMCPerformanceEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -100,6 +101,7 @@ namespace QuantLib {
         Size samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -186,7 +188,7 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), brownianBridge_(false), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCPerformanceEngine<RNG,S>&
@@ -237,11 +239,18 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCPerformanceEngine<RNG,S>&
+    MakeMCPerformanceEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCPerformanceEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
                                                                       const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCPerformanceEngine<RNG,S> > engine(new
             MCPerformanceEngine<RNG,S>(process_,
                                        brownianBridge_,
                                        antithetic_,
@@ -249,6 +258,8 @@ namespace QuantLib {
                                        tolerance_,
                                        maxSamples_,
                                        seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
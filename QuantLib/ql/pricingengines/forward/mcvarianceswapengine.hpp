@@ -139,6 +139,7 @@ namespace QuantLib {
         MakeMCVarianceSwapEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCVarianceSwapEngine& withMaxSamples(Size samples);
         MakeMCVarianceSwapEngine& withSeed(BigNatural seed);
+        MakeMCVarianceSwapEngine& withThreads(Size threads);
         MakeMCVarianceSwapEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -149,6 +150,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     class VariancePathPricer : public PathPricer<Path> {
@@ -230,7 +232,7 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCVarianceSwapEngine<RNG,S>&
@@ -281,6 +283,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCVarianceSwapEngine<RNG,S>&
+    MakeMCVarianceSwapEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCVarianceSwapEngine<RNG,S>&
     MakeMCVarianceSwapEngine<RNG,S>::withBrownianBridge(bool brownianBridge) {
@@ -302,7 +311,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(
+        boost::shared_ptr<MCVarianceSwapEngine<RNG,S> > engine(
                          new MCVarianceSwapEngine<RNG,S>(process_,
                                                          steps_,
                                                          stepsPerYear_,
@@ -311,6 +320,8 @@ namespace QuantLib {
                                                          samples_, tolerance_,
                                                          maxSamples_,
                                                          seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 
@@ -40,6 +40,10 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        The number of threads set with McSimulation::setThreads is
+        used both for the pricing samples and for the calibration of
+        the path pricer; see LongstaffSchwartzPathPricer.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -150,6 +154,9 @@ namespace QuantLib {
     inline
     void MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::calculate() const {
         pathPricer_ = this->lsmPathPricer();
+        pathPricer_->setThreads(this->threads_);
+        // the calibration paths are stored by the path pricer, so
+        // they're drawn by a single thread
         this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                           new MonteCarloModel<MC,RNG,S>
                               (pathGenerator(), pathPricer_,
@@ -65,11 +65,20 @@ namespace QuantLib {
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
                        Size maxSamples) const;
+        //! sets the number of threads used for simulating samples
+        /*! \warning the path pricer and the stochastic process must
+                     be safe to call concurrently; see MonteCarloModel.
+        */
+        void setThreads(Size threads) {
+            QL_REQUIRE(threads > 0, "at least one thread required");
+            threads_ = threads;
+        }
+        Size threads() const { return threads_; }
       protected:
         McSimulation(bool antitheticVariate,
                      bool controlVariate)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), threads_(1) {}
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -97,6 +106,7 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_;
     };
 
 
@@ -186,13 +196,17 @@ namespace QuantLib {
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue, controlPG, threads_));
         } else {
             this->mcModel_ =
                 boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+                           this->antitheticVariate_,
+                           boost::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           boost::shared_ptr<path_generator_type>(),
+                           threads_));
         }
 
         if (requiredTolerance != Null<Real>()) {
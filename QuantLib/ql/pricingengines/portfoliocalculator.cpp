@@ -0,0 +1,285 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/portfoliocalculator.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/inflationcouponpricer.hpp>
+#include <ql/settings.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef boost::unordered_set<const Observable*> visited_set;
+
+        // depth-first visit of the graph below the given observer;
+        // lazy objects are added after their own dependencies.
+        void collectDependencies(
+                        const Observer& observer,
+                        visited_set& visited,
+                        std::vector<boost::shared_ptr<LazyObject> >& result) {
+            const Observer::set_type& observables = observer.observables();
+            for (Observer::iterator i = observables.begin();
+                 i != observables.end(); ++i) {
+                if (!visited.insert(i->get()).second)
+                    continue;
+                boost::shared_ptr<Observer> next =
+                    boost::dynamic_pointer_cast<Observer>(*i);
+                if (next)
+                    collectDependencies(*next, visited, result);
+                boost::shared_ptr<LazyObject> lazy =
+                    boost::dynamic_pointer_cast<LazyObject>(*i);
+                if (lazy)
+                    result.push_back(lazy);
+            }
+        }
+
+        bool isStateful(const Observable* o) {
+            return dynamic_cast<const PricingEngine*>(o) != 0
+                || dynamic_cast<const FloatingRateCouponPricer*>(o) != 0
+                || dynamic_cast<const InflationCouponPricer*>(o) != 0;
+        }
+
+        // collects the objects below the given observer whose state
+        // changes during calculations.  Lazy objects are not
+        // visited, since they are calculated beforehand.
+        void collectStatefulObjects(const Observer& observer,
+                                    visited_set& visited,
+                                    std::vector<const Observable*>& result) {
+            const Observer::set_type& observables = observer.observables();
+            for (Observer::iterator i = observables.begin();
+                 i != observables.end(); ++i) {
+                const Observable* o = i->get();
+                if (!visited.insert(o).second)
+                    continue;
+                if (isStateful(o))
+                    result.push_back(o);
+                if (dynamic_cast<const LazyObject*>(o) != 0)
+                    continue;
+                boost::shared_ptr<Observer> next =
+                    boost::dynamic_pointer_cast<Observer>(*i);
+                if (next)
+                    collectStatefulObjects(*next, visited, result);
+            }
+        }
+
+        // whether any of the given objects is found below the observer
+        bool dependsOn(const Observer& observer,
+                       const visited_set& targets,
+                       visited_set& visited) {
+            const Observer::set_type& observables = observer.observables();
+            for (Observer::iterator i = observables.begin();
+                 i != observables.end(); ++i) {
+                const Observable* o = i->get();
+                if (!visited.insert(o).second)
+                    continue;
+                if (targets.find(o) != targets.end())
+                    return true;
+                boost::shared_ptr<Observer> next =
+                    boost::dynamic_pointer_cast<Observer>(*i);
+                if (next && dependsOn(*next, targets, visited))
+                    return true;
+            }
+            return false;
+        }
+
+        Size findRoot(std::vector<Size>& parent, Size i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+
+    }
+
+    namespace detail {
+
+        ParallelCalculation::ParallelCalculation(
+                                           const std::vector<task_type>& tasks,
+                                           Size threads)
+        : threads_(threads), tasks_(tasks) {
+            QL_REQUIRE(threads_ > 0, "at least one thread required");
+
+            visited_set visited;
+            for (Size i=0; i<tasks.size(); ++i) {
+                for (Size k=0; k<tasks[i].size(); ++k) {
+                    QL_REQUIRE(tasks[i][k], "null observer given");
+                    collectDependencies(*tasks[i][k], visited,
+                                        dependencies_);
+                }
+            }
+
+            // tasks sharing stateful objects are grouped together
+            const Size n = tasks.size();
+            std::vector<Size> parent(n);
+            for (Size i=0; i<n; ++i)
+                parent[i] = i;
+            boost::unordered_map<const Observable*, Size> owners;
+            for (Size i=0; i<n; ++i) {
+                std::vector<const Observable*> stateful;
+                visited_set visited;
+                for (Size k=0; k<tasks[i].size(); ++k) {
+                    const Observable* root =
+                        dynamic_cast<const Observable*>(tasks[i][k].get());
+                    if (root != 0 && visited.insert(root).second
+                        && isStateful(root))
+                        stateful.push_back(root);
+                    collectStatefulObjects(*tasks[i][k], visited, stateful);
+                }
+                for (Size j=0; j<stateful.size(); ++j) {
+                    std::pair<boost::unordered_map<const Observable*,
+                                                   Size>::iterator,
+                              bool> k =
+                        owners.insert(std::make_pair(stateful[j], i));
+                    if (!k.second)
+                        parent[findRoot(parent, i)] =
+                            findRoot(parent, k.first->second);
+                }
+            }
+
+            std::vector<Size> groupIndex(n, Null<Size>());
+            for (Size i=0; i<n; ++i) {
+                Size root = findRoot(parent, i);
+                if (groupIndex[root] == Null<Size>()) {
+                    groupIndex[root] = groups_.size();
+                    groups_.push_back(std::vector<Size>());
+                }
+                groups_[groupIndex[root]].push_back(i);
+            }
+            serial_.resize(groups_.size(), false);
+        }
+
+        void ParallelCalculation::calculateDependencies() const {
+            visited_set failed;
+            for (Size i=0; i<dependencies_.size(); ++i) {
+                try {
+                    dependencies_[i]->calculate();
+                } catch (...) {
+                    // raised again when the results are requested
+                    failed.insert(dependencies_[i].get());
+                }
+            }
+
+            // the tasks using a failed object would calculate it
+            // again, which can't be done concurrently
+            serial_.assign(groups_.size(), false);
+            if (failed.empty())
+                return;
+            for (Size g=0; g<groups_.size(); ++g) {
+                visited_set visited;
+                for (Size j=0; j<groups_[g].size() && !serial_[g]; ++j) {
+                    const task_type& task = tasks_[groups_[g][j]];
+                    for (Size k=0; k<task.size() && !serial_[g]; ++k) {
+                        const Observable* root =
+                            dynamic_cast<const Observable*>(task[k].get());
+                        serial_[g] =
+                            (root != 0 && failed.find(root) != failed.end())
+                            || dependsOn(*task[k], failed, visited);
+                    }
+                }
+            }
+        }
+
+        ParallelCalculation::SessionSettings::SessionSettings() {
+            #if defined(QL_ENABLE_SESSIONS)
+            const Settings& settings = Settings::instance();
+            evaluationDate_ = settings.evaluationDate();
+            includeReferenceDateEvents_ =
+                settings.includeReferenceDateEvents();
+            includeTodaysCashFlows_ = settings.includeTodaysCashFlows();
+            enforcesTodaysHistoricFixings_ =
+                settings.enforcesTodaysHistoricFixings();
+            #endif
+        }
+
+        void ParallelCalculation::SessionSettings::apply() const {
+            #if defined(QL_ENABLE_SESSIONS)
+            // singletons are created on first access, which is not
+            // thread-safe; hence the critical section
+            #pragma omp critical(ql_parallel_calculation_sessions)
+            {
+                Settings& local = Settings::instance();
+                if (Date(local.evaluationDate()) != evaluationDate_)
+                    local.evaluationDate() = evaluationDate_;
+                local.includeReferenceDateEvents() =
+                    includeReferenceDateEvents_;
+                local.includeTodaysCashFlows() = includeTodaysCashFlows_;
+                local.enforcesTodaysHistoricFixings() =
+                    enforcesTodaysHistoricFixings_;
+            }
+            #endif
+        }
+
+    }
+
+
+    namespace {
+
+        class InstrumentCalculation {
+          public:
+            explicit InstrumentCalculation(
+                const std::vector<boost::shared_ptr<Instrument> >& instruments)
+            : instruments_(instruments) {}
+            void operator()(Size i) const {
+                try {
+                    instruments_[i]->NPV();
+                } catch (...) {
+                    // raised again when the results are requested
+                }
+            }
+          private:
+            const std::vector<boost::shared_ptr<Instrument> >& instruments_;
+        };
+
+    }
+
+
+    PortfolioCalculator::PortfolioCalculator(
+                const std::vector<boost::shared_ptr<Instrument> >& instruments,
+                Size threads)
+    : instruments_(instruments), threads_(threads) {
+        QL_REQUIRE(threads_ > 0, "at least one thread required");
+        for (Size i=0; i<instruments_.size(); ++i)
+            QL_REQUIRE(instruments_[i], "null instrument given");
+    }
+
+    std::vector<detail::ParallelCalculation::task_type>
+    PortfolioCalculator::tasks() const {
+        std::vector<detail::ParallelCalculation::task_type> tasks(
+                                                        instruments_.size());
+        for (Size i=0; i<instruments_.size(); ++i)
+            tasks[i].push_back(instruments_[i]);
+        return tasks;
+    }
+
+    std::vector<boost::shared_ptr<LazyObject> >
+    PortfolioCalculator::dependencies() const {
+        return detail::ParallelCalculation(tasks(), threads_).dependencies();
+    }
+
+    void PortfolioCalculator::calculate() const {
+        // the graph is walked again at each call, since it might
+        // have changed in the meantime
+        detail::ParallelCalculation calculation(tasks(), threads_);
+        calculation.calculateDependencies();
+        calculation.run(InstrumentCalculation(instruments_));
+    }
+
+}
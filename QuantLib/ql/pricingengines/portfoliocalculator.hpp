@@ -0,0 +1,198 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliocalculator.hpp
+    \brief calculation of a portfolio of instruments
+*/
+
+#ifndef quantlib_portfolio_calculator_hpp
+#define quantlib_portfolio_calculator_hpp
+
+#include <ql/instrument.hpp>
+#include <ql/settings.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! Parallel calculation of tasks on a graph of observers
+        /*! Each task is described by the observers it uses, e.g., an
+            instrument, or a calibration helper together with its
+            pricing engine.  The lazy objects below them are collected
+            so that they can be calculated beforehand by the calling
+            thread; the tasks are then grouped so that those sharing
+            a pricing engine or a coupon pricer, whose state is
+            modified during calculations, are run by the same thread.
+
+            This class is used by PortfolioCalculator and by the
+            parallel calibration of CalibratedModel; see the former
+            for the requirements on the objects involved.
+        */
+        class ParallelCalculation {
+          public:
+            typedef std::vector<boost::shared_ptr<Observer> > task_type;
+            ParallelCalculation(const std::vector<task_type>& tasks,
+                                Size threads);
+            //! \name Inspectors
+            //@{
+            Size threads() const { return threads_; }
+            /*! the lazy objects upon which the tasks depend, sorted
+                so that each of them follows its own dependencies.
+            */
+            const std::vector<boost::shared_ptr<LazyObject> >&
+            dependencies() const { return dependencies_; }
+            //! the indices of the tasks run by each thread
+            const std::vector<std::vector<Size> >& groups() const {
+                return groups_;
+            }
+            //@}
+            //! \name Calculations
+            //@{
+            /*! calculates the dependencies in order.  Errors are not
+                propagated; the objects that failed will raise them
+                again when their results are requested.  Since the
+                tasks using them would calculate them again, the
+                groups containing such tasks are marked so that
+                run() executes them in the calling thread.
+            */
+            void calculateDependencies() const;
+            /*! calls f(i) for each task index i, in parallel if the
+                library was compiled with OpenMP support; the groups
+                depending on a failed object, if any, are run first
+                by the calling thread.  The
+                function must not throw.  When sessions are enabled,
+                the global settings of the calling session are copied
+                into the sessions of the worker threads.
+            */
+            template <class F>
+            void run(const F& f) const;
+            //@}
+          private:
+            class SessionSettings {
+              public:
+                SessionSettings();
+                void apply() const;
+              private:
+                #if defined(QL_ENABLE_SESSIONS)
+                Date evaluationDate_;
+                bool includeReferenceDateEvents_;
+                boost::optional<bool> includeTodaysCashFlows_;
+                bool enforcesTodaysHistoricFixings_;
+                #endif
+            };
+            Size threads_;
+            std::vector<task_type> tasks_;
+            std::vector<boost::shared_ptr<LazyObject> > dependencies_;
+            std::vector<std::vector<Size> > groups_;
+            mutable std::vector<bool> serial_;
+        };
+
+    }
+
+
+    //! Calculation of a portfolio of instruments
+    /*! The calculator walks the observer graph below the given
+        instruments and collects the lazy objects they depend upon,
+        such as bootstrapped curves or volatility cubes.  When
+        calculate() is called, such shared dependencies are
+        calculated once, in topological order, by the calling
+        thread; the instruments are then calculated by the given
+        number of threads if the library was compiled with OpenMP
+        support, and sequentially otherwise.
+
+        Instruments sharing a pricing engine or a coupon pricer,
+        whose state is modified during calculations, are calculated
+        by the same thread.
+
+        When sessions are enabled, the evaluation date and the other
+        global settings of the calling session are copied into the
+        sessions of the worker threads before calculating.
+
+        \warning Besides the objects above, the ones used by the
+                 instruments must be safe for concurrent reading
+                 once calculated; this is the case for most library
+                 classes, but it can't be checked by the calculator.
+                 Of course, no object in the graph must be modified
+                 while calculate() runs.
+
+        \warning Errors raised during calculation are not propagated
+                 by calculate(); the objects that failed will raise
+                 them again when their results are requested.  The
+                 instruments depending on a shared object whose
+                 calculation failed are calculated sequentially.
+
+        \test results are checked against those of sequential
+              calculation.
+    */
+    class PortfolioCalculator {
+      public:
+        PortfolioCalculator(
+                const std::vector<boost::shared_ptr<Instrument> >& instruments,
+                Size threads = 1);
+        //! \name Inspectors
+        //@{
+        const std::vector<boost::shared_ptr<Instrument> >&
+        instruments() const { return instruments_; }
+        Size threads() const { return threads_; }
+        /*! returns the lazy objects upon which the instruments
+            depend, sorted so that each of them follows its own
+            dependencies.
+        */
+        std::vector<boost::shared_ptr<LazyObject> > dependencies() const;
+        //@}
+        //! calculates the dependencies and then the instruments
+        void calculate() const;
+      private:
+        std::vector<detail::ParallelCalculation::task_type> tasks() const;
+        std::vector<boost::shared_ptr<Instrument> > instruments_;
+        Size threads_;
+    };
+
+
+    // template definitions
+
+    namespace detail {
+
+        template <class F>
+        void ParallelCalculation::run(const F& f) const {
+            for (Size g=0; g<groups_.size(); ++g) {
+                if (serial_[g]) {
+                    for (Size j=0; j<groups_[g].size(); ++j)
+                        f(groups_[g][j]);
+                }
+            }
+            const SessionSettings settings;
+            #pragma omp parallel num_threads(threads_) if(threads_ > 1)
+            {
+                settings.apply();
+                #pragma omp for schedule(dynamic)
+                for (Size g=0; g<groups_.size(); ++g) {
+                    if (serial_[g])
+                        continue;
+                    for (Size j=0; j<groups_[g].size(); ++j)
+                        f(groups_[g][j]);
+                }
+            }
+        }
+
+    }
+
+}
+
+
+#endif
@@ -32,6 +32,8 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 
+#include <algorithm>
+
 #if defined(QL_PATCH_MSVC)
 #pragma warning(disable: 4180)
 #endif
@@ -74,6 +76,33 @@ namespace QuantLib {
             }
         };
 
+        // integrand of P_j given its strike-independent part k (see
+        // Fj_Helper::kernel) and the log-moneyness m = log(K/S_0)
+        Real fjIntegrand(Real phi, const std::complex<Real>& k, Real m) {
+            if (phi != 0.0) {
+                const Real a = phi*m;
+                return (k.imag()*std::cos(a) - k.real()*std::sin(a))/phi;
+            } else {
+                return k.real() - m;
+            }
+        }
+
+        Real optionValue(Option::Type type,
+                         Real spotPrice, Real strikePrice,
+                         Real dividendDiscount, Real riskFreeDiscount,
+                         Real p1, Real p2) {
+            switch (type) {
+              case Option::Call:
+                return spotPrice*dividendDiscount*(p1+0.5)
+                    - strikePrice*riskFreeDiscount*(p2+0.5);
+              case Option::Put:
+                return spotPrice*dividendDiscount*(p1-0.5)
+                    - strikePrice*riskFreeDiscount*(p2-0.5);
+              default:
+                QL_FAIL("unknown option type");
+            }
+        }
+
     }
 
     // helper class for integration
@@ -106,6 +135,11 @@ namespace QuantLib {
 
         Real operator()(Real phi)      const;
 
+        /* the part of the integrand not depending on the strike,
+           i.e., the integrand at phi is given by
+           fjIntegrand(phi, kernel(phi), log(K/S_0)) */
+        std::complex<Real> kernel(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -205,6 +239,12 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        return fjIntegrand(phi, kernel(phi), sx_-x_);
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::kernel(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -214,7 +254,7 @@ namespace QuantLib {
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
         const std::complex<Real> addOnTerm
-            = engine_ > 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+            = engine_ != 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
             if (phi != 0.0) {
@@ -226,9 +266,8 @@ namespace QuantLib {
                     return
                         std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
                                  + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
+                                 + std::complex<Real>(0.0, phi*(dd_-x_))
+                                 + addOnTerm);
                 }
                 else {
                     const std::complex<Real> td = phi/(2.0*t1)
@@ -239,9 +278,8 @@ namespace QuantLib {
                     return
                         std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
                                  + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
+                                 + std::complex<Real>(0.0, phi*(dd_-x_))
+                                 + addOnTerm);
                 }
             }
             else {
@@ -249,18 +287,18 @@ namespace QuantLib {
                 if (j_ == 1) {
                     const Real kmr = rsigma_-kappa_;
                     if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
+                        return dd_-x_
                             + (std::exp(kmr*term_)*kappa_*theta_
                                -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
                             - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
                     }
                     else
                         // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                        return dd_-x_ + 0.25*kappa_*theta_*term_*term_
                                        + 0.5*v0_*term_;
                 }
                 else {
-                    return dd_-sx_
+                    return dd_-x_
                         - (std::exp(-kappa_*term_)*kappa_*theta_
                            +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
                         - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
@@ -312,15 +350,33 @@ namespace QuantLib {
 
             return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
                             + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+                            + std::complex<Real>(0,phi*(dd_-x_))
+                            + addOnTerm);
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
         }
     }
 
+    // helper class for the integration of several strikes at once
+    class AnalyticHestonEngine::Fj_BatchHelper {
+      public:
+        Fj_BatchHelper(const Fj_Helper& helper,
+                       const std::vector<Real>& moneyness)
+        : helper_(helper), moneyness_(moneyness) {}
+
+        void operator()(Real phi, Array& values) const {
+            const std::complex<Real> k = helper_.kernel(phi);
+            for (Size i=0; i<moneyness_.size(); ++i)
+                values[i] = fjIntegrand(phi, k, moneyness_[i]);
+        }
+
+      private:
+        Fj_Helper helper_;
+        std::vector<Real> moneyness_;
+    };
+
+
     AnalyticHestonEngine::AnalyticHestonEngine(
                               const boost::shared_ptr<HestonModel>& model,
                               Size integrationOrder)
@@ -396,18 +452,74 @@ namespace QuantLib {
                       cpxLog, term, strikePrice, ratio, 2))/M_PI;
         evaluations+= integration.numberOfEvaluations();
 
-        switch (type.optionType())
-        {
-          case Option::Call:
-            value = spotPrice*dividendDiscount*(p1+0.5)
-                           - strikePrice*riskFreeDiscount*(p2+0.5);
-            break;
-          case Option::Put:
-            value = spotPrice*dividendDiscount*(p1-0.5)
-                           - strikePrice*riskFreeDiscount*(p2-0.5);
-            break;
-          default:
-            QL_FAIL("unknown option type");
+        value = optionValue(type.optionType(), spotPrice, strikePrice,
+                            dividendDiscount, riskFreeDiscount, p1, p2);
+    }
+
+    void AnalyticHestonEngine::doBatchCalculation(
+                                    Real riskFreeDiscount,
+                                    Real dividendDiscount,
+                                    Real spotPrice,
+                                    const std::vector<Real>& strikes,
+                                    Real term,
+                                    Real kappa, Real theta, Real sigma,
+                                    Real v0, Real rho,
+                                    const Integration& integration,
+                                    const ComplexLogFormula cpxLog,
+                                    const AnalyticHestonEngine* const enginePtr,
+                                    std::vector<Real>& p1,
+                                    std::vector<Real>& p2,
+                                    Size& evaluations) {
+
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+
+        const Real c_inf = std::min(10.0, std::max(0.0001,
+                std::sqrt(1.0-square<Real>()(rho))/sigma))
+                *(v0 + kappa*theta*term);
+
+        const Size n = strikes.size();
+        p1.resize(n);
+        p2.resize(n);
+        evaluations = 0;
+
+        if (integration.isAdaptiveIntegration()) {
+            // the integration nodes depend on the integrand
+            for (Size i=0; i<n; ++i) {
+                p1[i] = integration.calculate(c_inf,
+                    Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho,
+                              enginePtr, cpxLog, term, strikes[i],
+                              ratio, 1))/M_PI;
+                evaluations+= integration.numberOfEvaluations();
+
+                p2[i] = integration.calculate(c_inf,
+                    Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho,
+                              enginePtr, cpxLog, term, strikes[i],
+                              ratio, 2))/M_PI;
+                evaluations+= integration.numberOfEvaluations();
+            }
+        } else {
+            std::vector<Real> moneyness(n);
+            for (Size i=0; i<n; ++i)
+                moneyness[i] = std::log(strikes[i]) - std::log(spotPrice);
+
+            const Array q1 = integration.calculate(c_inf, n,
+                Fj_BatchHelper(
+                    Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho,
+                              enginePtr, cpxLog, term, spotPrice, ratio, 1),
+                    moneyness));
+            evaluations+= integration.numberOfEvaluations();
+
+            const Array q2 = integration.calculate(c_inf, n,
+                Fj_BatchHelper(
+                    Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho,
+                              enginePtr, cpxLog, term, spotPrice, ratio, 2),
+                    moneyness));
+            evaluations+= integration.numberOfEvaluations();
+
+            for (Size i=0; i<n; ++i) {
+                p1[i] = q1[i]/M_PI;
+                p2[i] = q2[i]/M_PI;
+            }
         }
     }
 
@@ -453,6 +565,111 @@ namespace QuantLib {
                       evaluations_);
     }
 
+    std::vector<Real> AnalyticHestonEngine::prices(
+                            const Date& maturity,
+                            const std::vector<Real>& strikes,
+                            const std::vector<Option::Type>& types) const {
+        QL_REQUIRE(allowsBatchPricing(),
+                   "batch pricing not supported by this engine");
+        QL_REQUIRE(strikes.size() == types.size(),
+                   "number of strikes (" << strikes.size() << ") and of "
+                   "option types (" << types.size() << ") differ");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+
+        std::vector<Real> p1, p2;
+        doBatchCalculation(riskFreeDiscount,
+                           dividendDiscount,
+                           spotPrice,
+                           strikes,
+                           term,
+                           model_->kappa(),
+                           model_->theta(),
+                           model_->sigma(),
+                           model_->v0(),
+                           model_->rho(),
+                           *integration_,
+                           cpxLog_,
+                           this,
+                           p1, p2,
+                           evaluations_);
+
+        std::vector<Real> values(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            values[i] = optionValue(types[i], spotPrice, strikes[i],
+                                    dividendDiscount, riskFreeDiscount,
+                                    p1[i], p2[i]);
+        return values;
+    }
+
+    Real AnalyticHestonEngine::batchedPrice(const Date& maturity,
+                                            Real strike,
+                                            Option::Type type) const {
+        QL_REQUIRE(allowsBatchPricing(),
+                   "batch pricing not supported by this engine");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+
+        // the cached probabilities are valid as long as the model
+        // parameters and the market data are the same
+        const Array params = model_->params();
+        std::vector<Real> state(params.begin(), params.end());
+        state.push_back(spotPrice);
+        state.push_back(riskFreeDiscount);
+        state.push_back(dividendDiscount);
+        state.push_back(term);
+
+        Batch& batch = batches_[maturity];
+        const Size i = std::find(batch.strikes.begin(), batch.strikes.end(),
+                                 strike) - batch.strikes.begin();
+        if (i == batch.strikes.size())
+            batch.strikes.push_back(strike);
+
+        if (i == batch.p1.size() || batch.state != state) {
+            batch.state.clear();
+            doBatchCalculation(riskFreeDiscount,
+                               dividendDiscount,
+                               spotPrice,
+                               batch.strikes,
+                               term,
+                               model_->kappa(),
+                               model_->theta(),
+                               model_->sigma(),
+                               model_->v0(),
+                               model_->rho(),
+                               *integration_,
+                               cpxLog_,
+                               this,
+                               batch.p1, batch.p2,
+                               evaluations_);
+            batch.state = state;
+        }
+
+        return optionValue(type, spotPrice, strike,
+                           dividendDiscount, riskFreeDiscount,
+                           batch.p1[i], batch.p2[i]);
+    }
+
 
     AnalyticHestonEngine::Integration::Integration(
             Algorithm intAlgo,
@@ -580,4 +797,33 @@ namespace QuantLib {
 
         return retVal;
      }
+
+    Disposable<Array> AnalyticHestonEngine::Integration::calculate(
+                Real c_inf, Size n,
+                const boost::function2<void, Real, Array&>& f) const {
+        QL_REQUIRE(!isAdaptiveIntegration(),
+                   "several functions can only be integrated at once "
+                   "with a non-adaptive integration algorithm");
+
+        // same nodes, visited in the same order, as in the
+        // quadratures used by the scalar version above
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+
+        Array retVal(n, 0.0), values(n);
+        for (Integer i = x.size()-1; i >= 0; --i) {
+            if (intAlgo_ == GaussLaguerre) {
+                f(x[i], values);
+                for (Size k=0; k<n; ++k)
+                    retVal[k] += w[i]*values[k];
+            } else if ((x[i]+1.0)*c_inf > QL_EPSILON) {
+                const Real jacobian = (x[i]+1.0)*c_inf;
+                f(-std::log(0.5*x[i]+0.5)/c_inf, values);
+                for (Size k=0; k<n; ++k)
+                    retVal[k] += w[i]*(values[k]/jacobian);
+            }
+        }
+
+        return retVal;
+    }
 }
@@ -33,6 +33,8 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <vector>
+#include <map>
 
 namespace QuantLib {
 
@@ -47,6 +49,13 @@ namespace QuantLib {
         needs some sort of "branch correction" to work properly.
         Gatheral's version does also work with adaptive integration
         routines and should be preferred over the original Heston version.
+
+        Options expiring on the same date share the whole integrand
+        but for a strike-dependent phase factor.  The prices() and
+        batchedPrice() methods take advantage of this: with a
+        non-adaptive integration algorithm the characteristic
+        function is evaluated once per integration node for all the
+        strikes.
     */
 
     /*! References:
@@ -105,6 +114,30 @@ namespace QuantLib {
         void calculate() const;
         Size numberOfEvaluations() const;
 
+        //! \name Strike-batched pricing
+        //@{
+        //! values of European options expiring on the given date
+        std::vector<Real> prices(const Date& maturity,
+                                 const std::vector<Real>& strikes,
+                                 const std::vector<Option::Type>& types) const;
+        /*! value of a single European option expiring on the given
+            date.  The strike is added to the ones already requested
+            for that date; the options for all of them are priced
+            together and cached until the model parameters or the
+            market data change.  HestonModelHelper uses this method,
+            so that the helpers sharing an engine and an expiry are
+            priced in one pass during calibration.
+        */
+        Real batchedPrice(const Date& maturity,
+                          Real strike,
+                          Option::Type type) const;
+        /*! whether the methods above can be used; engines whose
+            integrand depends on more than the model and the term
+            of the option should return false.
+        */
+        virtual bool allowsBatchPricing() const;
+        //@}
+
         static void doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -127,10 +160,35 @@ namespace QuantLib {
 
       private:
         class Fj_Helper;
+        class Fj_BatchHelper;
+
+        // probabilities P1-1/2 and P2-1/2 for the given strikes
+        static void doBatchCalculation(Real riskFreeDiscount,
+                                       Real dividendDiscount,
+                                       Real spotPrice,
+                                       const std::vector<Real>& strikes,
+                                       Real term,
+                                       Real kappa, Real theta, Real sigma,
+                                       Real v0, Real rho,
+                                       const Integration& integration,
+                                       const ComplexLogFormula cpxLog,
+                                       const AnalyticHestonEngine* const
+                                                                 enginePtr,
+                                       std::vector<Real>& p1,
+                                       std::vector<Real>& p2,
+                                       Size& evaluations);
+
+        // options priced by batchedPrice() for a given maturity
+        struct Batch {
+            std::vector<Real> strikes, p1, p2;
+            // parameters and market data the probabilities refer to
+            std::vector<Real> state;
+        };
 
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
+        mutable std::map<Date, Batch> batches_;
     };
 
 
@@ -159,6 +217,13 @@ namespace QuantLib {
 
         Real calculate(Real c_inf,
                        const boost::function1<Real, Real>& f) const;
+        /*! integrates several functions at once; f(phi, values) must
+            set values[i] to the value of the i-th function at phi.
+            Only available for non-adaptive algorithms.
+        */
+        Disposable<Array> calculate(
+                Real c_inf, Size n,
+                const boost::function2<void, Real, Array&>& f) const;
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
@@ -188,6 +253,10 @@ namespace QuantLib {
                                                        Size) const {
         return std::complex<Real>(0,0);
     }
+
+    inline bool AnalyticHestonEngine::allowsBatchPricing() const {
+        return true;
+    }
 }
 
 #endif
@@ -78,6 +78,8 @@ namespace QuantLib {
 
         void update();
         void calculate() const;
+        // m_ is set by calculate() for the term of the option
+        bool allowsBatchPricing() const;
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const;
@@ -96,6 +98,10 @@ namespace QuantLib {
         return std::complex<Real>(-m_*u*u, u*(m_-2*m_*(j-1)));
     }
 
+    inline bool AnalyticHestonHullWhiteEngine::allowsBatchPricing() const {
+        return false;
+    }
+
 }
 
 #endif
@@ -111,6 +111,7 @@ namespace QuantLib {
         MakeMCAmericanEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCAmericanEngine& withMaxSamples(Size samples);
         MakeMCAmericanEngine& withSeed(BigNatural seed);
+        MakeMCAmericanEngine& withThreads(Size threads);
         MakeMCAmericanEngine& withAntitheticVariate(bool b = true);
         MakeMCAmericanEngine& withControlVariate(bool b = true);
         MakeMCAmericanEngine& withPolynomOrder(Size polynomOrer);
@@ -128,6 +129,7 @@ namespace QuantLib {
         BigNatural seed_;
         Size polynomOrder_;
         LsmBasisSystem::PolynomType polynomType_;
+        Size threads_;
     };
 
     template <class RNG, class S> inline
@@ -252,7 +254,7 @@ namespace QuantLib {
       calibrationSamples_(2048),
       tolerance_(Null<Real>()), seed_(0),
       polynomOrder_(2),
-      polynomType_ (LsmBasisSystem::Monomial) {}
+      polynomType_ (LsmBasisSystem::Monomial), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCAmericanEngine<RNG,S>&
@@ -325,6 +327,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCAmericanEngine<RNG,S>&
+    MakeMCAmericanEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCAmericanEngine<RNG,S>&
     MakeMCAmericanEngine<RNG,S>::withAntitheticVariate(bool b) {
@@ -348,7 +357,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCAmericanEngine<RNG, S> > engine(new
             MCAmericanEngine<RNG, S>(process_,
                                      steps_,
                                      stepsPerYear_,
@@ -360,6 +369,8 @@ namespace QuantLib {
                                      polynomOrder_,
                                      polynomType_,
                                      calibrationSamples_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
@@ -97,6 +97,7 @@ namespace QuantLib {
         MakeMCDigitalEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCDigitalEngine& withMaxSamples(Size samples);
         MakeMCDigitalEngine& withSeed(BigNatural seed);
+        MakeMCDigitalEngine& withThreads(Size threads);
         MakeMCDigitalEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -107,6 +108,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     class DigitalPathPricer : public PathPricer<Path> {
@@ -192,7 +194,7 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDigitalEngine<RNG,S>&
@@ -243,6 +245,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDigitalEngine<RNG,S>&
+    MakeMCDigitalEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCDigitalEngine<RNG,S>&
     MakeMCDigitalEngine<RNG,S>::withBrownianBridge(bool brownianBridge) {
@@ -265,7 +274,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCDigitalEngine<RNG,S> > engine(new
             MCDigitalEngine<RNG,S>(process_,
                                    steps_,
                                    stepsPerYear_,
@@ -274,6 +283,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
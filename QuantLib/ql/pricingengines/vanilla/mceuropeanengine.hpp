@@ -79,6 +79,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanEngine& withThreads(Size threads);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -89,6 +90,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -159,7 +161,7 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -210,6 +212,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
     MakeMCEuropeanEngine<RNG,S>::withBrownianBridge(bool brownianBridge) {
@@ -232,7 +241,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCEuropeanEngine<RNG,S> > engine(new
             MCEuropeanEngine<RNG,S>(process_,
                                     steps_,
                                     stepsPerYear_,
@@ -241,6 +250,8 @@ namespace QuantLib {
                                     samples_, tolerance_,
                                     maxSamples_,
                                     seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 
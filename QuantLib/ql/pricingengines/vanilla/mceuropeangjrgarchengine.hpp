@@ -65,6 +65,7 @@ namespace QuantLib {
         MakeMCEuropeanGJRGARCHEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanGJRGARCHEngine& withMaxSamples(Size samples);
         MakeMCEuropeanGJRGARCHEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanGJRGARCHEngine& withThreads(Size threads);
         MakeMCEuropeanGJRGARCHEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -74,6 +75,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -134,7 +136,7 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanGJRGARCHEngine<RNG,S>&
@@ -189,6 +191,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanGJRGARCHEngine<RNG,S>&
+    MakeMCEuropeanGJRGARCHEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCEuropeanGJRGARCHEngine<RNG,S>&
     MakeMCEuropeanGJRGARCHEngine<RNG,S>::withAntitheticVariate(bool b) {
@@ -202,7 +211,7 @@ namespace QuantLib {
     operator boost::shared_ptr<PricingEngine>() const {
         QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
                    "number of steps not given");
-        return boost::shared_ptr<PricingEngine>(
+        boost::shared_ptr<MCEuropeanGJRGARCHEngine<RNG,S> > engine(
                  new MCEuropeanGJRGARCHEngine<RNG,S>(process_,
                                                    steps_,
                                                    stepsPerYear_,
@@ -210,6 +219,8 @@ namespace QuantLib {
                                                    samples_, tolerance_,
                                                    maxSamples_,
                                                    seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 
@@ -66,6 +66,7 @@ namespace QuantLib {
         MakeMCEuropeanHestonEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanHestonEngine& withMaxSamples(Size samples);
         MakeMCEuropeanHestonEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanHestonEngine& withThreads(Size threads);
         MakeMCEuropeanHestonEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -75,6 +76,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -135,7 +137,7 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanHestonEngine<RNG,S>&
@@ -190,6 +192,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanHestonEngine<RNG,S>&
+    MakeMCEuropeanHestonEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCEuropeanHestonEngine<RNG,S>&
     MakeMCEuropeanHestonEngine<RNG,S>::withAntitheticVariate(bool b) {
@@ -203,7 +212,7 @@ namespace QuantLib {
     operator boost::shared_ptr<PricingEngine>() const {
         QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
                    "number of steps not given");
-        return boost::shared_ptr<PricingEngine>(
+        boost::shared_ptr<MCEuropeanHestonEngine<RNG,S> > engine(
                  new MCEuropeanHestonEngine<RNG,S>(process_,
                                                    steps_,
                                                    stepsPerYear_,
@@ -211,6 +220,8 @@ namespace QuantLib {
                                                    samples_, tolerance_,
                                                    maxSamples_,
                                                    seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 
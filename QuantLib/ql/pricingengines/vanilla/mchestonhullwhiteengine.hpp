@@ -81,6 +81,7 @@ namespace QuantLib {
         MakeMCHestonHullWhiteEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCHestonHullWhiteEngine& withMaxSamples(Size samples);
         MakeMCHestonHullWhiteEngine& withSeed(BigNatural seed);
+        MakeMCHestonHullWhiteEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -89,6 +90,7 @@ namespace QuantLib {
         bool antithetic_, controlVariate_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -228,7 +230,7 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       antithetic_(false), controlVariate_(false),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(1) {}
 
     template <class RNG, class S>
     inline MakeMCHestonHullWhiteEngine<RNG,S>&
@@ -293,6 +295,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCHestonHullWhiteEngine<RNG,S>&
+    MakeMCHestonHullWhiteEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCHestonHullWhiteEngine<RNG,S>::operator
@@ -301,7 +310,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCHestonHullWhiteEngine<RNG,S> > engine(new
             MCHestonHullWhiteEngine<RNG,S>(process_,
                                            steps_,
                                            stepsPerYear_,
@@ -311,6 +320,8 @@ namespace QuantLib {
                                            tolerance_,
                                            maxSamples_,
                                            seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
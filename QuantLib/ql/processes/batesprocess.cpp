@@ -59,6 +59,14 @@ namespace QuantLib {
         return retVal;
     }
 
+    void BatesProcess::evolveBatch(Time t0, const Matrix& x0,
+                                   Time dt, const Matrix& dw,
+                                   Matrix& x) const {
+        // the jump component is added by evolve(), which must
+        // therefore be called for each path
+        StochasticProcess::evolveBatch(t0, x0, dt, dw, x);
+    }
+
     Size BatesProcess::factors() const {
         return 4;
     }
@@ -93,6 +93,36 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBatch(Time t0,
+                                                     const Array& x0,
+                                                     Time dt,
+                                                     const Array& dw,
+                                                     Array& x) const {
+        localVolatility(); // trigger update if necessary
+        if (isStrikeIndependent_) {
+            QL_REQUIRE(dw.size() == x0.size(),
+                       "mismatch between number of paths in states ("
+                       << x0.size() << ") and increments ("
+                       << dw.size() << ")");
+            QL_REQUIRE(x.size() == x0.size(),
+                       "wrong size for evolved states");
+            // same as evolve(), but the variance and drift are
+            // calculated once for all paths
+            Real variance = blackVolatility_->blackVariance(t0 + dt, 0.01) -
+                            blackVolatility_->blackVariance(t0, 0.01);
+            Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                     NoFrequency, true) -
+                          dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                      NoFrequency, true)) *
+                dt - 0.5 * variance;
+            Real stdDev = std::sqrt(variance);
+            for (Size j=0; j<x0.size(); ++j)
+                x[j] = x0[j] * std::exp( stdDev * dw[j] + drift );
+        } else {
+            StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
@@ -74,6 +74,8 @@ namespace QuantLib {
         */
         Real expectation(Time t0, Real x0, Time dt) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        void evolveBatch(Time t0, const Array& x0,
+                         Time dt, const Array& dw, Array& x) const;
         //@}
         Time time(const Date&) const;
         //! \name Observer interface
@@ -23,6 +23,33 @@ namespace QuantLib {
 
 namespace detail {
 
+namespace {
+
+// the caches are filled on demand by const methods; concurrent
+// access, e.g., during a parallel model calibration, is serialized
+template <class Key>
+bool cachedValue(const std::map<Key, Real> &cache, const Key &key,
+                 Real &value) {
+    bool found = false;
+#pragma omp critical(ql_gsr_process_core_cache)
+    {
+        typename std::map<Key, Real>::const_iterator k = cache.find(key);
+        if (k != cache.end()) {
+            value = k->second;
+            found = true;
+        }
+    }
+    return found;
+}
+
+template <class Key>
+void cacheValue(std::map<Key, Real> &cache, const Key &key, const Real value) {
+#pragma omp critical(ql_gsr_process_core_cache)
+    cache.insert(std::make_pair(key, value));
+}
+
+} // anonymous namespace
+
 GsrProcessCore::GsrProcessCore(const Array &times, const Array &vols,
                                const Array &reversions, const Real T)
     : times_(times), vols_(vols), reversions_(reversions),
@@ -66,15 +93,15 @@ const Real GsrProcessCore::expectation_x0dep_part(const Time w, const Real xw,
     Real t = w + dt;
     std::pair<Real, Real> key;
     key = std::make_pair(w, t);
-    std::map<std::pair<Real, Real>, Real>::const_iterator k = cache1_.find(key);
-    if (k != cache1_.end())
-        return xw * (k->second);
+    Real cached;
+    if (cachedValue(cache1_, key, cached))
+        return xw * cached;
     // A(w,t)x(w)
     Real res2 = 1.0;
     for (int i = lowerIndex(w); i <= upperIndex(t) - 1; i++) {
         res2 *= exp(-rev(i) * (cappedTime(i + 1, t) - flooredTime(i, w)));
     }
-    cache1_.insert(std::make_pair(key, res2));
+    cacheValue(cache1_, key, res2);
     return res2 * xw;
 }
 
@@ -85,10 +112,9 @@ const Real GsrProcessCore::expectation_rn_part(const Time w,
 
     std::pair<Real, Real> key;
     key = std::make_pair(w, t);
-    std::map<std::pair<Real, Real>, Real>::const_iterator k =
-        cache2a_.find(key);
-    if (k != cache2a_.end())
-        return k->second;
+    Real cached;
+    if (cachedValue(cache2a_, key, cached))
+        return cached;
 
     Real res = 0.0;
 
@@ -146,7 +172,7 @@ const Real GsrProcessCore::expectation_rn_part(const Time w,
         res += res2;
     }
 
-    cache2a_.insert(std::make_pair(key, res));
+    cacheValue(cache2a_, key, res);
 
     return res;
 } // expectation_rn_part
@@ -158,10 +184,9 @@ const Real GsrProcessCore::expectation_tf_part(const Time w,
 
     std::pair<Real, Real> key;
     key = std::make_pair(w, t);
-    std::map<std::pair<Real, Real>, Real>::const_iterator k =
-        cache2b_.find(key);
-    if (k != cache2b_.end())
-        return k->second;
+    Real cached;
+    if (cachedValue(cache2b_, key, cached))
+        return cached;
 
     Real res = 0.0;
     // int -A(s,t) \sigma^2 G(s,T)
@@ -224,7 +249,7 @@ const Real GsrProcessCore::expectation_tf_part(const Time w,
         res += -vol(k) * vol(k) * res2;
     }
 
-    cache2b_.insert(std::make_pair(key, res));
+    cacheValue(cache2b_, key, res);
 
     return res;
 } // expectation_tf_part
@@ -235,9 +260,9 @@ const Real GsrProcessCore::variance(const Time w, const Time dt) const {
 
     std::pair<Real, Real> key;
     key = std::make_pair(w, t);
-    std::map<std::pair<Real, Real>, Real>::const_iterator k = cache3_.find(key);
-    if (k != cache3_.end())
-        return k->second;
+    Real cached;
+    if (cachedValue(cache3_, key, cached))
+        return cached;
 
     Real res = 0.0;
     for (int k = lowerIndex(w); k <= upperIndex(t) - 1; k++) {
@@ -255,16 +280,16 @@ const Real GsrProcessCore::variance(const Time w, const Time dt) const {
         res += res2;
     }
 
-    cache3_.insert(std::make_pair(key, res));
+    cacheValue(cache3_, key, res);
     return res;
 }
 
 const Real GsrProcessCore::y(const Time t) const {
     Real key;
     key = t;
-    std::map<Real, Real>::const_iterator k = cache4_.find(key);
-    if (k != cache4_.end())
-        return k->second;
+    Real cached;
+    if (cachedValue(cache4_, key, cached))
+        return cached;
 
     Real res = 0.0;
     for (int i = 0; i <= upperIndex(t) - 1; i++) {
@@ -279,16 +304,16 @@ const Real GsrProcessCore::y(const Time t) const {
         res += res2;
     }
 
-    cache4_.insert(std::make_pair(key, res));
+    cacheValue(cache4_, key, res);
     return res;
 }
 
 const Real GsrProcessCore::G(const Time t, const Time w) const {
     std::pair<Real, Real> key;
     key = std::make_pair(w, t);
-    std::map<std::pair<Real, Real>, Real>::const_iterator k = cache5_.find(key);
-    if (k != cache5_.end())
-        return k->second;
+    Real cached;
+    if (cachedValue(cache5_, key, cached))
+        return cached;
 
     Real res = 0.0;
     for (int i = lowerIndex(t); i <= upperIndex(w) - 1; i++) {
@@ -303,7 +328,7 @@ const Real GsrProcessCore::G(const Time t, const Time w) const {
         res += res2;
     }
 
-    cache5_.insert(std::make_pair(key, res));
+    cacheValue(cache5_, key, res);
     return res;
 }
 
@@ -349,6 +349,46 @@ namespace QuantLib {
     Disposable<Array> HestonProcess::evolve(Time t0, const Array& x0,
                                             Time dt, const Array& dw) const {
         Array retVal(2);
+        const Rate rate =
+              riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+            - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+        evolveState(rate, dt, x0.begin(), dw.begin(), retVal.begin());
+        return retVal;
+    }
+
+    void HestonProcess::evolveBatch(Time t0, const Matrix& x0,
+                                    Time dt, const Matrix& dw,
+                                    Matrix& x) const {
+        QL_REQUIRE(x0.rows() == 2, "wrong number of state variables ("
+                   << x0.rows() << "), 2 required");
+        QL_REQUIRE(dw.rows() == factors(), "wrong number of factors ("
+                   << dw.rows() << "), " << factors() << " required");
+        QL_REQUIRE(dw.columns() == x0.columns(),
+                   "mismatch between number of paths in states ("
+                   << x0.columns() << ") and increments ("
+                   << dw.columns() << ")");
+        QL_REQUIRE(x.rows() == x0.rows() && x.columns() == x0.columns(),
+                   "wrong size for evolved states");
+
+        // the drift of the asset is the same for all paths
+        const Rate rate =
+              riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+            - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+
+        Real y0[2], w[3], y[2];
+        for (Size j=0; j<x0.columns(); ++j) {
+            y0[0] = x0[0][j];
+            y0[1] = x0[1][j];
+            for (Size k=0; k<dw.rows(); ++k)
+                w[k] = dw[k][j];
+            evolveState(rate, dt, y0, w, y);
+            x[0][j] = y[0];
+            x[1][j] = y[1];
+        }
+    }
+
+    void HestonProcess::evolveState(Rate rate, Time dt, const Real* x0,
+                                    const Real* dw, Real* retVal) const {
         Real vol, vol2, mu, nu, dy;
 
         const Real sdt = std::sqrt(dt);
@@ -363,9 +403,7 @@ namespace QuantLib {
           case PartialTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
-                    - 0.5 * vol * vol;
+            mu = rate - 0.5*vol*vol;
             nu = kappa_*(theta_ - x0[1]);
 
             retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
@@ -374,9 +412,7 @@ namespace QuantLib {
           case FullTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
-                    - 0.5 * vol * vol;
+            mu = rate - 0.5*vol*vol;
             nu = kappa_*(theta_ - vol*vol);
 
             retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
@@ -385,9 +421,7 @@ namespace QuantLib {
           case Reflection:
             vol = std::sqrt(std::fabs(x0[1]));
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
-                    - 0.5 * vol*vol;
+            mu = rate - 0.5*vol*vol;
             nu = kappa_*(theta_ - vol*vol);
 
             retVal[0] = x0[0]*std::exp(mu*dt+vol*dw[0]*sdt);
@@ -401,9 +435,7 @@ namespace QuantLib {
             // process. For further details please read the Wilmott thread
             // "QuantLib code is very high quality"
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
-            mu =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                 - dividendYield_->forwardRate(t0, t0+dt, Continuous)
-                   - 0.5 * vol*vol;
+            mu = rate - 0.5*vol*vol;
 
             retVal[1] = varianceDistribution(x0[1], dw[1], dt);
             dy = (mu - rho_/sigma_*kappa_
@@ -460,10 +492,7 @@ namespace QuantLib {
                 retVal[1] = ((u <= p) ? 0.0 : std::log((1-p)/(1-u))/beta);
             }
 
-            mu =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                 - dividendYield_->forwardRate(t0, t0+dt, Continuous);
-
-            retVal[0] = x0[0]*std::exp(mu*dt + k0 + k1*x0[1] + k2*retVal[1]
+            retVal[0] = x0[0]*std::exp(rate*dt + k0 + k1*x0[1] + k2*retVal[1]
                                        +std::sqrt(k3*x0[1]+k4*retVal[1])*dw[0]);
           }
           break;
@@ -485,9 +514,7 @@ namespace QuantLib {
             const Real vdw
                 = (nu_t - nu_0 - kappa_*theta_*dt + kappa_*vds)/sigma_;
 
-            mu = ( riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  -dividendYield_->forwardRate(t0, t0+dt, Continuous))*dt
-                - 0.5*vds + rho_*vdw;
+            mu = rate*dt - 0.5*vds + rho_*vdw;
 
             const Volatility sig = std::sqrt((1-rho_*rho_)*vds);
             const Real s = x0[0]*std::exp(mu + sig*dw[0]);
@@ -499,8 +526,6 @@ namespace QuantLib {
           default:
             QL_FAIL("unknown discretization schema");
         }
-
-        return retVal;
     }
 
     const Handle<Quote>& HestonProcess::s0() const {
@@ -71,6 +71,8 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        void evolveBatch(Time t0, const Matrix& x0,
+                         Time dt, const Matrix& dw, Matrix& x) const;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -86,6 +88,8 @@ namespace QuantLib {
 
       private:
         Real varianceDistribution(Real v, Real dw, Time dt) const;
+        void evolveState(Rate rate, Time dt, const Real* x0,
+                         const Real* dw, Real* x) const;
 
         Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
         Handle<Quote> s0_;
@@ -62,6 +62,23 @@ namespace QuantLib {
         return process_->variance(t0, x0, dt);
     }
 
+    void HullWhiteProcess::evolveBatch(Time t0, const Array& x0,
+                                       Time dt, const Array& dw,
+                                       Array& x) const {
+        QL_REQUIRE(dw.size() == x0.size(),
+                   "mismatch between number of paths in states ("
+                   << x0.size() << ") and increments ("
+                   << dw.size() << ")");
+        QL_REQUIRE(x.size() == x0.size(), "wrong size for evolved states");
+        // the shift and the standard deviation don't depend on the state
+        const Real alpha1 = alpha(t0 + dt);
+        const Real alpha0 = alpha(t0)*std::exp(-a_*dt);
+        const Real stdDev = process_->stdDeviation(t0, 0.0, dt);
+        for (Size j=0; j<x0.size(); ++j)
+            x[j] = (process_->expectation(t0, x0[j], dt)
+                    + alpha1 - alpha0) + stdDev*dw[j];
+    }
+
     Real HullWhiteProcess::alpha(Time t) const {
         Real alfa = a_ > QL_EPSILON ?
                     (sigma_/a_)*(1 - std::exp(-a_*t)) :
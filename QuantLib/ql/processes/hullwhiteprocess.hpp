@@ -45,6 +45,8 @@ namespace QuantLib {
         Real expectation(Time t0, Real x0, Time dt) const;
         Real stdDeviation(Time t0, Real x0, Time dt) const;
         Real variance(Time t0, Real x0, Time dt) const;
+        void evolveBatch(Time t0, const Array& x0,
+                         Time dt, const Array& dw, Array& x) const;
 
         Real a() const;
         Real sigma() const;
@@ -59,6 +59,31 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess::evolveBatch(Time t0, const Matrix& x0,
+                                        Time dt, const Matrix& dw,
+                                        Matrix& x) const {
+        QL_REQUIRE(x0.rows() == size(),
+                   "wrong number of state variables (" << x0.rows()
+                   << "), " << size() << " required");
+        QL_REQUIRE(dw.rows() == factors(),
+                   "wrong number of factors (" << dw.rows()
+                   << "), " << factors() << " required");
+        QL_REQUIRE(dw.columns() == x0.columns(),
+                   "mismatch between number of paths in states ("
+                   << x0.columns() << ") and increments ("
+                   << dw.columns() << ")");
+        QL_REQUIRE(x.rows() == x0.rows() && x.columns() == x0.columns(),
+                   "wrong size for evolved states");
+
+        Array y(x0.rows()), w(dw.rows());
+        for (Size j=0; j<x0.columns(); ++j) {
+            std::copy(x0.column_begin(j), x0.column_end(j), y.begin());
+            std::copy(dw.column_begin(j), dw.column_end(j), w.begin());
+            const Array z = evolve(t0, y, dt, w);
+            std::copy(z.begin(), z.end(), x.column_begin(j));
+        }
+    }
+
     Disposable<Array> StochasticProcess::apply(const Array& x0,
                                                const Array& dx) const {
         return x0 + dx;
@@ -98,6 +123,18 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess1D::evolveBatch(Time t0, const Array& x0,
+                                          Time dt, const Array& dw,
+                                          Array& x) const {
+        QL_REQUIRE(dw.size() == x0.size(),
+                   "mismatch between number of paths in states ("
+                   << x0.size() << ") and increments ("
+                   << dw.size() << ")");
+        QL_REQUIRE(x.size() == x0.size(), "wrong size for evolved states");
+        for (Size j=0; j<x0.size(); ++j)
+            x[j] = evolve(t0, x0[j], dt, dw[j]);
+    }
+
     Real StochasticProcess1D::apply(Real x0, Real dx) const {
         return x0 + dx;
     }
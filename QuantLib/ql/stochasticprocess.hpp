@@ -123,6 +123,25 @@ namespace QuantLib {
                                          const Array& x0,
                                          Time dt,
                                          const Array& dw) const;
+        /*! evolves a batch of paths over the same time interval.
+            The j-th column of x0 (whose rows correspond to the
+            state variables) and of dw (whose rows correspond to the
+            factors) holds the initial state and the Brownian
+            increments of the j-th path; the evolved states are
+            written in the corresponding columns of x, which must
+            have the same dimensions as x0 and can be the same
+            matrix.
+
+            By default, it calls evolve() for each path. It can be
+            overridden in derived classes in order to perform
+            path-independent calculations only once for all paths;
+            the results must be the same as those of evolve().
+        */
+        virtual void evolveBatch(Time t0,
+                                 const Matrix& x0,
+                                 Time dt,
+                                 const Matrix& dw,
+                                 Matrix& x) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ \mathrm{x} + \Delta \mathrm{x} \f$.
         */
@@ -216,6 +235,20 @@ namespace QuantLib {
             standard deviation.
         */
         virtual Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! evolves a batch of paths over the same time interval;
+            x0[j] and dw[j] are the initial value and the Brownian
+            increment of the j-th path, whose evolved value is
+            written in x[j]. The x array must have the same size as
+            x0 and can be the same array.
+
+            By default, it calls evolve() for each path. It can be
+            overridden in derived classes in order to perform
+            path-independent calculations only once for all paths;
+            the results must be the same as those of evolve().
+        */
+        virtual void evolveBatch(Time t0, const Array& x0,
+                                 Time dt, const Array& dw,
+                                 Array& x) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ x + \Delta x \f$.
         */
@@ -239,6 +272,8 @@ namespace QuantLib {
                                       Time dt) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        void evolveBatch(Time t0, const Matrix& x0,
+                         Time dt, const Matrix& dw, Matrix& x) const;
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
     };
 
@@ -310,6 +345,17 @@ namespace QuantLib {
         return a;
     }
 
+    inline void StochasticProcess1D::evolveBatch(Time t0, const Matrix& x0,
+                                                 Time dt, const Matrix& dw,
+                                                 Matrix& x) const {
+        QL_REQUIRE(x0.rows() == 1 && dw.rows() == 1 && x.rows() == 1,
+                   "1-D matrices required");
+        Array a(x0.row_begin(0), x0.row_end(0));
+        Array w(dw.row_begin(0), dw.row_end(0));
+        evolveBatch(t0, a, dt, w, a);
+        std::copy(a.begin(), a.end(), x.row_begin(0));
+    }
+
     inline Disposable<Array> StochasticProcess1D::apply(
                                                       const Array& x0,
                                                       const Array& dx) const {
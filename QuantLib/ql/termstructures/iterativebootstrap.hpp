@@ -32,38 +32,173 @@
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ctime>
 
 namespace QuantLib {
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! In incremental mode, a calculation following a successful
+        one (with unchanged pillar dates) only fixes the part of the
+        curve affected by the changes.  A helper is considered
+        changed when its quote error moved from the residual left by
+        the previous calculation by more than the curve accuracy;
+        this detects changes in the quotes as well as in any other
+        input of the helpers.
+
+        - For local interpolators (and pillars corresponding to the
+          latest relevant dates of the helpers) the pillar loop is
+          restarted from the first changed helper, keeping the
+          previous nodes.
+        - Otherwise, the nodes are updated by Newton steps using a
+          cached Jacobian of the implied quotes with respect to the
+          curve nodes.  The Jacobian is calculated by finite
+          differences after a full bootstrap and reused until the
+          pillar dates change or the steps fail to converge.
+
+        In both cases, the full bootstrap is used as a fallback.
+        Statistics about the last calculation are available through
+        the inspectors.
+
+        A previously calculated state of the curve (e.g., read from
+        a snapshot) can be installed by means of the restore()
+        method; see its documentation for details.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
         typedef typename Curve::interpolator_type Interpolator;
       public:
-        IterativeBootstrap();
+        IterativeBootstrap(bool incremental = false);
         void setup(Curve* ts);
         void calculate() const;
+        //! \name Inspectors
+        //@{
+        bool incremental() const { return incremental_; }
+        //! whether the last calculation was performed incrementally
+        bool lastCalculationIncremental() const { return lastIncremental_; }
+        //! whether the last calculation accepted a restored state
+        bool lastCalculationRestored() const { return lastRestored_; }
+        /*! first pillar (1-based, among alive ones) solved again in
+            the last calculation; it is larger than the number of
+            pillars if no node needed to be changed.
+        */
+        Size firstRecalculatedPillar() const { return firstPillar_; }
+        //! iterations of the pillar loop in the last calculation
+        Size iterations() const { return iterations_; }
+        //! Newton steps performed in the last calculation
+        Size newtonSteps() const { return newtonSteps_; }
+        //! Jacobian calculations performed in the last calculation
+        Size jacobianCalculations() const { return jacobianCalculations_; }
+        //! CPU time (in seconds) spent in the last calculation
+        Real elapsedTime() const { return elapsedTime_; }
+        //@}
+        //! \name Sensitivities
+        //@{
+        /*! returns the derivatives of the curve nodes with respect to
+            the quotes of the alive helpers.  The element \f$ (i,j) \f$
+            is the derivative of node \f$ i+1 \f$ (node 0 being the
+            one at the reference date) with respect to the quote of
+            the \f$ j \f$-th helper returned by aliveHelpers().
+
+            The matrix is obtained by inverting the Jacobian of the
+            implied quotes with respect to the nodes, which is
+            calculated by finite differences at the converged curve.
+            It is cached until the nodes change; incremental updates
+            might use it for their Newton steps after it's stale,
+            but it is calculated again when requested here.
+        */
+        Disposable<Matrix> nodeJacobian() const;
+        //! alive helpers, sorted by pillar date
+        std::vector<boost::shared_ptr<typename Traits::helper> >
+        aliveHelpers() const;
+        /*! sets the value of node \f$ i \f$ of the calculated
+            curve and notifies its observers, without bootstrapping
+            the curve again.
+
+            \warning This method is meant for sensitivity
+                     calculations: the curve will not reprice its
+                     helpers until the original value is restored or
+                     the curve is bootstrapped again.
+        */
+        void setNode(Size i, Real value) const;
+        //@}
+        //! \name Persistence
+        //@{
+        /*! installs a previously calculated state of the curve,
+            given by its nodes together with the quotes of the alive
+            helpers and their quote errors at the time the state was
+            calculated.
+
+            The state is used by the next calculation, provided that
+            the pillar dates of the curve are unchanged.  It is
+            accepted without solving if the helper quotes have the
+            same values and their quote errors differ from the given
+            residuals by less than the curve accuracy (which detects
+            changes in other inputs of the helpers); otherwise, it is
+            used as initial guess for the bootstrap (or, in
+            incremental mode, as the starting point of an incremental
+            calculation.)
+
+            \pre \c dates and \c data must contain one element for
+                 each node of the curve, including the one at the
+                 reference date; \c quotes and \c residuals one for
+                 each alive helper.
+        */
+        void restore(const std::vector<Date>& dates,
+                     const std::vector<Real>& data,
+                     const std::vector<Real>& quotes,
+                     const std::vector<Real>& residuals) const;
+        //@}
       private:
         void initialize() const;
+        bool installRestoredState() const;
+        void bootstrap(Size firstPillar, bool validData) const;
+        bool updateIncrementally() const;
+        bool newtonUpdate() const;
+        void calculateJacobian() const;
+        void storeResiduals() const;
+        Real maxResidualChange() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
+        bool incremental_;
         mutable bool initialized_, validCurve_, loopRequired_;
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        // incremental mode
+        mutable std::vector<Real> residuals_;
+        mutable Matrix inverseJacobian_;
+        // validJacobian_ is enough for the Newton steps; the
+        // sensitivities also need currentJacobian_, i.e., the
+        // Jacobian calculated at the current nodes
+        mutable bool validJacobian_, currentJacobian_;
+        // restored state, used by the next calculation
+        mutable std::vector<Date> restoredDates_;
+        mutable std::vector<Real> restoredData_, restoredQuotes_;
+        mutable std::vector<Real> restoredResiduals_;
+        // statistics
+        mutable bool lastIncremental_, lastRestored_;
+        mutable Size firstPillar_, iterations_, newtonSteps_;
+        mutable Size jacobianCalculations_;
+        mutable Real elapsedTime_;
     };
 
 
     // template definitions
 
     template <class Curve>
-    IterativeBootstrap<Curve>::IterativeBootstrap()
-        : ts_(0), initialized_(false), validCurve_(false), 
-          loopRequired_(Interpolator::global) {}
+    IterativeBootstrap<Curve>::IterativeBootstrap(bool incremental)
+        : ts_(0), incremental_(incremental), initialized_(false),
+          validCurve_(false), loopRequired_(Interpolator::global),
+          validJacobian_(false), currentJacobian_(false),
+          lastIncremental_(false),
+          lastRestored_(false), firstPillar_(0),
+          iterations_(0), newtonSteps_(0), jacobianCalculations_(0),
+          elapsedTime_(0.0) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
@@ -152,13 +287,24 @@ namespace QuantLib {
     template <class Curve>
     void IterativeBootstrap<Curve>::calculate() const {
 
+        std::clock_t start = std::clock();
+        lastIncremental_ = lastRestored_ = false;
+        firstPillar_ = 1;
+        iterations_ = newtonSteps_ = jacobianCalculations_ = 0;
+
         // we might have to call initialize even if the curve is initialized
         // and not moving, just because helpers might be date relative and change
         // with evaluation date change.
         // anyway it makes little sense to use date relative helpers with a
         // non-moving curve if the evaluation date changes
-        if (!initialized_ || ts_->moving_)
+        if (!initialized_ || ts_->moving_) {
+            std::vector<Date> previousDates = ts_->dates_;
             initialize();
+            if (ts_->dates_ != previousDates) {
+                validJacobian_ = false;
+                residuals_.clear();
+            }
+        }
 
         // setup helpers
         for (Size j=firstAliveHelper_; j<n_; ++j) {
@@ -175,19 +321,258 @@ namespace QuantLib {
             helper->setTermStructure(const_cast<Curve*>(ts_));
         }
 
+        if (!restoredData_.empty() && installRestoredState()) {
+            firstPillar_ = alive_+1;
+            lastRestored_ = true;
+        }
+
+        if (!lastRestored_ && incremental_ && validCurve_
+            && residuals_.size() == alive_+1)
+            lastIncremental_ = updateIncrementally();
+
+        if (!lastRestored_ && !lastIncremental_) {
+            firstPillar_ = 1;
+            validJacobian_ = false;
+            // there might be a valid curve state to use as guess
+            bootstrap(1, validCurve_);
+        }
+        validCurve_ = true;
+        // the nodes moved since the Jacobian was calculated
+        if (firstPillar_ <= alive_)
+            currentJacobian_ = false;
+
+        if (incremental_)
+            storeResiduals();
+
+        elapsedTime_ = Real(std::clock()-start)/CLOCKS_PER_SEC;
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::restore(
+                                    const std::vector<Date>& dates,
+                                    const std::vector<Real>& data,
+                                    const std::vector<Real>& quotes,
+                                    const std::vector<Real>& residuals) const {
+        QL_REQUIRE(!dates.empty(), "no nodes given");
+        QL_REQUIRE(data.size() == dates.size(),
+                   "mismatch between dates (" << dates.size() <<
+                   ") and data (" << data.size() << ")");
+        QL_REQUIRE(quotes.size() == dates.size()-1,
+                   "mismatch between helpers (" << dates.size()-1 <<
+                   ") and quotes (" << quotes.size() << ")");
+        QL_REQUIRE(residuals.size() == dates.size()-1,
+                   "mismatch between helpers (" << dates.size()-1 <<
+                   ") and residuals (" << residuals.size() << ")");
+        restoredDates_ = dates;
+        restoredData_ = data;
+        restoredQuotes_ = quotes;
+        restoredResiduals_ = residuals;
+        ts_->update();
+    }
+
+    template <class Curve>
+    bool IterativeBootstrap<Curve>::installRestoredState() const {
+        std::vector<Date> dates;
+        std::vector<Real> data, quotes, residuals;
+        dates.swap(restoredDates_);
+        data.swap(restoredData_);
+        quotes.swap(restoredQuotes_);
+        residuals.swap(restoredResiduals_);
+
+        if (dates != ts_->dates_)
+            return false;
+
+        ts_->data_ = data;
+        ts_->interpolation_ = ts_->interpolator_.interpolate(
+                                                    ts_->times_.begin(),
+                                                    ts_->times_.end(),
+                                                    ts_->data_.begin());
+        ts_->interpolation_.update();
+        validCurve_ = true;
+        validJacobian_ = false;
+        residuals_.resize(alive_+1);
+        residuals_[0] = 0.0;
+        std::copy(residuals.begin(), residuals.end(), residuals_.begin()+1);
+
+        // from here on, the state is at least a good guess
+        for (Size i=1; i<=alive_; ++i) {
+            if (errors_[i]->helper()->quote()->value() != quotes[i-1])
+                return false;
+        }
+        return maxResidualChange() <= ts_->accuracy_;
+    }
+
+    template <class Curve>
+    bool IterativeBootstrap<Curve>::updateIncrementally() const {
+        if (loopRequired_) {
+            std::vector<Real> data = ts_->data_;
+            try {
+                if (newtonUpdate())
+                    return true;
+                // the cached Jacobian might be stale; try a fresh one
+                if (jacobianCalculations_ == 0) {
+                    ts_->data_ = data;
+                    ts_->interpolation_.update();
+                    validJacobian_ = false;
+                    if (newtonUpdate())
+                        return true;
+                }
+            } catch (...) {}
+            // restore the previous state, which will be used as guess;
+            // the Jacobian failed to converge and is not reused
+            ts_->data_ = data;
+            ts_->interpolation_.update();
+            validJacobian_ = false;
+            return false;
+        }
+
+        // local interpolation: restart from the first changed helper,
+        // since each pillar only depends on the previous ones
+        Real accuracy = ts_->accuracy_;
+        firstPillar_ = alive_+1;
+        for (Size i=1; i<=alive_; ++i) {
+            Real change =
+                std::fabs(errors_[i]->helper()->quoteError()-residuals_[i]);
+            if (!(change <= accuracy)) {
+                firstPillar_ = i;
+                break;
+            }
+        }
+        if (firstPillar_ <= alive_) {
+            bootstrap(firstPillar_, true);
+            // a failure resets validCurve_ and forces a full bootstrap
+            if (!validCurve_)
+                return false;
+        }
+        return true;
+    }
+
+    template <class Curve>
+    bool IterativeBootstrap<Curve>::newtonUpdate() const {
+        Real accuracy = ts_->accuracy_;
+        std::vector<Real>& data = ts_->data_;
+
+        if (maxResidualChange() <= accuracy) {
+            firstPillar_ = alive_+1;
+            return true;
+        }
+
+        if (!validJacobian_)
+            calculateJacobian();
+
+        Array residuals(alive_), step(alive_);
+        Real previousChange = QL_MAX_REAL;
+        for (Size iteration=0; iteration<Traits::maxIterations(); ++iteration) {
+            for (Size k=0; k<alive_; ++k)
+                residuals[k] = errors_[k+1]->helper()->quoteError();
+            step = inverseJacobian_ * residuals;
+
+            Real change = 0.0;
+            for (Size i=0; i<alive_; ++i) {
+                Traits::updateGuess(data, data[i+1]+step[i], i+1);
+                change = std::max(change, std::fabs(step[i]));
+            }
+            ts_->interpolation_.update();
+            ++newtonSteps_;
+
+            if (change != change) // NaN
+                return false;
+            if (change <= accuracy)
+                return true;
+            if (change >= previousChange) // not converging
+                return false;
+            previousChange = change;
+        }
+        return false;
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::calculateJacobian() const {
+        std::vector<Real>& data = ts_->data_;
+        Matrix jacobian(alive_, alive_);
+        Array base(alive_);
+        for (Size k=0; k<alive_; ++k)
+            base[k] = errors_[k+1]->helper()->impliedQuote();
+        for (Size i=0; i<alive_; ++i) {
+            Real node = data[i+1];
+            Real h = 1.0e-6*std::max(std::fabs(node), 1.0e-2);
+            Traits::updateGuess(data, node+h, i+1);
+            ts_->interpolation_.update();
+            for (Size k=0; k<alive_; ++k)
+                jacobian[k][i] =
+                    (errors_[k+1]->helper()->impliedQuote()-base[k])/h;
+            Traits::updateGuess(data, node, i+1);
+        }
+        ts_->interpolation_.update();
+        inverseJacobian_ = inverse(jacobian);
+        validJacobian_ = currentJacobian_ = true;
+        ++jacobianCalculations_;
+    }
+
+    template <class Curve>
+    Disposable<Matrix> IterativeBootstrap<Curve>::nodeJacobian() const {
+        ts_->calculate();
+        if (!validJacobian_ || !currentJacobian_)
+            calculateJacobian();
+        Matrix result = inverseJacobian_;
+        return result;
+    }
+
+    template <class Curve>
+    std::vector<boost::shared_ptr<typename Curve::traits_type::helper> >
+    IterativeBootstrap<Curve>::aliveHelpers() const {
+        ts_->calculate();
+        return std::vector<boost::shared_ptr<typename Traits::helper> >(
+                                ts_->instruments_.begin()+firstAliveHelper_,
+                                ts_->instruments_.end());
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::setNode(Size i, Real value) const {
+        ts_->calculate();
+        QL_REQUIRE(i>0 && i<=alive_,
+                   "node " << i << " out of range [1, " << alive_ << "]");
+        Traits::updateGuess(ts_->data_, value, i);
+        ts_->interpolation_.update();
+        currentJacobian_ = false;
+        ts_->notifyObservers();
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::storeResiduals() const {
+        residuals_.resize(alive_+1);
+        residuals_[0] = 0.0;
+        for (Size i=1; i<=alive_; ++i)
+            residuals_[i] = errors_[i]->helper()->quoteError();
+    }
+
+    template <class Curve>
+    Real IterativeBootstrap<Curve>::maxResidualChange() const {
+        Real change = 0.0;
+        for (Size i=1; i<=alive_; ++i) {
+            Real c =
+                std::fabs(errors_[i]->helper()->quoteError()-residuals_[i]);
+            if (!(c <= change))
+                change = c;
+        }
+        return change;
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::bootstrap(Size firstPillar,
+                                              bool validData) const {
+
         const std::vector<Time>& times = ts_->times_;
         const std::vector<Real>& data = ts_->data_;
         Real accuracy = ts_->accuracy_;
 
         Size maxIterations = Traits::maxIterations()-1;
 
-        // there might be a valid curve state to use as guess
-        bool validData = validCurve_;
-
         for (Size iteration=0; ; ++iteration) {
+            ++iterations_;
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // bracket root and calculate guess
                 Real min = Traits::minValueAfter(i, ts_, validData,
@@ -258,7 +643,6 @@ namespace QuantLib {
 
             validData = true;
         }
-        validCurve_ = true;
     }
 
 }
@@ -57,7 +57,7 @@ namespace QuantLib {
     class SwaptionVolCube1x : public SwaptionVolatilityCube {
         class Cube {
           public:
-            Cube() {}
+            Cube() : nLayers_(0), extrapolation_(true), backwardFlat_(false) {}
             Cube(const std::vector<Date>& optionDates,
                  const std::vector<Period>& swapTenors,
                  const std::vector<Time>& optionTimes,
@@ -151,6 +151,29 @@ namespace QuantLib {
         Matrix marketVolCube() const;
         Matrix volCubeAtmCalibrated() const;
         //@}
+        //! \name Calibration settings
+        //@{
+        /*! sets the number of threads used to calibrate the nodes
+            of the cube.  The results don't depend on the number of
+            threads.
+
+            \warning the calibrations can only run in parallel if
+                     no optimization method was passed to the
+                     constructor, since the same method would be
+                     used concurrently by all the nodes; otherwise,
+                     they run serially.
+        */
+        void setThreads(Size threads);
+        Size threads() const { return threads_; }
+        /*! if enabled, the free parameters of each node are
+            calibrated starting from the values found at the last
+            calibration, instead of the guess quotes.  The quotes
+            are still used at the first calibration and after any
+            of them changes.
+        */
+        void enableWarmStart(bool b = true) { warmStart_ = b; }
+        bool warmStart() const { return warmStart_; }
+        //@}
         void sabrCalibrationSection(const Cube& marketVolCube,
                                     Cube& parametersCube,
                                     const Period& swapTenor) const;
@@ -169,7 +192,8 @@ namespace QuantLib {
                                     Time optionTime,
                                     Time swapLength,
                                     const Cube& sabrParametersCube) const;
-        Cube sabrCalibration(const Cube &marketVolCube) const;
+        Cube sabrCalibration(const Cube &marketVolCube,
+                             const Cube &lastParameters = Cube()) const;
         void fillVolatilityCube() const;
         void createSparseSmiles() const;
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
@@ -194,6 +218,9 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        Size threads_;
+        bool warmStart_;
+        mutable bool guessChanged_;
 
         class PrivateObserver : public Observer {
           public:
@@ -240,7 +267,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          threads_(1), warmStart_(false), guessChanged_(true) {
 
         if (maxErrorTolerance != Null<Rate>()) {
             maxErrorTolerance_ = maxErrorTolerance;
@@ -281,9 +309,16 @@ namespace QuantLib {
                         parametersGuessQuotes_[j+k*nOptionTenors_][i]->value());
                 }
         parametersGuess_.updateInterpolators();
+        guessChanged_ = true;
 
     }
 
+    template<class Model>
+    void SwaptionVolCube1x<Model>::setThreads(Size threads) {
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        threads_ = threads;
+    }
+
     template<class Model> void SwaptionVolCube1x<Model>::performCalculations() const {
 
         SwaptionVolatilityCube::performCalculations();
@@ -306,7 +341,13 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        // the last results are only used as guesses if the
+        // guess quotes didn't change since they were calculated
+        const Cube noParameters;
+        bool useLastParameters = warmStart_ && !guessChanged_;
+
+        sparseParameters_ = sabrCalibration(marketVolCube_,
+            useLastParameters ? sparseParameters_ : noParameters);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -314,9 +355,11 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                useLastParameters ? denseParameters_ : noParameters);
             denseParameters_.updateInterpolators();
         }
+        guessChanged_ = false;
     }
 
     template<class Model> void SwaptionVolCube1x<Model>::updateAfterRecalibration() {
@@ -331,7 +374,9 @@ namespace QuantLib {
 
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
-    SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                                      const Cube &marketVolCube,
+                                      const Cube &lastParameters) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -348,15 +393,49 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
+        // The forwards, shifts and guesses are taken from term
+        // structures and swap indexes, which are not thread safe;
+        // they are collected here, so that the calibrations below
+        // only work on data of their own.
+        const Size nSwapLengths = swapLengths.size();
+        const Size nodes = optionTimes.size()*nSwapLengths;
+        const bool useLastParameters = !lastParameters.optionTimes().empty();
+        std::vector<Real> shifts(nodes);
+        std::vector<std::vector<Real> > guesses(nodes);
         for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
+            for (Size k=0; k<nSwapLengths; k++) {
+                Size n = j*nSwapLengths+k;
+                forwards[j][k] = atmStrike(optionDates[j], swapTenors[k]);
+                shifts[n] = atmVol_->shift(optionTimes[j], swapLengths[k]);
+                guesses[n] = parametersGuess_.operator()(
+                    optionTimes[j], swapLengths[k]);
+                if (useLastParameters) {
+                    std::vector<Real> last = lastParameters(
+                        optionTimes[j], swapLengths[k]);
+                    for (Size i=0; i<4; i++)
+                        if (!isParameterFixed_[i])
+                            guesses[n][i] = last[i];
+                }
+            }
+        }
+
+        // a shared optimization method can't be used concurrently
+        const Size threads = optMethod_ ? 1 : threads_;
+        // not std::vector<bool>, whose elements can't be written
+        // concurrently
+        std::vector<char> failed(nodes, 0);
+        std::vector<std::string> failures(nodes);
+
+        #pragma omp parallel for num_threads(threads) schedule(dynamic) \
+                                 if(threads > 1)
+        for (Size n=0; n<nodes; n++) {
+            const Size j = n/nSwapLengths, k = n%nSwapLengths;
+            try {
+                Rate atmForward = forwards[j][k];
+                Real shiftTmp = shifts[n];
+                std::vector<Real> strikes, volatilities;
+                strikes.reserve(nStrikes_);
+                volatilities.reserve(nStrikes_);
                 for (Size i=0; i<nStrikes_; i++){
                     Real strike = atmForward+strikeSpreads_[i];
                     if(strike + shiftTmp >=cutoffStrike_) {
@@ -365,8 +444,7 @@ namespace QuantLib {
                     }
                 }
 
-                const std::vector<Real>& guess = parametersGuess_.operator()(
-                    optionTimes[j], swapLengths[k]);
+                const std::vector<Real>& guess = guesses[n];
 
                 const boost::shared_ptr<typename Model::Interpolation> sabrInterpolation =
                     boost::shared_ptr<typename Model::Interpolation>(new
@@ -394,7 +472,6 @@ namespace QuantLib {
                 betas      [j][k] = sabrInterpolation->beta();
                 nus        [j][k] = sabrInterpolation->nu();
                 rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
                 errors     [j][k] = rmsError;
                 maxErrors  [j][k] = maxError;
                 endCriteria[j][k] = sabrInterpolation->endCriteria();
@@ -425,9 +502,19 @@ namespace QuantLib {
                       (useMaxError_ ? ": error" : ": max error ") <<
                       (useMaxError_ ? rmsError :maxError)
                 );
-
+            } catch (std::exception& e) {
+                failed[n] = 1;
+                failures[n] = e.what();
+            } catch (...) {
+                failed[n] = 1;
+                failures[n] = "unknown error";
             }
         }
+
+        // the first failure is reported, as in a serial calibration
+        for (Size n=0; n<nodes; n++)
+            QL_REQUIRE(!failed[n], failures[n]);
+
         Cube sabrParametersCube(optionDates, swapTenors,
                                 optionTimes, swapLengths, 8,
                                 true, backwardFlat_);
@@ -167,6 +167,11 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Inspectors
+        //@{
+        //! the bootstrapper, e.g., for its calculation statistics
+        const Bootstrap<this_curve>& bootstrap() const { return bootstrap_; }
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -22,9 +22,158 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        Size bitCount(boost::uint64_t x) {
+            // the masks 0x5555..., 0x3333..., 0x0f0f... and 0x0101...
+            const boost::uint64_t ones = ~boost::uint64_t(0);
+            x = x - ((x >> 1) & (ones/3));
+            x = (x & (ones/5)) + ((x >> 2) & (ones/5));
+            x = (x + (x >> 4)) & (ones/17);
+            return Size((x * (ones/255)) >> 56);
+        }
+
+        // business days in positions [from, to] of a block
+        Size bitCount(const boost::uint64_t* days, Size from, Size to) {
+            Size n = 0;
+            for (Size w = from/64; w <= to/64; ++w) {
+                boost::uint64_t x = days[w];
+                if (w == from/64)
+                    x &= ~boost::uint64_t(0) << (from%64);
+                if (w == to/64 && to%64 != 63)
+                    x &= (boost::uint64_t(1) << (to%64 + 1)) - 1;
+                n += bitCount(x);
+            }
+            return n;
+        }
+
+        bool isSet(const boost::uint64_t* days, Size i) {
+            return ((days[i/64] >> (i%64)) & 1) != 0;
+        }
+
+    }
+
+    const Size Calendar::daysPerBlock;
+
+    // the blocks of an implementation are valid if their generation
+    // equals this one
+    boost::atomic<Size> Calendar::cacheGeneration_(1);
+
+    void Calendar::invalidateCache() {
+        ++cacheGeneration_;
+    }
+
+    Calendar::Impl::Impl() {
+        const Size blocks =
+            Size(Date::maxDate().serialNumber())/daysPerBlock + 1;
+        cache.reset(new boost::atomic<CacheBlock*>[blocks]);
+        for (Size i=0; i<blocks; ++i)
+            cache[i].store(0, boost::memory_order_relaxed);
+        retired.store(0, boost::memory_order_relaxed);
+    }
+
+    Calendar::Impl::~Impl() {
+        const Size blocks =
+            Size(Date::maxDate().serialNumber())/daysPerBlock + 1;
+        for (Size i=0; i<blocks; ++i)
+            delete cache[i].load(boost::memory_order_relaxed);
+        CacheBlock* b = retired.load(boost::memory_order_relaxed);
+        while (b != 0) {
+            CacheBlock* next = b->nextRetired;
+            delete b;
+            b = next;
+        }
+    }
+
+    const Calendar::Impl::CacheBlock&
+    Calendar::fillCacheBlock(Size block) const {
+        static const BigInteger minSerial = Date::minDate().serialNumber(),
+                                maxSerial = Date::maxDate().serialNumber();
+
+        // The generation is read first, so that the block is marked
+        // as stale if the holidays change during the calculation.
+        const Size generation =
+            cacheGeneration_.load(boost::memory_order_relaxed);
+
+        // Concurrent threads might calculate the same block; only
+        // one of them publishes it, and the others use it.
+        Size businessDays = 0;
+        boost::uint64_t days[8] = {};
+        BigInteger first = BigInteger(block*daysPerBlock);
+        for (Size i=0; i<daysPerBlock; ++i) {
+            BigInteger serial = first + BigInteger(i);
+            if (serial < minSerial || serial > maxSerial)
+                continue;
+            Date d(serial);
+            bool businessDay;
+            if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
+                businessDay = false;
+            else if (impl_->removedHolidays.find(d)
+                     != impl_->removedHolidays.end())
+                businessDay = true;
+            else
+                businessDay = impl_->isBusinessDay(d);
+            if (businessDay) {
+                days[i/64] |= boost::uint64_t(1) << (i%64);
+                ++businessDays;
+            }
+        }
+
+        Impl::CacheBlock* filled = new Impl::CacheBlock;
+        std::copy(days, days+8, filled->days);
+        filled->businessDays = businessDays;
+        filled->generation = generation;
+        filled->nextRetired = 0;
+
+        Impl::CacheBlock* cached =
+            impl_->cache[block].load(boost::memory_order_acquire);
+        do {
+            if (cached != 0 && cached->generation == generation) {
+                // another thread published it first
+                delete filled;
+                return *cached;
+            }
+        } while (!impl_->cache[block].compare_exchange_strong(
+                                             cached, filled,
+                                             boost::memory_order_release,
+                                             boost::memory_order_acquire));
+
+        if (cached != 0) {
+            // the stale block might still be read by the threads
+            // that found it; it's deleted with the implementation
+            Impl::CacheBlock* head =
+                impl_->retired.load(boost::memory_order_relaxed);
+            do {
+                cached->nextRetired = head;
+            } while (!impl_->retired.compare_exchange_weak(
+                                             head, cached,
+                                             boost::memory_order_release,
+                                             boost::memory_order_relaxed));
+        }
+        return *filled;
+    }
+
+    Size Calendar::businessDaysIn(BigInteger from, BigInteger to) const {
+        // business days between the given serial numbers, included
+        Size n = 0;
+        Size first = Size(from)/daysPerBlock, last = Size(to)/daysPerBlock;
+        for (Size k = first; k <= last; ++k) {
+            const Impl::CacheBlock& b =
+                cacheBlock(BigInteger(k*daysPerBlock));
+            Size i = (k == first ? Size(from)%daysPerBlock : 0);
+            Size j = (k == last ? Size(to)%daysPerBlock : daysPerBlock-1);
+            if (i == 0 && j == daysPerBlock-1)
+                n += b.businessDays;
+            else
+                n += bitCount(b.days, i, j);
+        }
+        return n;
+    }
+
     void Calendar::addHoliday(const Date& d) {
         // if d was a genuine holiday previously removed, revert the change
         impl_->removedHolidays.erase(d);
@@ -32,6 +181,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        invalidateCache();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -41,6 +191,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        invalidateCache();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -97,23 +248,50 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
-            Date d1 = d;
+            // whole blocks are skipped using their count of business
+            // days; the result is then looked for in the last one
+            BigInteger serial = d.serialNumber();
+            Size k = Size(serial)/daysPerBlock, i = Size(serial)%daysPerBlock;
             if (n > 0) {
-                while (n > 0) {
-                    d1++;
-                    while (isHoliday(d1))
-                        d1++;
-                    n--;
+                Size m = n;
+                for (;;) {
+                    const Impl::CacheBlock& b =
+                        cacheBlock(BigInteger(k*daysPerBlock));
+                    Size available = (i == daysPerBlock-1 ? 0 :
+                                      bitCount(b.days, i+1, daysPerBlock-1));
+                    if (m <= available) {
+                        while (m > 0)
+                            if (isSet(b.days, ++i))
+                                --m;
+                        break;
+                    }
+                    m -= available;
+                    // this throws past the maximum date, as the
+                    // day-by-day loop did
+                    Date(BigInteger((k+1)*daysPerBlock));
+                    ++k;
+                    i = Size(-1);
                 }
             } else {
-                while (n < 0) {
-                    d1--;
-                    while(isHoliday(d1))
-                        d1--;
-                    n++;
+                Size m = -n;
+                for (;;) {
+                    const Impl::CacheBlock& b =
+                        cacheBlock(BigInteger(k*daysPerBlock));
+                    Size available = (i == 0 ? 0 : bitCount(b.days, 0, i-1));
+                    if (m <= available) {
+                        while (m > 0)
+                            if (isSet(b.days, --i))
+                                --m;
+                        break;
+                    }
+                    m -= available;
+                    // this throws before the minimum date
+                    Date(BigInteger(k*daysPerBlock) - 1);
+                    --k;
+                    i = daysPerBlock;
                 }
             }
-            return d1;
+            return Date(BigInteger(k*daysPerBlock + i));
         } else if (unit == Weeks) {
             Date d1 = d + n*unit;
             return adjust(d1,c);
@@ -141,23 +319,10 @@ namespace QuantLib {
                                              bool includeLast) const {
         BigInteger wd = 0;
         if (from != to) {
-            if (from < to) {
-                // the last one is treated separately to avoid
-                // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(from))
-                    ++wd;
-            }
+            if (from < to)
+                wd = businessDaysIn(from.serialNumber(), to.serialNumber());
+            else
+                wd = businessDaysIn(to.serialNumber(), from.serialNumber());
 
             if (isBusinessDay(from) && !includeFirst)
                 wd--;
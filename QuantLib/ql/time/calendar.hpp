@@ -29,6 +29,9 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <set>
 #include <vector>
 #include <string>
@@ -49,24 +52,64 @@ namespace QuantLib {
         or for general country holiday schedule. Legacy city holiday schedule
         calendars will be moved to the exchange/country convention.
 
+        Business days are cached as bitmaps over blocks of dates,
+        which are allocated and filled on demand; after the first
+        query in a block, checking a date in it takes a bit test,
+        and counting or advancing over business days takes a few
+        operations per block instead of one call per day.
+
+        \warning Calendars can be queried concurrently; however,
+                 holidays must not be added or removed (and the
+                 weekend of a BespokeCalendar must not be changed)
+                 while other threads are using any calendar.
+
         \ingroup datetime
 
         \test the methods for adding and removing holidays are tested
               by inspecting the calendar before and after their
               invocation.
+
+        \test the cached business days are checked against the
+              ones returned by the calendar implementation.
     */
     class Calendar {
       protected:
         //! abstract base class for calendar implementations
+        /*! \warning the results of isBusinessDay are cached; an
+                     implementation whose holidays can change after
+                     its construction must call
+                     Calendar::invalidateCache when they do.
+        */
         class Impl {
           public:
-            virtual ~Impl() {}
+            Impl();
+            virtual ~Impl();
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            //! business days in a block of dates, one bit per day
+            /*! Blocks are not modified once published; a stale
+                block is replaced by a new one and kept in the list
+                of retired blocks until the implementation is
+                destroyed, since other threads might still read it.
+            */
+            struct CacheBlock {
+                Size generation;
+                Size businessDays;
+                boost::uint64_t days[8];
+                CacheBlock* nextRetired;
+            };
+            //! one pointer per block; blocks are allocated when used
+            boost::scoped_array<boost::atomic<CacheBlock*> > cache;
+            boost::atomic<CacheBlock*> retired;
         };
         boost::shared_ptr<Impl> impl_;
+        /*! Invalidates the cached business days of all calendars;
+            to be called when the holidays of an implementation
+            change.  Adding or removing a holiday does it already.
+        */
+        static void invalidateCache();
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -167,6 +210,13 @@ namespace QuantLib {
             //! expressed relative to first day of year
             static Day easterMonday(Year);
         };
+      private:
+        // blocks are indexed by serial number divided by their size
+        static const Size daysPerBlock = 512;
+        static boost::atomic<Size> cacheGeneration_;
+        const Impl::CacheBlock& cacheBlock(BigInteger serialNumber) const;
+        const Impl::CacheBlock& fillCacheBlock(Size block) const;
+        Size businessDaysIn(BigInteger from, BigInteger to) const;
     };
 
     /*! Returns <tt>true</tt> iff the two calendars belong to the same
@@ -192,12 +242,25 @@ namespace QuantLib {
         return impl_->name();
     }
 
+    inline const Calendar::Impl::CacheBlock&
+    Calendar::cacheBlock(BigInteger serialNumber) const {
+        Size block = Size(serialNumber)/daysPerBlock;
+        // the acquire load pairs with the release exchange in
+        // fillCacheBlock, so that the days are seen once published
+        const Impl::CacheBlock* b =
+            impl_->cache[block].load(boost::memory_order_acquire);
+        if (b == 0
+            || b->generation
+               != cacheGeneration_.load(boost::memory_order_relaxed))
+            return fillCacheBlock(block);
+        return *b;
+    }
+
     inline bool Calendar::isBusinessDay(const Date& d) const {
-        if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
-            return false;
-        if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
-            return true;
-        return impl_->isBusinessDay(d);
+        BigInteger serial = d.serialNumber();
+        const Impl::CacheBlock& b = cacheBlock(serial);
+        Size i = Size(serial) % daysPerBlock;
+        return ((b.days[i/64] >> (i%64)) & 1) != 0;
     }
 
     inline bool Calendar::isEndOfMonth(const Date& d) const {
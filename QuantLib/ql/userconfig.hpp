@@ -47,6 +47,13 @@
 //#   define QL_ENABLE_TRACING
 #endif
 
+/* Define this if calculations and notifications should be profiled
+   (whether they are actually recorded will depend on run-time
+   settings.) */
+#ifndef QL_ENABLE_PROFILING
+//#   define QL_ENABLE_PROFILING
+#endif
+
 /* Define this if negative rates should be allowed. */
 #ifndef QL_NEGATIVE_RATES
 #   define QL_NEGATIVE_RATES
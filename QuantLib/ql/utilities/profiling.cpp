@@ -0,0 +1,157 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/profiling.hpp>
+#include <ql/errors.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105600
+#include <boost/core/demangle.hpp>
+#endif
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+namespace QuantLib {
+
+    namespace {
+
+        std::string className(const std::type_info& type) {
+            #if BOOST_VERSION >= 105600
+            return boost::core::demangle(type.name());
+            #else
+            return type.name();
+            #endif
+        }
+
+        std::string eventName(Profiler::Event event) {
+            switch (event) {
+              case Profiler::Calculation:
+                return "calculation";
+              case Profiler::EngineCalculation:
+                return "engine";
+              case Profiler::Notification:
+                return "notification";
+              default:
+                QL_FAIL("unknown profiled event");
+            }
+        }
+
+        struct ProfileLine {
+            std::string event, name;
+            Profiler::Entry entry;
+        };
+
+        bool longerTime(const ProfileLine& l1, const ProfileLine& l2) {
+            return l1.entry.time > l2.entry.time;
+        }
+
+    }
+
+    Profiler::Profiler() : enabled_(false) {}
+
+    void Profiler::enable() {
+        #if defined(QL_ENABLE_PROFILING)
+        enabled_ = true;
+        #else
+        QL_FAIL("profiling support not available");
+        #endif
+    }
+
+    void Profiler::reset() {
+        #pragma omp critical(ql_profiler)
+        {
+            entries_.clear();
+            dependencies_.clear();
+        }
+    }
+
+    void Profiler::add(Event event,
+                       const std::type_info& type,
+                       Real time,
+                       const std::vector<const std::type_info*>& observers) {
+        #pragma omp critical(ql_profiler)
+        {
+            Entry& e = entries_[std::make_pair(event, Key(type))];
+            ++e.count;
+            e.time += time;
+            e.maxTime = std::max(e.maxTime, time);
+            e.observers += observers.size();
+            for (Size i=0; i<observers.size(); ++i)
+                ++dependencies_[std::make_pair(Key(type),
+                                               Key(*observers[i]))];
+        }
+    }
+
+    Profiler::Entry Profiler::entry(Event event,
+                                    const std::string& name) const {
+        std::map<std::pair<Event,Key>, Entry>::const_iterator i;
+        for (i=entries_.begin(); i!=entries_.end(); ++i) {
+            if (i->first.first == event &&
+                className(i->first.second.type()) == name)
+                return i->second;
+        }
+        return Entry();
+    }
+
+    void Profiler::dumpProfile(std::ostream& out) const {
+        std::vector<ProfileLine> lines;
+        std::map<std::pair<Event,Key>, Entry>::const_iterator i;
+        for (i=entries_.begin(); i!=entries_.end(); ++i) {
+            ProfileLine line;
+            line.event = eventName(i->first.first);
+            line.name = className(i->first.second.type());
+            line.entry = i->second;
+            lines.push_back(line);
+        }
+        std::stable_sort(lines.begin(), lines.end(), longerTime);
+
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::setw(14) << std::left << "event"
+            << std::setw(10) << std::right << "count"
+            << std::setw(14) << "time [s]"
+            << std::setw(14) << "average [s]"
+            << std::setw(14) << "max [s]"
+            << std::setw(12) << "observers"
+            << "  class" << std::endl;
+        for (Size j=0; j<lines.size(); ++j) {
+            const Entry& e = lines[j].entry;
+            out << std::setw(14) << std::left << lines[j].event
+                << std::setw(10) << std::right << e.count
+                << std::fixed << std::setprecision(6)
+                << std::setw(14) << e.time
+                << std::setw(14) << e.time/e.count
+                << std::setw(14) << e.maxTime
+                << std::setw(12) << e.observers
+                << "  " << lines[j].name << std::endl;
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    void Profiler::dumpGraph(std::ostream& out) const {
+        out << "digraph dependencies {" << std::endl;
+        std::map<std::pair<Key,Key>, Size>::const_iterator i;
+        for (i=dependencies_.begin(); i!=dependencies_.end(); ++i) {
+            out << "    \"" << className(i->first.first.type()) << "\" -> \""
+                << className(i->first.second.type()) << "\""
+                << " [label=\"" << i->second << "\"];" << std::endl;
+        }
+        out << "}" << std::endl;
+    }
+
+}
@@ -0,0 +1,171 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file profiling.hpp
+    \brief profiling of calculations and notifications
+*/
+
+#ifndef quantlib_profiling_hpp
+#define quantlib_profiling_hpp
+
+#include <ql/types.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include <map>
+#include <string>
+#include <iosfwd>
+
+namespace QuantLib {
+
+    //! profile of the calculations and notifications in the library
+    /*! If the library is compiled with QL_ENABLE_PROFILING defined
+        (see the --enable-profiling switch of the configure script)
+        and the profiler is enabled at run time, the following
+        events are recorded, grouped by the actual class of the
+        object involved:
+        - the calculations of lazy objects, with their number and
+          wall-clock time;
+        - the calculations of the pricing engines of instruments,
+          ditto;
+        - the notifications sent by observables, with their number
+          and time and the number of observers notified.  The
+          classes of the notified observers are also recorded and
+          can be exported as a dependency graph.
+
+        Times include those of nested calculations and
+        notifications; e.g., the time taken to bootstrap a curve is
+        also included in that of the instrument whose calculation
+        triggered it.
+
+        If QL_ENABLE_PROFILING is not defined, no profiling code is
+        compiled in the library and the profiler can't be enabled.
+
+        \warning the recorded data are shared by the OpenMP threads
+                 through a critical section; other threads should
+                 not calculate or notify while profiling.  When the
+                 thread-safe observer pattern is enabled,
+                 notifications are recorded without their observers.
+    */
+    class Profiler : public Singleton<Profiler> {
+        friend class Singleton<Profiler>;
+      private:
+        Profiler();
+      public:
+        enum Event { Calculation, EngineCalculation, Notification };
+        //! data recorded for a given class and event
+        struct Entry {
+            Entry() : count(0), time(0.0), maxTime(0.0), observers(0) {}
+            Size count;
+            //! total and maximum wall-clock time in seconds
+            Real time, maxTime;
+            //! total number of observers notified
+            Size observers;
+        };
+        //! \name Settings
+        //@{
+        void enable();
+        void disable() { enabled_ = false; }
+        bool enabled() const { return enabled_; }
+        //! clears the recorded data
+        void reset();
+        //@}
+        //! \name Inspectors
+        //@{
+        /*! returns the data recorded for the given event and class,
+            or an empty entry if none was recorded.  The class name
+            must be given in full, e.g., "QuantLib::FlatForward".
+        */
+        Entry entry(Event event, const std::string& className) const;
+        /*! writes a flat profile, i.e., a line for each class and
+            event, sorted by decreasing total time.
+        */
+        void dumpProfile(std::ostream& out) const;
+        /*! writes the dependency graph in the Graphviz dot format;
+            each edge goes from the class of a notifying observable
+            to the class of a notified observer, and is labeled with
+            the number of notifications sent.
+        */
+        void dumpGraph(std::ostream& out) const;
+        //@}
+        //! \name Recording
+        //@{
+        void add(Event event,
+                 const std::type_info& type,
+                 Real time,
+                 const std::vector<const std::type_info*>& observers =
+                                     std::vector<const std::type_info*>());
+        //@}
+      private:
+        // orders classes as the implementation does
+        class Key {
+          public:
+            explicit Key(const std::type_info& type) : type_(&type) {}
+            const std::type_info& type() const { return *type_; }
+            bool operator<(const Key& other) const {
+                return type_->before(*other.type_) != 0;
+            }
+          private:
+            const std::type_info* type_;
+        };
+        bool enabled_;
+        std::map<std::pair<Event,Key>, Entry> entries_;
+        std::map<std::pair<Key,Key>, Size> dependencies_;
+    };
+
+
+    namespace detail {
+
+        //! records the event taking place during its lifetime
+        class ProfiledScope {
+          public:
+            ProfiledScope(Profiler::Event event, const std::type_info& type)
+            : enabled_(Profiler::instance().enabled()),
+              event_(event), type_(type) {
+                if (enabled_)
+                    start_ = boost::posix_time::microsec_clock::
+                                                        universal_time();
+            }
+            ~ProfiledScope() {
+                if (enabled_) {
+                    Real time =
+                        (boost::posix_time::microsec_clock::universal_time()
+                         - start_).total_microseconds() * 1.0e-6;
+                    Profiler::instance().add(event_, type_, time,
+                                             observers_);
+                }
+            }
+            void addObserver(const std::type_info& type) {
+                if (enabled_)
+                    observers_.push_back(&type);
+            }
+          private:
+            bool enabled_;
+            Profiler::Event event_;
+            const std::type_info& type_;
+            boost::posix_time::ptime start_;
+            std::vector<const std::type_info*> observers_;
+        };
+
+    }
+
+}
+
+
+#endif
@@ -117,6 +117,128 @@ void BlackFormulaTest::testChambersImpliedVol() {
     }
 }
 
+void BlackFormulaTest::testBatchFormulas() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black and Bachelier formulas...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0000, 0.0050, 0.0200};
+    Real forwards[] = {-0.0010, 0.0050, 0.0200, 0.0500, 1.0, 100.0};
+    Real moneyness[] = {0.5, 0.8, 0.95, 1.0, 1.05, 1.25, 2.0};
+    Real stdDevs[] = {0.01, 0.05, 0.10, 0.20, 0.50, 1.00, 2.00};
+    Real discounts[] = {1.00, 0.95, 0.80};
+
+    for (Size i2 = 0; i2 < LENGTH(displacements); ++i2) {
+        Real displacement = displacements[i2];
+
+        std::vector<Option::Type> t;
+        std::vector<Real> k, f, s, d;
+        for (Size i1 = 0; i1 < LENGTH(types); ++i1) {
+            for (Size i3 = 0; i3 < LENGTH(forwards); ++i3) {
+                if (forwards[i3] + displacement <= 0.0)
+                    continue;
+                for (Size i4 = 0; i4 < LENGTH(moneyness); ++i4) {
+                    for (Size i5 = 0; i5 < LENGTH(stdDevs); ++i5) {
+                        for (Size i6 = 0; i6 < LENGTH(discounts); ++i6) {
+                            t.push_back(types[i1]);
+                            k.push_back(moneyness[i4]*
+                                        (forwards[i3]+displacement)
+                                        - displacement);
+                            f.push_back(forwards[i3]);
+                            s.push_back(stdDevs[i5]);
+                            d.push_back(discounts[i6]);
+                        }
+                    }
+                }
+            }
+        }
+        const Size n = t.size();
+
+        std::vector<Real> prices = blackFormula(t, k, f, s, d, displacement);
+        std::vector<Real> vegas =
+            blackFormulaStdDevDerivative(k, f, s, d, displacement);
+        std::vector<Real> bachelierPrices = bachelierBlackFormula(t, k, f, s, d);
+        std::vector<Real> bachelierVegas =
+            bachelierBlackFormulaStdDevDerivative(k, f, s, d);
+
+        for (Size i=0; i<n; ++i) {
+            Real price = blackFormula(t[i], k[i], f[i], s[i], d[i],
+                                      displacement);
+            Real vega = blackFormulaStdDevDerivative(k[i], f[i], s[i], d[i],
+                                                     displacement);
+            Real bachelierPrice = bachelierBlackFormula(t[i], k[i], f[i],
+                                                        s[i], d[i]);
+            Real bachelierVega = bachelierBlackFormulaStdDevDerivative(
+                                                  k[i], f[i], s[i], d[i]);
+            if (prices[i] != price || vegas[i] != vega
+                || bachelierPrices[i] != bachelierPrice
+                || bachelierVegas[i] != bachelierVega)
+                BOOST_ERROR("batch results differ from scalar ones for "
+                            << t[i]
+                            << std::setprecision(16)
+                            << "\n    displacement: " << displacement
+                            << "\n    forward:      " << f[i]
+                            << "\n    strike:       " << k[i]
+                            << "\n    std. dev.:    " << s[i]
+                            << "\n    discount:     " << d[i]
+                            << "\n    Black price:  " << prices[i]
+                            << " vs " << price
+                            << "\n    Black vega:   " << vegas[i]
+                            << " vs " << vega
+                            << "\n    Bachelier price: " << bachelierPrices[i]
+                            << " vs " << bachelierPrice
+                            << "\n    Bachelier vega:  " << bachelierVegas[i]
+                            << " vs " << bachelierVega);
+        }
+
+        // implied standard deviations, where the price is not too
+        // small to determine them
+        std::vector<Option::Type> ti;
+        std::vector<Real> ki, fi, pi, di, si;
+        for (Size i=0; i<n; ++i) {
+            if (vegas[i] > 1.0e-4*d[i]*(f[i]+displacement)) {
+                ti.push_back(t[i]);
+                ki.push_back(k[i]);
+                fi.push_back(f[i]);
+                pi.push_back(prices[i]);
+                di.push_back(d[i]);
+                si.push_back(s[i]);
+            }
+        }
+
+        const Real accuracy = 1.0e-8;
+        std::vector<Real> impliedStdDevs =
+            blackFormulaImpliedStdDev(ti, ki, fi, pi, di, displacement,
+                                      accuracy);
+        for (Size i=0; i<ti.size(); ++i) {
+            Real expected = blackFormulaImpliedStdDev(
+                                ti[i], ki[i], fi[i], pi[i], di[i],
+                                displacement, Null<Real>(), accuracy);
+            if (std::fabs(impliedStdDevs[i] - expected) > 2.0*accuracy
+                || std::fabs(impliedStdDevs[i] - si[i]) > 1.0e-6)
+                BOOST_ERROR("failed to reproduce implied std. dev. for "
+                            << ti[i]
+                            << std::setprecision(16)
+                            << "\n    displacement: " << displacement
+                            << "\n    forward:      " << fi[i]
+                            << "\n    strike:       " << ki[i]
+                            << "\n    discount:     " << di[i]
+                            << "\n    price:        " << pi[i]
+                            << "\n    std. dev.:    " << si[i]
+                            << "\n    batch:        " << impliedStdDevs[i]
+                            << "\n    scalar:       " << expected);
+        }
+    }
+
+    // wrong sizes are detected
+    BOOST_CHECK_THROW(blackFormula(std::vector<Option::Type>(2, Option::Call),
+                                   std::vector<Real>(2, 1.0),
+                                   std::vector<Real>(2, 1.0),
+                                   std::vector<Real>(1, 0.2),
+                                   std::vector<Real>(2, 1.0)),
+                      Error);
+}
+
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -124,6 +246,8 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testChambersImpliedVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchFormulas));
 
     return suite;
 }
@@ -1118,6 +1118,96 @@ void CalendarTest::testBespokeCalendars() {
 
 }
 
+namespace {
+
+    void checkCachedBusinessDays(const Calendar& c,
+                                 const Date& first, const Date& last) {
+        // counting and advancing work on whole blocks of dates;
+        // they're checked against day-by-day loops on isBusinessDay
+        std::vector<Date> businessDays;
+        for (Date d = first; d <= last; ++d) {
+            if (c.isBusinessDay(d))
+                businessDays.push_back(d);
+        }
+        QL_REQUIRE(businessDays.size() > 2, "too few business days");
+
+        BigInteger n = c.businessDaysBetween(first, last, true, true);
+        if (n != BigInteger(businessDays.size()))
+            BOOST_ERROR(c.name() << ": " << n << " business days"
+                        " calculated between " << first << " and " << last
+                        << "\n    expected: " << businessDays.size());
+        n = c.businessDaysBetween(last, first, false, false);
+        BigInteger expected = BigInteger(businessDays.size())
+            - (c.isBusinessDay(first) ? 1 : 0)
+            - (c.isBusinessDay(last) ? 1 : 0);
+        if (n != -expected)
+            BOOST_ERROR(c.name() << ": " << n << " business days"
+                        " calculated between " << last << " and " << first
+                        << "\n    expected: " << -expected);
+
+        Date start = businessDays.front(), end = businessDays.back();
+        Integer total = Integer(businessDays.size()) - 1;
+        for (Integer i=1; i<=total; i+=std::max<Integer>(1,total/97)) {
+            Date d = c.advance(start, i, Days);
+            if (d != businessDays[i])
+                BOOST_ERROR(c.name() << ": advancing " << start << " by "
+                            << i << " business days"
+                            << "\n    calculated: " << d
+                            << "\n    expected:   " << businessDays[i]);
+            d = c.advance(end, -i, Days);
+            if (d != businessDays[total-i])
+                BOOST_ERROR(c.name() << ": advancing " << end << " by "
+                            << -i << " business days"
+                            << "\n    calculated: " << d
+                            << "\n    expected:   " << businessDays[total-i]);
+        }
+    }
+
+}
+
+void CalendarTest::testCachedBusinessDays() {
+
+    BOOST_TEST_MESSAGE("Testing cached business days...");
+
+    Date first(3, January, 1995), last(28, December, 2013);
+
+    checkCachedBusinessDays(TARGET(), first, last);
+    checkCachedBusinessDays(UnitedKingdom(UnitedKingdom::Exchange),
+                            first, last);
+    checkCachedBusinessDays(UnitedStates(UnitedStates::NYSE), first, last);
+    checkCachedBusinessDays(TARGET(), Date::minDate(), Date::maxDate()-1);
+
+    // the cache must follow changes in the holidays of a calendar...
+    UnitedStates us(UnitedStates::Settlement);
+    JointCalendar joint(TARGET(), us);
+    checkCachedBusinessDays(joint, first, last);
+    Date d(7, March, 2005);
+    us.addHoliday(d);
+    if (joint.isBusinessDay(d))
+        BOOST_ERROR(d << " (added to " << us.name() << ") not detected "
+                    "as holiday in " << joint.name());
+    checkCachedBusinessDays(joint, first, last);
+    us.removeHoliday(d);
+    if (!joint.isBusinessDay(d))
+        BOOST_ERROR(d << " (removed from " << us.name() << ") "
+                    "erroneously detected as holiday in " << joint.name());
+    checkCachedBusinessDays(joint, first, last);
+
+    // ...and in its weekend
+    BespokeCalendar bespoke;
+    checkCachedBusinessDays(bespoke, first, last);
+    bespoke.addWeekend(Wednesday);
+    if (bespoke.isBusinessDay(Date(9, March, 2005)))
+        BOOST_ERROR("Wednesday not detected as weekend");
+    checkCachedBusinessDays(bespoke, first, last);
+
+    // advancing past the range of valid dates must fail
+    BOOST_CHECK_THROW(TARGET().advance(Date::maxDate() - 5, 10, Days),
+                      Error);
+    BOOST_CHECK_THROW(TARGET().advance(Date::minDate() + 5, -10, Days),
+                      Error);
+}
+
 test_suite* CalendarTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -1150,6 +1240,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testCachedBusinessDays));
 
     return suite;
 }
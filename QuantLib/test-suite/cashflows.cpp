@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -27,7 +28,10 @@
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/settings.hpp>
@@ -264,6 +268,157 @@ void CashFlowsTest::testNullFixingDays() {
         .withFixingDays(Null<Natural>());
 }
 
+void CashFlowsTest::testCompiledLeg() {
+    BOOST_TEST_MESSAGE("Testing compiled legs against cash-flow functions...");
+
+    SavedSettings backup;
+
+    Date today(15, May, 2015);
+    Settings::instance().evaluationDate() = today;
+    Date settlement = TARGET().advance(today, 2, Days);
+
+    Handle<YieldTermStructure> curve(
+        flatRate(today, 0.03, Actual365Fixed()));
+    boost::shared_ptr<YieldTermStructure> discountCurve(
+        new FlatForward(today, 0.025, Actual360(), Compounded, Annual));
+    discountCurve->enableExtrapolation();
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-3*Months).to(today+10*Years-3*Months)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Following)
+        .backwards();
+
+    std::vector<Leg> legs;
+    legs.push_back(FixedRateLeg(schedule)
+                   .withNotionals(100.0)
+                   .withCouponRates(0.04, Thirty360())
+                   .withExCouponPeriod(10*Days, TARGET(), Following));
+    legs.back().push_back(boost::shared_ptr<CashFlow>(
+                    new SimpleCashFlow(100.0, schedule.dates().back())));
+    boost::shared_ptr<IborIndex> index(new USDLibor(6*Months, curve));
+    index->addFixing(index->fixingDate(schedule.dates()[0]), 0.02);
+    legs.push_back(IborLeg(schedule, index)
+                   .withNotionals(100.0)
+                   .withSpreads(0.001));
+    setCouponPricer(legs.back(), boost::shared_ptr<FloatingRateCouponPricer>(
+                                                  new BlackIborCouponPricer));
+    legs.back().push_back(boost::shared_ptr<CashFlow>(
+                    new SimpleCashFlow(100.0, schedule.dates().back())));
+
+    Real tolerance = 1.0e-12;
+    InterestRate y(0.035, ActualActual(ActualActual::Bond),
+                   Compounded, Semiannual);
+
+    for (Size i=0; i<legs.size(); ++i) {
+        for (Integer include=0; include<2; ++include) {
+            CompiledLeg compiled(legs[i], include, settlement);
+
+            Real expected = CashFlows::npv(legs[i], **curve, include,
+                                           settlement);
+            Real calculated = compiled.npv(**curve);
+            if (std::fabs(expected-calculated) > tolerance*expected)
+                BOOST_ERROR("npv on curve for leg " << i << ":"
+                            << "\n    compiled:  " << calculated
+                            << "\n    expected:  " << expected);
+
+            expected = CashFlows::bps(legs[i], **curve, include,
+                                      settlement);
+            calculated = compiled.bps(**curve);
+            if (std::fabs(expected-calculated) > tolerance*expected)
+                BOOST_ERROR("bps on curve for leg " << i << ":"
+                            << "\n    compiled:  " << calculated
+                            << "\n    expected:  " << expected);
+
+            expected = CashFlows::npv(legs[i], y, include, settlement);
+            calculated = compiled.npv(y);
+            if (std::fabs(expected-calculated) > tolerance*expected)
+                BOOST_ERROR("npv at yield for leg " << i << ":"
+                            << "\n    compiled:  " << calculated
+                            << "\n    expected:  " << expected);
+
+            Real price = 0.97*expected;
+            Rate irr = compiled.yield(price, y.dayCounter(),
+                                      y.compounding(), y.frequency());
+            calculated = CashFlows::npv(legs[i],
+                                        InterestRate(irr, y.dayCounter(),
+                                                     y.compounding(),
+                                                     y.frequency()),
+                                        include, settlement);
+            if (std::fabs(price-calculated) > 1.0e-6)
+                BOOST_ERROR("yield for leg " << i << ":"
+                            << "\n    yield:     " << irr
+                            << "\n    npv:       " << calculated
+                            << "\n    expected:  " << price);
+
+            expected = CashFlows::npv(legs[i], discountCurve, 0.01,
+                                      Actual365Fixed(), Continuous,
+                                      NoFrequency, include, settlement);
+            calculated = compiled.npv(discountCurve, 0.01,
+                                      Actual365Fixed(), Continuous,
+                                      NoFrequency);
+            if (std::fabs(expected-calculated) > tolerance*expected)
+                BOOST_ERROR("npv with z-spread for leg " << i << ":"
+                            << "\n    compiled:  " << calculated
+                            << "\n    expected:  " << expected);
+
+            Spread z = compiled.zSpread(price, discountCurve,
+                                        Actual365Fixed(), Continuous,
+                                        NoFrequency);
+            calculated = CashFlows::npv(legs[i], discountCurve, z,
+                                        Actual365Fixed(), Continuous,
+                                        NoFrequency, include, settlement);
+            if (std::fabs(price-calculated) > 1.0e-6)
+                BOOST_ERROR("z-spread for leg " << i << ":"
+                            << "\n    z-spread:  " << z
+                            << "\n    npv:       " << calculated
+                            << "\n    expected:  " << price);
+
+            // durations are checked against finite differences of
+            // the npv and against each other
+            InterestRate yc(y.rate(), y.dayCounter(),
+                            Continuous, NoFrequency);
+            const InterestRate* rates[] = { &y, &yc };
+            const Duration::Type types[] = { Duration::Modified,
+                                             Duration::Simple };
+            Real h = 1.0e-5;
+            for (Size k=0; k<LENGTH(rates); ++k) {
+                const InterestRate& r = *rates[k];
+                Real P = CashFlows::npv(legs[i], r, include, settlement);
+                Real Pup = CashFlows::npv(legs[i],
+                                          InterestRate(r.rate()+h,
+                                                       r.dayCounter(),
+                                                       r.compounding(),
+                                                       r.frequency()),
+                                          include, settlement);
+                Real Pdown = CashFlows::npv(legs[i],
+                                            InterestRate(r.rate()-h,
+                                                         r.dayCounter(),
+                                                         r.compounding(),
+                                                         r.frequency()),
+                                            include, settlement);
+                expected = (Pdown-Pup)/(2*h*P);
+                calculated = compiled.duration(r, types[k]);
+                if (std::fabs(expected-calculated) > 1.0e-6*expected)
+                    BOOST_ERROR("duration for leg " << i << ":"
+                                << "\n    type:      " << types[k]
+                                << "\n    yield:     " << r
+                                << "\n    compiled:  " << calculated
+                                << "\n    expected:  " << expected);
+            }
+
+            expected = compiled.duration(y, Duration::Simple);
+            calculated = compiled.duration(y, Duration::Macaulay);
+            if (std::fabs(expected-calculated) > tolerance*expected)
+                BOOST_ERROR("Macaulay duration for leg " << i << ":"
+                            << "\n    compiled:  " << calculated
+                            << "\n    expected:  " << expected);
+        }
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -272,6 +427,7 @@ test_suite* CashFlowsTest::suite() {
     #ifndef QL_USE_INDEXED_COUPON
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testNullFixingDays));
     #endif
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
     return suite;
 }
 
@@ -28,11 +28,14 @@
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
+#include <ql/math/randomnumbers/haltonrsg.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/currencies/europe.hpp>
 #include <iomanip>
@@ -360,8 +363,127 @@ void CdoTest::testHW() {
 }
 
 
+namespace {
+
+    template <class ModelType>
+    void checkThreads(const std::string& generator,
+                      const boost::shared_ptr<Basket>& basket,
+                      const boost::shared_ptr<GaussianConstantLossLM>& gLM,
+                      const Date& d) {
+        Size numSims = 5001;
+        vector<Real> recoveries = gLM->recoveries();
+        basket->setLossModel(boost::shared_ptr<DefaultLossModel>(
+                       new ModelType(gLM, recoveries, numSims, 1.e-6, 42, 1)));
+        Real expected = basket->expectedTrancheLoss(d);
+        Real percentile = basket->percentile(d, 0.95);
+        Real shortfall = basket->expectedShortfall(d, 0.95);
+        vector<Real> split = basket->splitVaRLevel(d, 0.5*percentile);
+
+        Size threads[] = { 2, 3, 8 };
+        for (Size i=0; i<LENGTH(threads); ++i) {
+            basket->setLossModel(boost::shared_ptr<DefaultLossModel>(
+                    new ModelType(gLM, recoveries, numSims, 1.e-6, 42,
+                                  threads[i])));
+
+            Real calculated = basket->expectedTrancheLoss(d);
+            if (calculated != expected)
+                BOOST_ERROR("expected tranche loss with " << threads[i]
+                            << " threads (" << generator << ")"
+                            << " differs from serial one:"
+                            << std::setprecision(16)
+                            << "\n    serial:     " << expected
+                            << "\n    calculated: " << calculated);
+            calculated = basket->percentile(d, 0.95);
+            if (calculated != percentile)
+                BOOST_ERROR("percentile with " << threads[i]
+                            << " threads (" << generator << ")"
+                            << " differs from serial one:"
+                            << std::setprecision(16)
+                            << "\n    serial:     " << percentile
+                            << "\n    calculated: " << calculated);
+            calculated = basket->expectedShortfall(d, 0.95);
+            if (calculated != shortfall)
+                BOOST_ERROR("expected shortfall with " << threads[i]
+                            << " threads (" << generator << ")"
+                            << " differs from serial one:"
+                            << std::setprecision(16)
+                            << "\n    serial:     " << shortfall
+                            << "\n    calculated: " << calculated);
+            vector<Real> calculatedSplit =
+                basket->splitVaRLevel(d, 0.5*percentile);
+            for (Size j=0; j<split.size(); ++j) {
+                if (calculatedSplit[j] != split[j])
+                    BOOST_ERROR("VaR split for name " << j << " with "
+                                << threads[i]
+                                << " threads (" << generator << ")"
+                                << " differs from serial one:"
+                                << std::setprecision(16)
+                                << "\n    serial:     " << split[j]
+                                << "\n    calculated: " << calculatedSplit[j]);
+            }
+        }
+    }
+
+}
+
+void CdoTest::testRandomDefaultThreads() {
+
+    BOOST_TEST_MESSAGE("Testing random default model statistics "
+                       "with several threads...");
+
+    SavedSettings backup;
+
+    Date asofDate(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Size poolSize = 20;
+    boost::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        Handle<DefaultProbabilityTermStructure> curve(
+            boost::shared_ptr<DefaultProbabilityTermStructure>(
+                new FlatHazardRate(asofDate, 0.01 + 0.005*i,
+                                   Actual365Fixed())));
+        curve->enableExtrapolation();
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities(1,
+            std::make_pair(NorthAmericaCorpDefaultKey(EURCurrency(),
+                                                      SeniorSec, Period(), 1.),
+                           curve));
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+    boost::shared_ptr<Basket> basket(
+        new Basket(asofDate, names, vector<Real>(poolSize, 100.0), pool,
+                   0.0, 0.5));
+
+    vector<Real> recoveries(poolSize, 0.4);
+    boost::shared_ptr<GaussianConstantLossLM> gLM(
+        new GaussianConstantLossLM(
+                vector<vector<Real> >(poolSize, vector<Real>(1, 0.5)),
+                recoveries, LatentModelIntegrationType::GaussianQuadrature,
+                GaussianCopulaPolicy::initTraits()));
+
+    Date d = TARGET().advance(asofDate, 5, Years);
+
+    // pseudo-random numbers can't be skipped in constant time, so
+    // the simulations are run serially and the statistics in parallel
+    checkThreads<RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> > >(
+                                      "Mersenne twister", basket, gLM, d);
+    // low-discrepancy numbers: the simulations run in parallel, too
+    checkThreads<RandomDefaultLM<GaussianCopulaPolicy, HaltonRsg> >(
+                                      "Halton", basket, gLM, d);
+}
+
+
 test_suite* CdoTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     suite->add(QUANTLIB_TEST_CASE(&CdoTest::testHW));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testRandomDefaultThreads));
     return suite;
 }
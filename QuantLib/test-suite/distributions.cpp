@@ -297,6 +297,81 @@ void DistributionTest::testNormal() {
     }
 }
 
+namespace {
+
+    template <class F>
+    void checkArrayVersion(const F& f, const std::vector<Real>& x,
+                           const char* tag) {
+        std::vector<Real> y(x.size()), z(x);
+        f(&x[0], &x[0]+x.size(), &y[0]);
+        // in place
+        f(&z[0], &z[0]+z.size(), &z[0]);
+        for (Size i=0; i<x.size(); ++i) {
+            Real expected = f(x[i]);
+            if (!close_enough(y[i], expected) || !close_enough(z[i], expected))
+                BOOST_FAIL(tag << " array version differs from scalar one:"
+                           << std::setprecision(16)
+                           << "\n    x:           " << x[i]
+                           << "\n    scalar:      " << expected
+                           << "\n    array:       " << y[i]
+                           << "\n    in place:    " << z[i]);
+        }
+    }
+
+}
+
+void DistributionTest::testNormalArrays() {
+
+    BOOST_TEST_MESSAGE("Testing array versions of normal distributions...");
+
+    // probabilities in the tails and in the central region, in
+    // a number not multiple of the block size used internally
+    std::vector<Real> p;
+    for (Size i=1; i<1000; ++i)
+        p.push_back(i/1000.0);
+    const Real tails[] = { 1.0e-12, 1.0e-8, 1.0e-5, 0.0242, 0.02425,
+                           0.02426, 0.0800, 0.9200, 0.97574, 0.97575,
+                           0.9758, 0.99999, 1.0-1.0e-8 };
+    p.insert(p.end(), tails, tails+LENGTH(tails));
+
+    std::vector<Real> x;
+    for (Real xi=-40.0; xi<=40.0; xi+=0.0625)
+        x.push_back(xi);
+
+    checkArrayVersion(InverseCumulativeNormal(), p,
+                      "InverseCumulativeNormal");
+    checkArrayVersion(InverseCumulativeNormal(average, sigma), p,
+                      "InverseCumulativeNormal");
+    checkArrayVersion(MoroInverseCumulativeNormal(), p,
+                      "MoroInverseCumulativeNormal");
+    checkArrayVersion(MoroInverseCumulativeNormal(average, sigma), p,
+                      "MoroInverseCumulativeNormal");
+    checkArrayVersion(CumulativeNormalDistribution(), x,
+                      "CumulativeNormalDistribution");
+    checkArrayVersion(CumulativeNormalDistribution(average, sigma), x,
+                      "CumulativeNormalDistribution");
+
+    std::vector<Real> z(p.size());
+    InverseCumulativeNormal::standard_values(&p[0], &p[0]+p.size(), &z[0]);
+    for (Size i=0; i<p.size(); ++i) {
+        Real expected = InverseCumulativeNormal::standard_value(p[i]);
+        if (!close_enough(z[i], expected))
+            BOOST_FAIL("InverseCumulativeNormal::standard_values differs "
+                       "from standard_value:"
+                       << std::setprecision(16)
+                       << "\n    x:           " << p[i]
+                       << "\n    scalar:      " << expected
+                       << "\n    array:       " << z[i]);
+    }
+
+    // out-of-range values are still detected
+    const Real wrong[] = { 0.5, 0.0, 0.5 };
+    Real out[LENGTH(wrong)];
+    BOOST_CHECK_THROW(MoroInverseCumulativeNormal()(wrong,
+                                                    wrong+LENGTH(wrong), out),
+                      Error);
+}
+
 void DistributionTest::testBivariate() {
 
     BOOST_TEST_MESSAGE("Testing bivariate cumulative normal distribution...");
@@ -627,6 +702,7 @@ void DistributionTest::testBivariateCumulativeStudentVsBivariate() {
 test_suite* DistributionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormal));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormalArrays));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testBivariate));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testPoisson));
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testCumulativePoisson));
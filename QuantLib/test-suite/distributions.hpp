@@ -29,6 +29,7 @@
 class DistributionTest {
   public:
     static void testNormal();
+    static void testNormalArrays();
     static void testBivariate();
     static void testPoisson();
     static void testCumulativePoisson();
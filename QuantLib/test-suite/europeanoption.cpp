@@ -1265,6 +1265,93 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcEnginesWithThreads() {
+
+    BOOST_TEST_MESSAGE("Testing reproducibility of multi-threaded "
+                       "Monte Carlo European engines...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(new
+            BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Put, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                  new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    Size threads[] = { 2, 3, 8 };
+
+    for (Size k=0; k<2; ++k) {
+        bool antithetic = (k == 1);
+
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<PseudoRandom>(process)
+            .withSteps(10)
+            .withAntitheticVariate(antithetic)
+            .withSamples(5000)
+            .withSeed(42));
+        Real expected = option.NPV();
+        Real expectedError = option.errorEstimate();
+
+        for (Size i=0; i<LENGTH(threads); ++i) {
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(10)
+                .withAntitheticVariate(antithetic)
+                .withSamples(5000)
+                .withSeed(42)
+                .withThreads(threads[i]));
+            Real calculated = option.NPV();
+            Real calculatedError = option.errorEstimate();
+            if (calculated != expected || calculatedError != expectedError)
+                BOOST_ERROR("failed to reproduce single-threaded results"
+                            << "\n    threads:          " << threads[i]
+                            << "\n    antithetic:       " << antithetic
+                            << std::setprecision(16)
+                            << "\n    expected value:   " << expected
+                            << "\n    calculated value: " << calculated
+                            << "\n    expected error:   " << expectedError
+                            << "\n    calculated error: "
+                            << calculatedError);
+        }
+    }
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<LowDiscrepancy>(process)
+        .withSteps(10)
+        .withSamples(4095));
+    Real expected = option.NPV();
+
+    for (Size i=0; i<LENGTH(threads); ++i) {
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<LowDiscrepancy>(process)
+            .withSteps(10)
+            .withSamples(4095)
+            .withThreads(threads[i]));
+        Real calculated = option.NPV();
+        if (calculated != expected)
+            BOOST_ERROR("failed to reproduce single-threaded "
+                        "low-discrepancy results"
+                        << "\n    threads:    " << threads[i]
+                        << std::setprecision(16)
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << calculated);
+    }
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -1537,6 +1624,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                              &EuropeanOptionTest::testMcEnginesWithThreads));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
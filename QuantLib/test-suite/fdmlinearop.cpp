@@ -45,6 +45,7 @@
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
@@ -83,10 +84,44 @@
 #pragma GCC diagnostic pop
 #endif
 #include <numeric>
+#include <new>
+#include <cstdlib>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace {
+
+    // allocations made through the global operator new while
+    // counting is enabled; see testAllocationsPerStep
+    bool countAllocations = false;
+    Size allocations = 0;
+
+}
+
+void* operator new(std::size_t size)
+#if __cplusplus < 201103L
+    throw(std::bad_alloc)
+#endif
+{
+    if (countAllocations)
+        ++allocations;
+    void* p = std::malloc(size != 0 ? size : 1);
+    if (p == 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p)
+#if __cplusplus < 201103L
+    throw()
+#else
+    noexcept
+#endif
+{
+    std::free(p);
+}
+
 namespace {
 
     class FdmHestonExpressCondition : public StepCondition<Array> {
@@ -143,6 +178,27 @@ namespace {
         V operator()(T t, U u) { return t*u;}
     };
 
+    Real maxAbsDifference(const Array& a, const Array& b) {
+        Real diff = 0.0;
+        for (Size i=0; i < a.size(); ++i)
+            diff = std::max(diff, std::fabs(a[i]-b[i]));
+        return diff;
+    }
+
+    // allocations made by a step of the scheme once its workspace
+    // has been set up by a first step
+    template <class Scheme>
+    Size allocationsPerStep(Scheme& scheme, const Array& u, Time t) {
+        Array a = u;
+        scheme.step(a, t);
+        a = u;
+        allocations = 0;
+        countAllocations = true;
+        scheme.step(a, t);
+        countAllocations = false;
+        return allocations;
+    }
+
 }
 
 void FdmLinearOpTest::testFdmLinearOpLayout() {
@@ -1539,6 +1595,243 @@ void FdmLinearOpTest::testFdmMesherIntegral() {
 }
 
 
+void FdmLinearOpTest::testInPlaceOperations() {
+    BOOST_TEST_MESSAGE("Testing in-place operator methods...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    Date exerciseDate(28, March, 2006);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    Size dims[] = {21, 11, 11};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    boost::shared_ptr<FdmLinearOpComposite> linearOp(
+        new FdmHestonHullWhiteOp(mesher,
+                                 jointProcess->hestonProcess(),
+                                 hwProcess,
+                                 jointProcess->eta()));
+
+    const Size n = mesher->layout()->size();
+    Array u(n);
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        u[iter.index()] = desc.calculator->avgInnerValue(iter, maturity);
+    }
+
+    const Real tol = 1e-12;
+    linearOp->setTime(0.5*maturity, maturity);
+
+    Array out(n);
+    linearOp->apply(u, out);
+    if (maxAbsDifference(out, linearOp->apply(u)) > tol)
+        BOOST_FAIL("in-place apply differs from allocating version");
+    linearOp->apply_mixed(u, out);
+    if (maxAbsDifference(out, linearOp->apply_mixed(u)) > tol)
+        BOOST_FAIL("in-place apply_mixed differs from allocating version");
+    for (Size i=0; i < linearOp->size(); ++i) {
+        linearOp->apply_direction(i, u, out);
+        if (maxAbsDifference(out, linearOp->apply_direction(i, u)) > tol)
+            BOOST_FAIL("in-place apply_direction differs from allocating "
+                       "version in direction " << i);
+        linearOp->solve_splitting(i, u, -0.01, out);
+        if (maxAbsDifference(out, linearOp->solve_splitting(i, u, -0.01))
+                > tol)
+            BOOST_FAIL("in-place solve_splitting differs from allocating "
+                       "version in direction " << i);
+    }
+
+    // one step of the ADI schemes against the allocating formulae
+    const Time dt = maturity/10, t = maturity;
+    const Real theta = 0.5+std::sqrt(3.0)/6., mu = 0.5;
+
+    linearOp->setTime(t-dt, t);
+    Array y = u + dt*linearOp->apply(u);
+    const Array y0 = y;
+    for (Size i=0; i < linearOp->size(); ++i) {
+        Array rhs = y - theta*dt*linearOp->apply_direction(i, u);
+        y = linearOp->solve_splitting(i, rhs, -theta*dt);
+    }
+
+    Array douglas = u;
+    DouglasScheme douglasScheme(theta, linearOp);
+    douglasScheme.setStep(dt);
+    douglasScheme.step(douglas, t);
+    if (maxAbsDifference(douglas, y) > tol)
+        BOOST_FAIL("Douglas step differs from expected result");
+
+    Array yt = y0 + mu*dt*linearOp->apply_mixed(y-u);
+    for (Size i=0; i < linearOp->size(); ++i) {
+        Array rhs = yt - theta*dt*linearOp->apply_direction(i, u);
+        yt = linearOp->solve_splitting(i, rhs, -theta*dt);
+    }
+
+    Array craigSneyd = u;
+    CraigSneydScheme craigSneydScheme(theta, mu, linearOp);
+    craigSneydScheme.setStep(dt);
+    craigSneydScheme.step(craigSneyd, t);
+    if (maxAbsDifference(craigSneyd, yt) > tol)
+        BOOST_FAIL("Craig-Sneyd step differs from expected result");
+
+    yt = y0 + mu*dt*linearOp->apply(y-u);
+    for (Size i=0; i < linearOp->size(); ++i) {
+        Array rhs = yt - theta*dt*linearOp->apply_direction(i, y);
+        yt = linearOp->solve_splitting(i, rhs, -theta*dt);
+    }
+
+    // two steps, so that the workspace is reused
+    Array hundsdorfer = u;
+    HundsdorferScheme hundsdorferScheme(theta, mu, linearOp);
+    hundsdorferScheme.setStep(dt);
+    hundsdorferScheme.step(hundsdorfer, t);
+    if (maxAbsDifference(hundsdorfer, yt) > tol)
+        BOOST_FAIL("Hundsdorfer step differs from expected result");
+
+    hundsdorfer = u;
+    hundsdorferScheme.step(hundsdorfer, t);
+    if (maxAbsDifference(hundsdorfer, yt) > tol)
+        BOOST_FAIL("repeated Hundsdorfer step differs from expected result");
+}
+
+void FdmLinearOpTest::testAllocationsPerStep() {
+    BOOST_TEST_MESSAGE("Testing allocations per step of ADI schemes...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    Date exerciseDate(28, March, 2006);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    Size dims[] = {21, 11, 11};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    Size dims2d[] = {21, 11};
+    const std::vector<Size> dim2d(dims2d, dims2d+LENGTH(dims2d));
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, 4.905274778));
+    boundaries.push_back(std::pair<Real, Real>(0.0, 1.0));
+    boost::shared_ptr<FdmMesher> mesher2d(
+        new UniformGridMesher(boost::shared_ptr<FdmLinearOpLayout>(
+                                  new FdmLinearOpLayout(dim2d)),
+                              boundaries));
+
+    boost::shared_ptr<FdmLinearOpComposite> ops[] = {
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmHestonOp(mesher2d, jointProcess->hestonProcess())),
+        boost::shared_ptr<FdmLinearOpComposite>(
+            new FdmHestonHullWhiteOp(mesher,
+                                     jointProcess->hestonProcess(),
+                                     hwProcess,
+                                     jointProcess->eta()))
+    };
+    std::string names[] = { "Heston", "Heston Hull-White" };
+
+    const Time dt = maturity/10, t = maturity;
+    const Real theta = 0.5+std::sqrt(3.0)/6., mu = 0.5;
+
+    for (Size k=0; k<LENGTH(ops); ++k) {
+        const Size n = (k == 0) ? mesher2d->layout()->size()
+                                : mesher->layout()->size();
+        Array u(n);
+        for (Size i=0; i < n; ++i)
+            u[i] = 1.0 + 0.5*std::sin(0.1*i);
+
+        DouglasScheme douglas(theta, ops[k]);
+        douglas.setStep(dt);
+        CraigSneydScheme craigSneyd(theta, mu, ops[k]);
+        craigSneyd.setStep(dt);
+        ModifiedCraigSneydScheme modifiedCraigSneyd(1.0/3.0, mu, ops[k]);
+        modifiedCraigSneyd.setStep(dt);
+        HundsdorferScheme hundsdorfer(theta, mu, ops[k]);
+        hundsdorfer.setStep(dt);
+
+        Size calculated[] = {
+            allocationsPerStep(douglas, u, t),
+            allocationsPerStep(craigSneyd, u, t),
+            allocationsPerStep(modifiedCraigSneyd, u, t),
+            allocationsPerStep(hundsdorfer, u, t)
+        };
+        std::string schemes[] = { "Douglas", "Craig-Sneyd",
+                                  "modified Craig-Sneyd", "Hundsdorfer" };
+        for (Size i=0; i<LENGTH(calculated); ++i) {
+            if (calculated[i] != 0)
+                BOOST_ERROR(schemes[i] << " step with " << names[k]
+                            << " operator allocates memory:"
+                            << "\n    allocations: " << calculated[i]);
+        }
+    }
+}
+
+void FdmLinearOpTest::testSolveSplittingLines() {
+    BOOST_TEST_MESSAGE("Testing line-wise tridiagonal solves "
+                       "on a three dimensional grid...");
+
+    // large enough to solve the lines in parallel if enabled
+    Size dims[] = {40, 30, 20};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    std::vector<std::pair<Real, Real> > boundaries(
+                                        dim.size(), std::make_pair(0.0, 1.0));
+    boost::shared_ptr<FdmMesher> mesher(
+                                new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i=0; i < u.size(); ++i)
+        u[i] = std::sin(0.1*i) + std::cos(0.35*i);
+
+    const Real tol = 1e-12;
+    const Real a = -0.01;
+    for (Size d=0; d < dim.size(); ++d) {
+        TripleBandLinearOp op(SecondDerivativeOp(d, mesher));
+        op.axpyb(Array(1, 0.5), FirstDerivativeOp(d, mesher), op,
+                 Array(1, -0.05));
+
+        const Array r = u + a*op.apply(u);
+
+        const Array x = op.solve_splitting(r, a);
+        if (maxAbsDifference(x, u) > tol)
+            BOOST_FAIL("failed to solve line systems in direction " << d
+                       << "\n    error: " << maxAbsDifference(x, u));
+
+        Array y = r;
+        op.solve_splitting(y, a, 1.0, y);
+        if (maxAbsDifference(x, y) != 0.0)
+            BOOST_FAIL("aliased in-place solve_splitting differs "
+                       "in direction " << d);
+    }
+}
+
+
+
 test_suite* FdmLinearOpTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1568,6 +1861,11 @@ test_suite* FdmLinearOpTest::suite() {
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmMesherIntegral));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testInPlaceOperations));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSolveSplittingLines));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAllocationsPerStep));
 
     return suite;
     
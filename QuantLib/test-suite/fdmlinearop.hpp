@@ -45,6 +45,9 @@ public:
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
     static void testFdmMesherIntegral();
+    static void testInPlaceOperations();
+    static void testSolveSplittingLines();
+    static void testAllocationsPerStep();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -290,6 +290,74 @@ void HestonModelTest::testDAXCalibration() {
     }
 }
 
+void HestonModelTest::testParallelCalibration() {
+
+    BOOST_TEST_MESSAGE(
+             "Testing parallel Heston model calibration against serial one...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<boost::shared_ptr<CalibrationHelper> > options
+                                                    = marketData.options;
+
+    boost::shared_ptr<HestonModel> serialModel(new HestonModel(
+        boost::shared_ptr<HestonProcess>(new HestonProcess(
+                          marketData.riskFreeTS, marketData.dividendYield,
+                          marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5))));
+    boost::shared_ptr<HestonModel> parallelModel(new HestonModel(
+        boost::shared_ptr<HestonProcess>(new HestonProcess(
+                          marketData.riskFreeTS, marketData.dividendYield,
+                          marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5))));
+    parallelModel->setCalibrationThreads(4);
+
+    EndCriteria endCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8);
+
+    boost::shared_ptr<PricingEngine> engine(
+                                   new AnalyticHestonEngine(serialModel, 64));
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(engine);
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    serialModel->calibrate(options, om, endCriteria);
+
+    // each helper is given its own engine
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                               new AnalyticHestonEngine(parallelModel, 64)));
+    LevenbergMarquardt om2(1e-8, 1e-8, 1e-8);
+    parallelModel->calibrate(options, om2, endCriteria);
+
+    Array expected = serialModel->params();
+    Array calculated = parallelModel->params();
+    const Real tolerance = 1.0e-10;
+    for (Size i = 0; i < expected.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce serial calibration for "
+                        << io::ordinal(i+1) << " parameter"
+                        << "\n    parallel: " << calculated[i]
+                        << "\n    serial:   " << expected[i]);
+    }
+
+    if (parallelModel->functionEvaluation()
+                                     != serialModel->functionEvaluation())
+        BOOST_ERROR("different number of function evaluations"
+                    << "\n    parallel: "
+                    << parallelModel->functionEvaluation()
+                    << "\n    serial:   "
+                    << serialModel->functionEvaluation());
+    if (parallelModel->problemValues().size() != options.size())
+        BOOST_ERROR("wrong number of problem values: "
+                    << parallelModel->problemValues().size()
+                    << " instead of " << options.size());
+    if (parallelModel->calibrationTime() < 0.0)
+        BOOST_ERROR("negative calibration time: "
+                    << parallelModel->calibrationTime());
+}
+
 void HestonModelTest::testAnalyticVsBlack() {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -939,6 +1007,126 @@ void HestonModelTest::testDifferentIntegrals() {
     }
 }
 
+void HestonModelTest::testStrikeBatchedPricing() {
+    BOOST_TEST_MESSAGE("Testing strike-batched analytic Heston pricing...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = ActualActual();
+    const Date exerciseDate = settlementDate + Period(18, Months);
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.03, dayCounter));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(1.0)));
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+                   riskFreeTS, dividendTS, s0, 0.07, 2.0, 0.04, 0.55, -0.8));
+    boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+    std::vector<Real> strikes;
+    std::vector<Option::Type> types;
+    const Real k[] = { 0.5, 0.7, 0.9, 1.0, 1.1, 1.25, 1.5, 2.0 };
+    for (Size i=0; i<LENGTH(k); ++i) {
+        strikes.push_back(k[i]);
+        types.push_back(i % 2 == 0 ? Option::Put : Option::Call);
+    }
+
+    std::vector<boost::shared_ptr<AnalyticHestonEngine> > engines;
+    engines.push_back(boost::make_shared<AnalyticHestonEngine>(model, 144));
+    engines.push_back(boost::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::BranchCorrection,
+        AnalyticHestonEngine::Integration::gaussLaguerre(144)));
+    engines.push_back(boost::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::Integration::gaussLegendre(256)));
+    engines.push_back(boost::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::Integration::gaussChebyshev2nd(256)));
+    engines.push_back(boost::make_shared<AnalyticHestonEngine>(
+        model, 1e-8, 10000));
+
+    const Real tol = 1e-12;
+    for (Size i=0; i<engines.size(); ++i) {
+        const std::vector<Real> batched =
+            engines[i]->prices(exerciseDate, strikes, types);
+        const Size batchEvaluations = engines[i]->numberOfEvaluations();
+
+        Size evaluations = 0;
+        for (Size j=0; j<strikes.size(); ++j) {
+            VanillaOption option(
+                boost::make_shared<PlainVanillaPayoff>(types[j], strikes[j]),
+                exercise);
+            option.setPricingEngine(engines[i]);
+            const Real expected = option.NPV();
+            evaluations += engines[i]->numberOfEvaluations();
+
+            if (std::fabs(batched[j] - expected) > tol
+                || std::fabs(engines[i]->batchedPrice(
+                        exerciseDate, strikes[j], types[j]) - expected) > tol)
+                BOOST_ERROR("failed to reproduce single-option price "
+                            "with strike-batched pricing"
+                            << "\n    engine:     " << i
+                            << "\n    strike:     " << strikes[j]
+                            << "\n    batched:    " << batched[j]
+                            << "\n    single:     " << expected);
+        }
+
+        // all strikes are priced with the nodes of a single option
+        if (i < 4 && batchEvaluations * strikes.size() != evaluations)
+            BOOST_ERROR("unexpected number of evaluations"
+                        << "\n    engine:             " << i
+                        << "\n    batched pricing:    " << batchEvaluations
+                        << "\n    single options:     " << evaluations);
+    }
+
+    // cached batch prices must follow changes of the model parameters...
+    const boost::shared_ptr<AnalyticHestonEngine> engine = engines.front();
+    Array params = model->params();
+    params[0] = 0.05;  // theta
+    model->setParams(params);
+
+    VanillaOption option(
+        boost::make_shared<PlainVanillaPayoff>(types[3], strikes[3]), exercise);
+    option.setPricingEngine(engine);
+    if (std::fabs(engine->batchedPrice(exerciseDate, strikes[3], types[3])
+                  - option.NPV()) > tol)
+        BOOST_ERROR("cached strike-batched price not updated "
+                    "after change of model parameters");
+
+    // ...and of the market data
+    boost::dynamic_pointer_cast<SimpleQuote>(*s0)->setValue(1.05);
+    if (std::fabs(engine->batchedPrice(exerciseDate, strikes[3], types[3])
+                  - option.NPV()) > tol)
+        BOOST_ERROR("cached strike-batched price not updated "
+                    "after change of market data");
+
+    // calibration helpers are priced by strike-batching
+    const Handle<Quote> vol(boost::make_shared<SimpleQuote>(0.25));
+    for (Size j=0; j<strikes.size(); ++j) {
+        HestonModelHelper helper(Period(18, Months), NullCalendar(), 1.05,
+                                 strikes[j], vol, riskFreeTS, dividendTS);
+        helper.setPricingEngine(engine);
+        const Option::Type type =
+            strikes[j]*riskFreeTS->discount(exerciseDate)
+            >= 1.05*dividendTS->discount(exerciseDate) ?
+            Option::Call : Option::Put;
+        VanillaOption helperOption(
+            boost::make_shared<PlainVanillaPayoff>(type, strikes[j]),
+            exercise);
+        helperOption.setPricingEngine(engine);
+        if (std::fabs(helper.modelValue() - helperOption.NPV()) > tol)
+            BOOST_ERROR("failed to reproduce model value of "
+                        "calibration helper"
+                        << "\n    strike:     " << strikes[j]
+                        << "\n    calculated: " << helper.modelValue()
+                        << "\n    expected:   " << helperOption.NPV());
+    }
+}
+
 void HestonModelTest::testMultipleStrikesEngine() {
     BOOST_TEST_MESSAGE("Testing multiple-strikes FD Heston engine...");
 
@@ -1512,11 +1700,13 @@ test_suite* HestonModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBlackCalibration));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testParallelCalibration));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testKahlJaeckelCase));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDifferentIntegrals));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testStrikeBatchedPricing));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdBarrierVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
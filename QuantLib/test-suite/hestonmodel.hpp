@@ -29,6 +29,7 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testParallelCalibration();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
@@ -36,6 +37,7 @@ class HestonModelTest {
     static void testFdBarrierVsCached();    
     static void testFdVanillaVsCached();    
     static void testDifferentIntegrals();
+    static void testStrikeBatchedPricing();
     static void testMultipleStrikesEngine();
     static void testAnalyticPiecewiseTimeDependent();
     static void testDAXCalibrationOfTimeDependentModel();
@@ -0,0 +1,209 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "indexes.hpp"
+#include "utilities.hpp"
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <fstream>
+#include <cstdio>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+    class NotificationCounter : public Observer {
+      public:
+        NotificationCounter() : count(0) {}
+        void update() { ++count; }
+        Size count;
+    };
+
+    // removes the fixing file at the end of the test
+    class FixingFile {
+      public:
+        FixingFile() : name_("quantlib-fixings-test.csv") {}
+        ~FixingFile() { std::remove(name_.c_str()); }
+        const std::string& name() const { return name_; }
+      private:
+        std::string name_;
+    };
+
+}
+
+
+void IndexTest::testFixingStorage() {
+
+    BOOST_TEST_MESSAGE("Testing storage of index fixings...");
+
+    IndexHistoryCleaner cleaner;
+
+    Euribor6M euribor;
+    NotificationCounter counter;
+    counter.registerWith(IndexManager::instance().notifier(euribor.name()));
+
+    // fixings are added out of order and beyond the current range
+    Date today(15, June, 2015);
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    Date d = today;
+    for (Size i=0; i<250; ++i, d = euribor.fixingCalendar().advance(d,1,Days)) {
+        dates.push_back(d);
+        values.push_back(0.01 + i*1.0e-5);
+    }
+    euribor.addFixings(dates.begin()+100, dates.end(), values.begin()+100);
+    euribor.addFixings(dates.begin(), dates.begin()+100, values.begin());
+    if (counter.count != 2)
+        BOOST_ERROR(counter.count << " notifications received, "
+                    "2 expected");
+
+    const TimeSeries<Real>& history = euribor.timeSeries();
+    if (history.size() != dates.size())
+        BOOST_ERROR(history.size() << " fixings stored, "
+                    << dates.size() << " expected");
+    for (Size i=0; i<dates.size(); ++i) {
+        Real stored = euribor.fixing(dates[i]);
+        if (stored != values[i] || history[dates[i]] != values[i])
+            BOOST_ERROR("wrong fixing stored for " << dates[i]
+                        << "\n    stored:   " << stored
+                        << "\n    series:   " << history[dates[i]]
+                        << "\n    expected: " << values[i]);
+    }
+    if (IndexManager::instance().fixing(euribor.name(), dates[0]-1)
+        != Null<Real>())
+        BOOST_ERROR("fixing returned before the first stored date");
+    if (IndexManager::instance().fixing(euribor.name(), dates.back()+1)
+        != Null<Real>())
+        BOOST_ERROR("fixing returned after the last stored date");
+
+    // the same values can be stored again; different ones can't
+    // unless they're forced
+    euribor.addFixing(dates[10], values[10]);
+    BOOST_CHECK_THROW(euribor.addFixing(dates[10], 0.05), Error);
+    if (euribor.fixing(dates[10]) != values[10])
+        BOOST_ERROR("duplicated fixing overwrote the stored one");
+    euribor.addFixing(dates[10], 0.05, true);
+    if (euribor.fixing(dates[10]) != 0.05)
+        BOOST_ERROR("forced fixing not stored");
+    if (euribor.timeSeries()[dates[10]] != 0.05)
+        BOOST_ERROR("time series not updated after forced fixing");
+
+    // invalid dates are reported, while the valid ones are stored
+    Date saturday(13, June, 2015), monday(22, June, 2015);
+    Date mixed[] = { saturday, monday };
+    Real mixedValues[] = { 0.02, 0.03 };
+    BOOST_CHECK_THROW(euribor.addFixings(mixed, mixed+2, mixedValues, true),
+                      Error);
+    if (euribor.fixing(monday) != 0.03)
+        BOOST_ERROR("valid fixing not stored together with invalid one");
+
+    euribor.clearFixings();
+    if (!euribor.timeSeries().empty())
+        BOOST_ERROR("fixings not cleared");
+}
+
+void IndexTest::testFixingLoader() {
+
+    BOOST_TEST_MESSAGE("Testing bulk loading of index fixings...");
+
+    IndexHistoryCleaner cleaner;
+    FixingFile file;
+
+    Euribor6M euribor;
+    NotificationCounter counter;
+    counter.registerWith(IndexManager::instance().notifier(euribor.name()));
+
+    Calendar calendar = TARGET();
+    std::vector<Date> dates;
+    Date d(2, January, 1995);
+    while (d < Date(31, December, 2014)) {
+        dates.push_back(d);
+        d = calendar.advance(d, 1, Days);
+    }
+
+    {
+        std::ofstream out(file.name().c_str());
+        out << "# name, date, fixing\n";
+        for (Size i=0; i<dates.size(); ++i) {
+            const Date& x = dates[i];
+            out << euribor.name() << ","
+                << io::iso_date(x) << ","
+                << 0.01 + (i%100)*1.0e-4 << "\n";
+            // a second index, lower case and with DOS line endings
+            out << "myindex," << io::iso_date(x) << ","
+                << 1.0 + i << "\r\n";
+        }
+        out << "\n";
+    }
+
+    Size n = IndexManager::instance().loadFixings(file.name());
+    if (n != 2*dates.size())
+        BOOST_ERROR(n << " fixings loaded, " << 2*dates.size()
+                    << " expected");
+    if (counter.count != 1)
+        BOOST_ERROR(counter.count << " notifications received, "
+                    "1 expected");
+
+    for (Size i=0; i<dates.size(); ++i) {
+        Real expected = 0.01 + (i%100)*1.0e-4;
+        Real stored = euribor.fixing(dates[i]);
+        if (std::fabs(stored - expected) > 1.0e-12)
+            BOOST_ERROR("wrong fixing loaded for " << euribor.name()
+                        << " on " << dates[i]
+                        << "\n    loaded:   " << stored
+                        << "\n    expected: " << expected);
+        stored = IndexManager::instance().fixing("MyIndex", dates[i]);
+        if (stored != 1.0 + i)
+            BOOST_ERROR("wrong fixing loaded for MyIndex on " << dates[i]
+                        << "\n    loaded:   " << stored
+                        << "\n    expected: " << 1.0 + i);
+    }
+    if (euribor.timeSeries().size() != dates.size())
+        BOOST_ERROR(euribor.timeSeries().size() << " fixings in the "
+                    "time series, " << dates.size() << " expected");
+
+    // loading the same values again is allowed...
+    IndexManager::instance().loadFixings(file.name());
+
+    // ...while conflicting or malformed ones are reported
+    {
+        std::ofstream out(file.name().c_str());
+        out << "MyIndex," << io::iso_date(dates[0]) << ",0.5\n";
+    }
+    BOOST_CHECK_THROW(IndexManager::instance().loadFixings(file.name()),
+                      Error);
+    IndexManager::instance().loadFixings(file.name(), true);
+    if (IndexManager::instance().fixing("MyIndex", dates[0]) != 0.5)
+        BOOST_ERROR("forced fixing not loaded");
+
+    {
+        std::ofstream out(file.name().c_str());
+        out << "MyIndex,2015/01/02,0.5\n";
+    }
+    BOOST_CHECK_THROW(IndexManager::instance().loadFixings(file.name()),
+                      Error);
+}
+
+
+test_suite* IndexTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Index tests");
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingStorage));
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingLoader));
+    return suite;
+}
@@ -20,6 +20,15 @@
 #include "instruments.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/stock.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/pricingengines/portfoliocalculator.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
@@ -61,9 +70,102 @@ void InstrumentTest::testObservable() {
 }
 
 
+void InstrumentTest::testPortfolioCalculator() {
+
+    BOOST_TEST_MESSAGE("Testing portfolio calculation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(16, March, 2016);
+
+    RelinkableHandle<YieldTermStructure> forecasting;
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(forecasting));
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<RateHelper> > helpers;
+    quotes.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.01)));
+    helpers.push_back(boost::shared_ptr<RateHelper>(
+        new DepositRateHelper(Handle<Quote>(quotes.back()), euribor6m)));
+    for (Integer i=2; i<=30; i+=2) {
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                          new SimpleQuote(0.01+0.0005*i)));
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new SwapRateHelper(Handle<Quote>(quotes.back()), i*Years,
+                               TARGET(), Annual, Unadjusted,
+                               Thirty360(), euribor6m)));
+    }
+    boost::shared_ptr<YieldTermStructure> curve(
+              new PiecewiseYieldCurve<Discount, LogLinear>(0, TARGET(),
+                                                           helpers,
+                                                           Actual365Fixed()));
+    forecasting.linkTo(curve);
+
+    // half the swaps share the same engine; the others have their own
+    boost::shared_ptr<PricingEngine> engine(
+                                      new DiscountingSwapEngine(forecasting));
+    std::vector<boost::shared_ptr<Instrument> > swaps;
+    for (Size i=0; i<40; ++i) {
+        boost::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap((1+i%20)*Years, euribor6m, 0.01+0.0002*i)
+            .withNominal(1000000.0);
+        if (i%2 == 0)
+            swap->setPricingEngine(engine);
+        swaps.push_back(swap);
+    }
+
+    PortfolioCalculator calculator(swaps, 4);
+
+    std::vector<boost::shared_ptr<LazyObject> > dependencies =
+        calculator.dependencies();
+    bool found = false;
+    for (Size i=0; i<dependencies.size(); ++i)
+        if (dependencies[i].get() ==
+            boost::dynamic_pointer_cast<LazyObject>(curve).get())
+            found = true;
+    if (!found)
+        BOOST_FAIL("curve not found among the portfolio dependencies");
+
+    for (Size k=0; k<2; ++k) {
+        // invalidates the curve and the swaps
+        quotes[3]->setValue(0.013 + 0.001*k);
+
+        calculator.calculate();
+        std::vector<Real> calculated(swaps.size());
+        for (Size i=0; i<swaps.size(); ++i)
+            calculated[i] = swaps[i]->NPV();
+
+        for (Size i=0; i<swaps.size(); ++i) {
+            swaps[i]->recalculate();
+            Real expected = swaps[i]->NPV();
+            if (std::fabs(calculated[i]-expected) > 1.0e-8)
+                BOOST_FAIL("failed to reproduce sequential results "
+                           "for swap #" << i << ":\n"
+                           << std::setprecision(12)
+                           << "    calculated: " << calculated[i] << "\n"
+                           << "    expected:   " << expected);
+        }
+    }
+
+    // a failed bootstrap is raised again by each swap
+    quotes[3]->setValue(Null<Real>());
+    calculator.calculate();
+    for (Size i=0; i<swaps.size(); ++i) {
+        bool failed = false;
+        try {
+            swaps[i]->NPV();
+        } catch (Error&) {
+            failed = true;
+        }
+        if (!failed)
+            BOOST_FAIL("swap #" << i << " priced on a failed curve");
+    }
+}
+
+
 test_suite* InstrumentTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioCalculator));
     return suite;
 }
 
@@ -36,7 +36,12 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/callability/triggeredswapexercise.hpp>
 #include <ql/models/marketmodels/callability/upperboundengine.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/curvestates/coterminalswapcurvestate.hpp>
+#include <ql/models/marketmodels/curvestates/cmswapcurvestate.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmnormaldriftcalculator.hpp>
+#include <ql/models/marketmodels/driftcomputation/smmdriftcalculator.hpp>
+#include <ql/models/marketmodels/driftcomputation/cmsmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerconstrained.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
@@ -110,6 +115,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <sstream>
+#include <iomanip>
 
 #if defined(BOOST_MSVC)
 #include <float.h>
@@ -4749,6 +4755,203 @@ void MarketModelTest::testDriftCalculator() {
     }
 }
 
+void MarketModelTest::testCachedDrifts() {
+
+    BOOST_TEST_MESSAGE("Testing drift calculators against cached values...");
+
+    const Size n = 3;
+    Time times[] = { 0.5, 1.0, 1.5, 2.0 };
+    std::vector<Time> rateTimes(times, times+n+1), taus(n, 0.5);
+    Rate r[] = { 0.04, 0.045, 0.05 };
+    std::vector<Rate> rates(r, r+n);
+    Spread d[] = { 0.01, 0.0, 0.02 };
+    std::vector<Spread> displacements(d, d+n);
+    Matrix pseudo(n, 2);
+    pseudo[0][0] = 0.10; pseudo[0][1] = 0.02;
+    pseudo[1][0] = 0.11; pseudo[1][1] = 0.03;
+    pseudo[2][0] = 0.12; pseudo[2][1] = -0.01;
+
+    // the same rates are used as forwards, coterminal swap rates and
+    // constant-maturity swap rates spanning two forwards
+    LMMCurveState lmmCurveState(rateTimes);
+    lmmCurveState.setOnForwardRates(rates);
+    CoterminalSwapCurveState coterminalCurveState(rateTimes);
+    coterminalCurveState.setOnCoterminalSwapRates(rates);
+    CMSwapCurveState cmSwapCurveState(rateTimes, 2);
+    cmSwapCurveState.setOnCMSwapRates(rates);
+
+    // one row for each alive rate and numeraire, in the order used
+    // in the loop below; the drifts of dead rates are not checked
+    Real cachedLmmDrifts[][3] = {
+        { 0.00025490196078431374,
+          0.00057037729517234767,
+          0.0010682007181786186 },
+        { 0.0,
+          0.00028606356968215158,
+          0.00077898503190410885 },
+        { -0.00025525672371638146,
+          0.0,
+          0.00049512195121951229 },
+        { -0.00065818355298467423,
+          -0.00044048780487804891,
+          0.0 },
+        { 0.0,
+          0.00028606356968215158,
+          0.00077898503190410885 },
+        { 0.0,
+          0.0,
+          0.00049512195121951229 },
+        { 0.0,
+          -0.00044048780487804891,
+          0.0 },
+        { 0.0,
+          0.0,
+          0.00049512195121951229 },
+        { 0.0,
+          0.0,
+          0.0 }
+    };
+    Real cachedNormalDrifts[][3] = {
+        { 0.0050980392156862748,
+          0.012043242724962846,
+          0.019165552916855216 },
+        { 0.0,
+          0.0063569682151589247,
+          0.013381239191365021 },
+        { -0.0056723716381418101,
+          0.0,
+          0.0070731707317073173 },
+        { -0.011428469199117421,
+          -0.0062926829268292687,
+          0.0 },
+        { 0.0,
+          0.0063569682151589247,
+          0.013381239191365021 },
+        { 0.0,
+          0.0,
+          0.0070731707317073173 },
+        { 0.0,
+          -0.0062926829268292687,
+          0.0 },
+        { 0.0,
+          0.0,
+          0.0070731707317073173 },
+        { 0.0,
+          0.0,
+          0.0 }
+    };
+    Real cachedSmmDrifts[][3] = {
+        { 0.00046041573979213666,
+          0.00063583945692847869,
+          0.00087426003587205237 },
+        { 0.00020472521089633195,
+          0.00035325438415880161,
+          0.00057306473788032756 },
+        { 9.3271025160739156e-05,
+          0.00021752484191508585,
+          0.00049512195121951218 },
+        { -0.00030965580410755353,
+          -0.00022296296296296295,
+          0.0 },
+        { 0.0,
+          0.00035325438415880161,
+          0.00057306473788032756 },
+        { 0.0,
+          0.00021752484191508585,
+          0.00049512195121951218 },
+        { 0.0,
+          -0.00022296296296296295,
+          0.0 },
+        { 0.0,
+          0.0,
+          0.00049512195121951218 },
+        { 0.0,
+          0.0,
+          0.0 }
+    };
+    Real cachedCmsmmDrifts[][3] = {
+        { 0.0004507254827578572,
+          0.00078325536978624661,
+          0.0010694274253952218 },
+        { 5.5173674003553356e-05,
+          0.00035325438415880161,
+          0.00057306473788032745 },
+        { -5.6280511732039254e-05,
+          0.00021752484191508591,
+          0.0004951219512195124 },
+        { -0.00045920734100033208,
+          -0.000222962962962963,
+          0.0 },
+        { 0.0,
+          0.00035325438415880161,
+          0.00057306473788032745 },
+        { 0.0,
+          0.00021752484191508591,
+          0.0004951219512195124 },
+        { 0.0,
+          -0.000222962962962963,
+          0.0 },
+        { 0.0,
+          0.0,
+          0.0004951219512195124 },
+        { 0.0,
+          0.0,
+          0.0 }
+    };
+
+    Real tolerance = 1.0e-15;
+    Size row = 0;
+    for (Size alive=0; alive<n; ++alive) {
+        for (Size numeraire=alive; numeraire<=n; ++numeraire, ++row) {
+            std::vector<std::vector<Real> > drifts(6, std::vector<Real>(n));
+            std::vector<Real*> expected(6);
+            std::vector<std::string> names(6);
+
+            LMMDriftCalculator lmm(pseudo, displacements, taus,
+                                   numeraire, alive);
+            lmm.computePlain(lmmCurveState, drifts[0]);
+            lmm.computeReduced(lmmCurveState, drifts[1]);
+            expected[0] = expected[1] = cachedLmmDrifts[row];
+            names[0] = "LMM, full factor";
+            names[1] = "LMM, reduced factor";
+
+            LMMNormalDriftCalculator normal(pseudo, taus, numeraire, alive);
+            normal.computePlain(lmmCurveState, drifts[2]);
+            normal.computeReduced(lmmCurveState, drifts[3]);
+            expected[2] = expected[3] = cachedNormalDrifts[row];
+            names[2] = "normal LMM, full factor";
+            names[3] = "normal LMM, reduced factor";
+
+            SMMDriftCalculator smm(pseudo, displacements, taus,
+                                   numeraire, alive);
+            smm.compute(coterminalCurveState, drifts[4]);
+            expected[4] = cachedSmmDrifts[row];
+            names[4] = "SMM";
+
+            CMSMMDriftCalculator cmsmm(pseudo, displacements, taus,
+                                       numeraire, alive, 2);
+            cmsmm.compute(cmSwapCurveState, drifts[5]);
+            expected[5] = cachedCmsmmDrifts[row];
+            names[5] = "CMSMM";
+
+            for (Size k=0; k<drifts.size(); ++k) {
+                for (Size i=alive; i<n; ++i) {
+                    Real error = std::fabs(drifts[k][i]-expected[k][i]);
+                    if (error > tolerance)
+                        BOOST_ERROR(names[k] << " drift calculator:"
+                                    << "\n    alive:     " << alive
+                                    << "\n    numeraire: " << numeraire
+                                    << "\n    rate:      " << i
+                                    << std::setprecision(17)
+                                    << "\n    drift:     " << drifts[k][i]
+                                    << "\n    expected:  " << expected[k][i]
+                                    << "\n    error:     " << error);
+                }
+            }
+        }
+    }
+}
+
 void MarketModelTest::testIsInSubset() {
 
     // Performance test for isInSubset function (temporary)
@@ -4878,6 +5081,112 @@ void MarketModelTest::testCovariance() {
 }
 
 // --- Call the desired tests
+void MarketModelTest::testParallelAccountingEngines() {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded accounting engines "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> > payoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        payoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    MultiStepOptionlets product(rateTimes, accruals,
+                                paymentTimes, payoffs);
+    EvolutionDescription evolution = product.evolution();
+    // the iterative predictor-corrector requires the terminal measure
+    std::vector<Size> numeraires = makeMeasure(product, Terminal);
+
+    Size factors = 3;
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+    MTBrownianGeneratorFactory mtFactory(seed_);
+    SobolBrownianGeneratorFactory sobolFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+    const BrownianGeneratorFactory* factories[] = { &mtFactory,
+                                                    &sobolFactory };
+    EvolverType evolvers[] = { Pc, Balland, Ipc };
+
+    // two batches, to check that the sequence is resumed correctly
+    Size batches[] = { 500, 253 };
+    Size threads = 3;
+
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    for (Size i=0; i<LENGTH(factories); ++i) {
+        for (Size j=0; j<LENGTH(evolvers); ++j) {
+            AccountingEngine serial(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       *factories[i], evolvers[j]),
+                product, initialNumeraireValue);
+            AccountingEngine parallel(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       *factories[i], evolvers[j]),
+                product, initialNumeraireValue, threads);
+
+            SequenceStatisticsInc serialStats(product.numberOfProducts()),
+                                  parallelStats(product.numberOfProducts());
+            for (Size k=0; k<LENGTH(batches); ++k) {
+                serial.multiplePathValues(serialStats, batches[k]);
+                parallel.multiplePathValues(parallelStats, batches[k]);
+
+                std::vector<Real> expected = serialStats.mean();
+                std::vector<Real> calculated = parallelStats.mean();
+                for (Size l=0; l<expected.size(); ++l) {
+                    if (calculated[l] != expected[l])
+                        BOOST_ERROR("failed to reproduce single-threaded "
+                                    "results"
+                                    << "\n    generator:  " << i
+                                    << "\n    evolver:    "
+                                    << evolverTypeToString(evolvers[j])
+                                    << "\n    batch:      " << k
+                                    << "\n    product:    " << l
+                                    << std::setprecision(16)
+                                    << "\n    expected:   " << expected[l]
+                                    << "\n    calculated: " << calculated[l]);
+                }
+            }
+        }
+    }
+
+    // pathwise deltas
+    MarketModelPathwiseMultiCaplet pathwiseProduct(rateTimes, accruals,
+                                                   paymentTimes,
+                                                   todaysForwards);
+    Size values = pathwiseProduct.numberOfProducts()*(todaysForwards.size()+1);
+    numeraires = makeMeasure(product, MoneyMarket);
+    initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    PathwiseAccountingEngine serial(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, mtFactory, numeraires)),
+        pathwiseProduct, marketModel, initialNumeraireValue);
+    PathwiseAccountingEngine parallel(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, mtFactory, numeraires)),
+        pathwiseProduct, marketModel, initialNumeraireValue, threads);
+
+    SequenceStatisticsInc serialStats(values), parallelStats(values);
+    for (Size k=0; k<LENGTH(batches); ++k) {
+        serial.multiplePathValues(serialStats, batches[k]);
+        parallel.multiplePathValues(parallelStats, batches[k]);
+
+        std::vector<Real> expected = serialStats.mean();
+        std::vector<Real> calculated = parallelStats.mean();
+        for (Size l=0; l<expected.size(); ++l) {
+            if (calculated[l] != expected[l])
+                BOOST_ERROR("failed to reproduce single-threaded "
+                            "pathwise results"
+                            << "\n    batch:      " << k
+                            << "\n    value:      " << l
+                            << std::setprecision(16)
+                            << "\n    expected:   " << expected[l]
+                            << "\n    calculated: " << calculated[l]);
+        }
+    }
+}
+
 test_suite* MarketModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Market-model tests");
 
@@ -4907,10 +5216,12 @@ test_suite* MarketModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPeriodAdapter));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCachedDrifts));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testIsInSubset));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCovariance));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelAccountingEngines));
 
     return suite;
 }
@@ -47,9 +47,11 @@ class MarketModelTest {
     static void testAbcdVolatilityCompare();
     static void testAbcdVolatilityFit();
     static void testDriftCalculator();
+    static void testCachedDrifts();
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
+    static void testParallelAccountingEngines();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -0,0 +1,394 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "marketsnapshot.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/snapshots/marketsnapshot.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionconstantvol.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <fstream>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+    // removes the snapshot file at the end of the test
+    class SnapshotFile {
+      public:
+        SnapshotFile() : name_("quantlib-snapshot-test.bin") {}
+        ~SnapshotFile() { std::remove(name_.c_str()); }
+        const std::string& name() const { return name_; }
+      private:
+        std::string name_;
+    };
+
+    typedef PiecewiseYieldCurve<Discount, LogLinear> Curve;
+
+    struct CurveData {
+        std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+        std::vector<boost::shared_ptr<RateHelper> > helpers;
+    };
+
+    CurveData curveData() {
+        Integer depositMonths[] = { 1, 3, 6, 9 };
+        Rate depositRates[] = { 0.0345, 0.0352, 0.0361, 0.0368 };
+        Integer swapYears[] = { 2, 3, 5, 7, 10, 15, 20 };
+        Rate swapRates[] = { 0.0391, 0.0405, 0.0423, 0.0437, 0.0451,
+                             0.0466, 0.0472 };
+
+        CurveData data;
+        boost::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+        for (Size i=0; i<LENGTH(depositMonths); ++i) {
+            boost::shared_ptr<SimpleQuote> q(
+                                         new SimpleQuote(depositRates[i]));
+            data.quotes.push_back(q);
+            data.helpers.push_back(boost::shared_ptr<RateHelper>(
+                new DepositRateHelper(Handle<Quote>(q),
+                                      depositMonths[i]*Months,
+                                      2, TARGET(), ModifiedFollowing,
+                                      true, Actual360())));
+        }
+        for (Size i=0; i<LENGTH(swapYears); ++i) {
+            boost::shared_ptr<SimpleQuote> q(new SimpleQuote(swapRates[i]));
+            data.quotes.push_back(q);
+            data.helpers.push_back(boost::shared_ptr<RateHelper>(
+                new SwapRateHelper(Handle<Quote>(q), swapYears[i]*Years,
+                                   TARGET(), Annual, Unadjusted,
+                                   Thirty360(), euribor6m)));
+        }
+        return data;
+    }
+
+}
+
+
+void MarketSnapshotTest::testSnapshotRecords() {
+
+    BOOST_TEST_MESSAGE("Testing snapshot records...");
+
+    SnapshotFile file;
+
+    std::vector<Real> values;
+    values.push_back(1.5);
+    values.push_back(-2.25);
+    values.push_back(1.0e-300);
+    std::vector<Date> dates;
+    dates.push_back(Date(15, March, 2016));
+    dates.push_back(Date(31, December, 2199));
+    Matrix m(3, 2);
+    for (Size i=0; i<m.rows(); ++i)
+        for (Size j=0; j<m.columns(); ++j)
+            m[i][j] = 0.1*i + j;
+
+    SnapshotWriter writer;
+    writer.add("values", values);
+    writer.add("dates", dates);
+    writer.add("a matrix", m);
+    writer.add("empty", std::vector<Real>());
+    writer.save(file.name());
+
+    Snapshot snapshot(file.name());
+
+    if (snapshot.names().size() != 4)
+        BOOST_FAIL("wrong number of records: " << snapshot.names().size()
+                   << " instead of 4");
+    if (snapshot.has("missing"))
+        BOOST_ERROR("unexpected record found in snapshot");
+
+    if (snapshot.values("values") != values)
+        BOOST_ERROR("failed to read back values");
+    if (snapshot.dates("dates") != dates)
+        BOOST_ERROR("failed to read back dates");
+    if (snapshot.rows("empty") != 0
+        || snapshot.begin("empty") != snapshot.end("empty"))
+        BOOST_ERROR("failed to read back empty record");
+
+    Matrix read = snapshot.matrix("a matrix");
+    if (read.rows() != m.rows() || read.columns() != m.columns()
+        || !std::equal(m.begin(), m.end(), read.begin()))
+        BOOST_ERROR("failed to read back matrix");
+
+    // copies share the mapping
+    Snapshot copy = snapshot;
+    if (copy.begin("values") != snapshot.begin("values"))
+        BOOST_ERROR("snapshot copy doesn't share the mapped data");
+}
+
+
+void MarketSnapshotTest::testCurveRestore() {
+
+    BOOST_TEST_MESSAGE("Testing restoring a bootstrapped curve "
+                       "from a snapshot...");
+
+    SavedSettings backup;
+    Settings::instance().evaluationDate() = Date(15, March, 2016);
+
+    SnapshotFile file;
+    CurveData data = curveData();
+
+    {
+        boost::shared_ptr<Curve> curve(new Curve(0, TARGET(),
+                                                 data.helpers, Actual360()));
+        curve->recalculate();
+
+        SnapshotWriter writer;
+        saveCurve(writer, "curve", *curve);
+        writer.save(file.name());
+    }
+
+    Snapshot snapshot(file.name());
+
+    // a new curve on the same quotes accepts the stored state
+    boost::shared_ptr<Curve> curve(new Curve(0, TARGET(),
+                                             data.helpers, Actual360()));
+    if (!restoreCurve(snapshot, "curve", *curve))
+        BOOST_FAIL("restored curve state was not accepted");
+
+    const std::vector<Real> stored = snapshot.values("curve.data");
+    const std::vector<Real>& restored = curve->data();
+    if (curve->bootstrap().iterations() != 0)
+        BOOST_ERROR("restored curve was bootstrapped again");
+    if (restored != stored)
+        BOOST_ERROR("restored curve nodes differ from stored ones");
+
+    Real tolerance = 1.0e-9;
+    for (Size i=0; i<data.helpers.size(); ++i) {
+        Real error = std::fabs(data.helpers[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " helper not repriced by the "
+                        "restored curve:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+
+    // changed quotes are detected before the state is trusted; the
+    // state is used as a guess and the curve is bootstrapped again
+    data.quotes[5]->setValue(data.quotes[5]->value() + 0.0010);
+    boost::shared_ptr<Curve> changed(new Curve(0, TARGET(),
+                                               data.helpers, Actual360()));
+    if (restoreCurve(snapshot, "curve", *changed))
+        BOOST_ERROR("curve state restored with changed quotes");
+    for (Size i=0; i<data.helpers.size(); ++i) {
+        Real error = std::fabs(data.helpers[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " helper not repriced after "
+                        "rejecting a stale state:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+}
+
+
+void MarketSnapshotTest::testModelAndFixingsRestore() {
+
+    BOOST_TEST_MESSAGE("Testing restoring model parameters and fixings "
+                       "from a snapshot...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    SnapshotFile file;
+
+    Handle<YieldTermStructure> riskFree(flatRate(today, 0.03, Actual360()));
+    Handle<YieldTermStructure> dividend(flatRate(today, 0.01, Actual360()));
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonModel> calibrated(new HestonModel(
+        boost::shared_ptr<HestonProcess>(new HestonProcess(
+            riskFree, dividend, spot, 0.04, 1.5, 0.05, 0.4, -0.6))));
+
+    Euribor6M euribor;
+    Date fixingDate = euribor.fixingCalendar().adjust(today - 30);
+    for (Size i=0; i<10; ++i) {
+        euribor.addFixing(fixingDate, 0.01 + 0.001*i);
+        fixingDate = euribor.fixingCalendar().advance(fixingDate, 1, Days);
+    }
+    const TimeSeries<Real> fixings = euribor.timeSeries();
+
+    std::vector<std::string> names = IndexManager::instance().histories();
+    Size histories = 0;
+    for (Size i=0; i<names.size(); ++i) {
+        if (!IndexManager::instance().getHistory(names[i]).empty())
+            ++histories;
+    }
+
+    SnapshotWriter writer;
+    saveModel(writer, "heston", *calibrated);
+    saveFixings(writer);
+    writer.save(file.name());
+
+    IndexManager::instance().clearHistories();
+
+    Snapshot snapshot(file.name());
+
+    HestonModel model(boost::shared_ptr<HestonProcess>(new HestonProcess(
+                    riskFree, dividend, spot, 0.01, 1.0, 0.01, 0.1, 0.0)));
+    if (!restoreModel(snapshot, "heston", model))
+        BOOST_FAIL("failed to restore model parameters");
+    Array expected = calibrated->params(), params = model.params();
+    for (Size i=0; i<expected.size(); ++i) {
+        if (params[i] != expected[i])
+            BOOST_ERROR("failed to restore " << io::ordinal(i+1)
+                        << " model parameter:"
+                        << "\n    restored: " << params[i]
+                        << "\n    expected: " << expected[i]);
+    }
+
+    if (restoreFixings(snapshot) != histories)
+        BOOST_ERROR("wrong number of restored fixing histories");
+    const TimeSeries<Real> restored = euribor.timeSeries();
+    if (restored.size() != fixings.size()
+        || !std::equal(fixings.begin(), fixings.end(), restored.begin()))
+        BOOST_ERROR("failed to restore fixing history");
+}
+
+
+void MarketSnapshotTest::testCorruptedSnapshot() {
+
+    BOOST_TEST_MESSAGE("Testing detection of corrupted record sizes "
+                       "in snapshots...");
+
+    SnapshotFile file;
+
+    // the rows and columns of the first record follow the 24-byte
+    // file header and the 8-byte name length
+    const std::streamoff rowsOffset = 32;
+    const boost::uint64_t sizes[][2] = {
+        // larger than the file
+        { 1000, 2 },
+        // the product overflows and wraps around to 0
+        { boost::uint64_t(1) << 61, 8 }
+    };
+
+    for (Size i=0; i<LENGTH(sizes); ++i) {
+        SnapshotWriter writer;
+        writer.add("values", std::vector<Real>(4, 1.0));
+        writer.save(file.name());
+
+        {
+            std::fstream f(file.name().c_str(), std::ios::in |
+                           std::ios::out | std::ios::binary);
+            f.seekp(rowsOffset);
+            f.write(reinterpret_cast<const char*>(sizes[i]),
+                    sizeof(sizes[i]));
+        }
+
+        BOOST_CHECK_THROW(Snapshot s(file.name()), Error);
+    }
+}
+
+
+void MarketSnapshotTest::testSabrParametersGuess() {
+
+    BOOST_TEST_MESSAGE("Testing validation of stored SABR parameters...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    SnapshotFile file;
+
+    boost::shared_ptr<SimpleQuote> atmQuote(new SimpleQuote(0.20));
+    Handle<SwaptionVolatilityStructure> atmVol(
+        boost::shared_ptr<SwaptionVolatilityStructure>(
+            new ConstantSwaptionVolatility(today, TARGET(), Following,
+                                           Handle<Quote>(atmQuote),
+                                           Actual365Fixed())));
+
+    // swap length, option time, alpha, beta, nu, rho, forward
+    // and further calibration results, as in the sparse
+    // parameters of SwaptionVolCube1
+    Matrix parameters(2, 10, 0.0);
+    for (Size i=0; i<parameters.rows(); ++i) {
+        parameters[i][0] = 5.0;
+        parameters[i][1] = 1.0 + i;
+        parameters[i][2] = 0.04;
+        parameters[i][3] = 0.5;
+        parameters[i][4] = 0.4;
+        parameters[i][5] = -0.3;
+        parameters[i][6] = 0.03 + 0.001*i;
+    }
+
+    std::vector<std::vector<Handle<Quote> > > volSpreads(2);
+    for (Size i=0; i<volSpreads.size(); ++i) {
+        volSpreads[i].push_back(Handle<Quote>(
+                          boost::shared_ptr<Quote>(new SimpleQuote(0.01))));
+        volSpreads[i].push_back(Handle<Quote>(
+                          boost::shared_ptr<Quote>(new SimpleQuote(-0.01))));
+    }
+    std::vector<Handle<Quote> > quotes;
+    for (Size i=0; i<volSpreads.size(); ++i)
+        quotes.insert(quotes.end(),
+                      volSpreads[i].begin(), volSpreads[i].end());
+
+    SnapshotWriter writer;
+    writer.add("sabr", parameters);
+    writer.add("sabr.atm",
+               detail::sabrAtmVolatilities(parameters, atmVol));
+    saveQuotes(writer, "sabr.quotes", quotes);
+    writer.save(file.name());
+
+    Snapshot snapshot(file.name());
+
+    std::vector<std::vector<Handle<Quote> > > guess =
+        sabrParametersGuess(snapshot, "sabr", atmVol, volSpreads);
+    if (guess.size() != parameters.rows())
+        BOOST_FAIL("stored SABR parameters not accepted");
+    for (Size i=0; i<guess.size(); ++i) {
+        for (Size j=0; j<4; ++j) {
+            if (guess[i][j]->value() != parameters[i][j+2])
+                BOOST_ERROR("failed to restore SABR parameter ("
+                            << i << "," << j << "):"
+                            << "\n    restored: " << guess[i][j]->value()
+                            << "\n    expected: " << parameters[i][j+2]);
+        }
+    }
+
+    atmQuote->setValue(0.21);
+    if (!sabrParametersGuess(snapshot, "sabr", atmVol, volSpreads).empty())
+        BOOST_ERROR("SABR parameters accepted with changed ATM volatility");
+}
+
+
+test_suite* MarketSnapshotTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Market snapshot tests");
+    suite->add(QUANTLIB_TEST_CASE(&MarketSnapshotTest::testSnapshotRecords));
+    suite->add(QUANTLIB_TEST_CASE(&MarketSnapshotTest::testCurveRestore));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &MarketSnapshotTest::testModelAndFixingsRestore));
+    suite->add(QUANTLIB_TEST_CASE(&MarketSnapshotTest::testCorruptedSnapshot));
+    suite->add(QUANTLIB_TEST_CASE(
+                               &MarketSnapshotTest::testSabrParametersGuess));
+    return suite;
+}
@@ -315,6 +315,74 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testParallelCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded Longstaff-Schwartz "
+                       "calibration...");
+
+    SavedSettings backup;
+
+    const Date todaysDate(15, May, 1998);
+    const Date settlementDate(17, May, 1998);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Date maturity(16, May, 2001);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<Exercise> americanExercise(
+        new AmericanExercise(settlementDate, maturity));
+
+    Handle<YieldTermStructure> flatTermStructure(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.05, dayCounter)));
+    Handle<YieldTermStructure> flatDividendTS(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.10, dayCounter)));
+    Handle<BlackVolTermStructure> flatVolTS(
+        boost::shared_ptr<BlackVolTermStructure>(new
+            BlackConstantVol(settlementDate, NullCalendar(),
+                             0.20, dayCounter)));
+    Handle<Quote> underlyingH(
+        boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<StochasticProcess1D> stochasticProcess(new
+        GeneralizedBlackScholesProcess(
+            underlyingH, flatDividendTS, flatTermStructure, flatVolTS));
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > v(2,
+                                                         stochasticProcess);
+    Matrix corr(2, 2, 0.0);
+    corr[0][0] = corr[1][1] = 1.0;
+    boost::shared_ptr<StochasticProcessArray> process(
+        new StochasticProcessArray(v, corr));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Call, 100.0));
+    VanillaOption americanMaxOption(payoff, americanExercise);
+
+    // enough calibration paths to be split in several chunks
+    boost::shared_ptr<MCAmericanMaxEngine<PseudoRandom> > engine(
+        new MCAmericanMaxEngine<PseudoRandom>(process, 25, Null<Size>(),
+                                              false, true, false, 4096,
+                                              Null<Real>(), Null<Size>(),
+                                              42, 2000));
+    americanMaxOption.setPricingEngine(engine);
+    const Real expected = americanMaxOption.NPV();
+
+    Size threads[] = { 2, 4 };
+    for (Size i=0; i<LENGTH(threads); ++i) {
+        engine->setThreads(threads[i]);
+        americanMaxOption.recalculate();
+        const Real calculated = americanMaxOption.NPV();
+        if (std::fabs(calculated - expected) > 1.0e-6) {
+            BOOST_ERROR("Failed to reproduce single-threaded price"
+                        << "\n    threads:    " << threads[i]
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << calculated);
+        }
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -322,6 +390,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testParallelCalibration));
     return suite;
 }
 
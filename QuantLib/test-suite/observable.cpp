@@ -21,6 +21,8 @@
 #include "utilities.hpp"
 #include <ql/patterns/observable.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <boost/timer.hpp>
+#include <vector>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -36,6 +38,28 @@ namespace {
       private:
         Size counter_;
     };
+
+    // forwards notifications, as a non-lazy curve or instrument would
+    class ForwardingNode : public Observer, public Observable {
+      public:
+        ForwardingNode() : counter_(0) {}
+        void update() {
+            ++counter_;
+            notifyObservers();
+        }
+        Size counter() { return counter_; }
+      private:
+        Size counter_;
+    };
+
+    struct CoalescedUpdatesGuard {
+        explicit CoalescedUpdatesGuard(bool flag) {
+            ObservableSettings::instance().coalesceUpdates(flag);
+        }
+        ~CoalescedUpdatesGuard() {
+            ObservableSettings::instance().coalesceUpdates(false);
+        }
+    };
 }
 
 void ObservableTest::testObservableSettings() {
@@ -91,6 +115,142 @@ void ObservableTest::testObservableSettings() {
 }
 
 
+void ObservableTest::testCoalescedUpdates() {
+
+    BOOST_TEST_MESSAGE("Testing coalesced notifications...");
+
+    // quote -> (left, right) -> bottom -> leaf, i.e., a diamond
+    const boost::shared_ptr<SimpleQuote> quote(new SimpleQuote(100.0));
+    const boost::shared_ptr<ForwardingNode> left(new ForwardingNode);
+    const boost::shared_ptr<ForwardingNode> right(new ForwardingNode);
+    const boost::shared_ptr<ForwardingNode> bottom(new ForwardingNode);
+    UpdateCounter leaf;
+
+    left->registerWith(quote);
+    right->registerWith(quote);
+    bottom->registerWith(left);
+    bottom->registerWith(right);
+    leaf.registerWith(bottom);
+
+    quote->setValue(1.0);
+    if (bottom->counter() != 2 || leaf.counter() != 2) {
+        BOOST_FAIL("two notifications expected through the diamond, got "
+                   << bottom->counter() << " and " << leaf.counter());
+    }
+
+    CoalescedUpdatesGuard guard(true);
+
+    quote->setValue(2.0);
+    if (left->counter() != 2 || right->counter() != 2
+        || bottom->counter() != 3 || leaf.counter() != 3) {
+        BOOST_FAIL("one notification expected for each observer in "
+                   "coalesced mode");
+    }
+
+    // a second tick starts a new cascade
+    quote->setValue(3.0);
+    if (bottom->counter() != 4 || leaf.counter() != 4) {
+        BOOST_FAIL("observers not notified in new cascade");
+    }
+
+    // deferred updates are sent in a single cascade
+    const boost::shared_ptr<SimpleQuote> quote2(new SimpleQuote(100.0));
+    right->unregisterWith(quote);
+    right->registerWith(quote2);
+    ObservableSettings::instance().disableUpdates(true);
+    for (Size i=0; i<10; ++i) {
+        quote->setValue(Real(i));
+        quote2->setValue(Real(i));
+    }
+    if (bottom->counter() != 4) {
+        BOOST_FAIL("notification should have been deferred");
+    }
+    ObservableSettings::instance().enableUpdates();
+    if (left->counter() != 4 || right->counter() != 4
+        || bottom->counter() != 5 || leaf.counter() != 5) {
+        BOOST_FAIL("one notification expected for each observer after "
+                   "re-enabling updates");
+    }
+}
+
+
+void ObservableTest::testNotificationLatency() {
+
+    BOOST_TEST_MESSAGE("Testing notification latency "
+                       "with and without coalescing...");
+
+    // a layered graph resembling books of instruments priced off a
+    // set of curves bootstrapped on partly shared market quotes
+    const Size sharedQuotes = 5, ownQuotes = 10, nQuotes = 100;
+    const Size nCurves = 20, nInstruments = 5000, curvesPerInstrument = 3;
+    const Size nBooks = 50, instrumentsPerBook = nInstruments/nBooks;
+    const Size ticks = 20;
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes(nQuotes);
+    std::vector<boost::shared_ptr<ForwardingNode> > curves(nCurves);
+    std::vector<boost::shared_ptr<ForwardingNode> > instruments(nInstruments);
+    std::vector<boost::shared_ptr<ForwardingNode> > books(nBooks);
+    Size i, j;
+    for (i=0; i<nQuotes; ++i)
+        quotes[i] = boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.01));
+    for (i=0; i<nCurves; ++i) {
+        curves[i] = boost::shared_ptr<ForwardingNode>(new ForwardingNode);
+        for (j=0; j<sharedQuotes; ++j)
+            curves[i]->registerWith(quotes[j]);
+        for (j=0; j<ownQuotes; ++j)
+            curves[i]->registerWith(
+                quotes[sharedQuotes + (i*ownQuotes+j)%(nQuotes-sharedQuotes)]);
+    }
+    for (i=0; i<nInstruments; ++i) {
+        instruments[i] =
+            boost::shared_ptr<ForwardingNode>(new ForwardingNode);
+        for (j=0; j<curvesPerInstrument; ++j)
+            instruments[i]->registerWith(curves[(i+j)%nCurves]);
+    }
+    for (i=0; i<nBooks; ++i) {
+        books[i] = boost::shared_ptr<ForwardingNode>(new ForwardingNode);
+        for (j=0; j<instrumentsPerBook; ++j)
+            books[i]->registerWith(instruments[i*instrumentsPerBook+j]);
+    }
+
+    // ticking a shared quote reaches each instrument through each
+    // of its curves, and each book through each of its instruments,
+    // unless notifications are coalesced
+    Real elapsed[2];
+    for (Size mode=0; mode<2; ++mode) {
+        const bool coalesced = (mode == 1);
+        CoalescedUpdatesGuard guard(coalesced);
+
+        Size before = 0;
+        for (i=0; i<nBooks; ++i)
+            before += books[i]->counter();
+
+        boost::timer t;
+        for (Size k=0; k<ticks; ++k)
+            quotes[0]->setValue(0.01*k);
+        elapsed[mode] = t.elapsed();
+
+        Size after = 0;
+        for (i=0; i<nBooks; ++i)
+            after += books[i]->counter();
+
+        const Size expected = ticks*nBooks*
+            (coalesced ? 1 : instrumentsPerBook*curvesPerInstrument);
+        if (after-before != expected)
+            BOOST_FAIL("unexpected number of book updates "
+                       << (coalesced ? "with" : "without")
+                       << " coalescing:\n"
+                       << "    calculated: " << after-before << "\n"
+                       << "    expected:   " << expected);
+
+        BOOST_TEST_MESSAGE("    " << (coalesced ? "with" : "without")
+                           << " coalescing: "
+                           << elapsed[mode]/ticks*1.0e6
+                           << " microseconds per tick");
+    }
+}
+
+
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
 #include <boost/atomic.hpp>
@@ -250,11 +410,125 @@ void ObservableTest::testMultiThreadingGlobalSettings() {
 #endif
 
 
+#ifdef QL_ENABLE_PROFILING
+
+#include <ql/utilities/profiling.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <sstream>
+
+void ObservableTest::testProfiling() {
+
+    BOOST_TEST_MESSAGE("Testing profiling of calculations "
+                       "and notifications...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.01));
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.03));
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(
+                                          flatRate(today, qRate, dc)),
+                                      Handle<YieldTermStructure>(
+                                          flatRate(today, rRate, dc)),
+                                      Handle<BlackVolTermStructure>(
+                                          flatVol(today, vol, dc))));
+
+    VanillaOption option(
+        boost::shared_ptr<StrikedTypePayoff>(
+                                    new PlainVanillaPayoff(Option::Call, 100.0)),
+        boost::shared_ptr<Exercise>(
+                                new EuropeanExercise(today + 6*Months)));
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+
+    Profiler& profiler = Profiler::instance();
+    profiler.reset();
+    profiler.enable();
+
+    option.NPV();
+    spot->setValue(101.0);
+    option.NPV();
+
+    Profiler::Entry calculations =
+        profiler.entry(Profiler::Calculation, "QuantLib::VanillaOption");
+    Profiler::Entry engineCalculations =
+        profiler.entry(Profiler::EngineCalculation,
+                       "QuantLib::AnalyticEuropeanEngine");
+    Profiler::Entry curveCalculations =
+        profiler.entry(Profiler::Calculation, "QuantLib::FlatForward");
+    Profiler::Entry notifications =
+        profiler.entry(Profiler::Notification, "QuantLib::SimpleQuote");
+
+    if (calculations.count != 2)
+        BOOST_ERROR("two instrument calculations expected, "
+                    << calculations.count << " recorded");
+    if (engineCalculations.count != 2)
+        BOOST_ERROR("two engine calculations expected, "
+                    << engineCalculations.count << " recorded");
+    if (engineCalculations.time > calculations.time)
+        BOOST_ERROR("engine time (" << engineCalculations.time
+                    << " s) larger than instrument time ("
+                    << calculations.time << " s)");
+    // each curve is only calculated the first time
+    if (curveCalculations.count != 2)
+        BOOST_ERROR("two curve calculations expected, "
+                    << curveCalculations.count << " recorded");
+    if (notifications.count != 1)
+        BOOST_ERROR("one quote notification expected, "
+                    << notifications.count << " recorded");
+
+    #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    if (notifications.observers != 1)
+        BOOST_ERROR("one observer of the quote expected, "
+                    << notifications.observers << " recorded");
+
+    std::ostringstream graph;
+    profiler.dumpGraph(graph);
+    if (graph.str().find("\"QuantLib::SimpleQuote\" -> ") == std::string::npos)
+        BOOST_ERROR("quote dependency not found in graph:\n"
+                    << graph.str());
+    #endif
+
+    std::ostringstream profile;
+    profiler.dumpProfile(profile);
+    if (profile.str().find("QuantLib::VanillaOption") == std::string::npos)
+        BOOST_ERROR("instrument not found in profile:\n" << profile.str());
+
+    // nothing is recorded when profiling is disabled...
+    profiler.disable();
+    spot->setValue(102.0);
+    option.NPV();
+    calculations =
+        profiler.entry(Profiler::Calculation, "QuantLib::VanillaOption");
+    if (calculations.count != 2)
+        BOOST_ERROR("calculation recorded while profiling was disabled");
+
+    // ...and the recorded data are cleared on reset
+    profiler.reset();
+    calculations =
+        profiler.entry(Profiler::Calculation, "QuantLib::VanillaOption");
+    if (calculations.count != 0)
+        BOOST_ERROR("calculations recorded after reset");
+}
+
+#endif
+
 
 test_suite* ObservableTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Observer tests");
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObservableSettings));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testCoalescedUpdates));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testNotificationLatency));
 
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testAsyncGarbagCollector));
@@ -262,6 +536,10 @@ test_suite* ObservableTest::suite() {
         &ObservableTest::testMultiThreadingGlobalSettings));
 #endif
 
+#ifdef QL_ENABLE_PROFILING
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testProfiling));
+#endif
+
     return suite;
 }
 
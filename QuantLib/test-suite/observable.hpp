@@ -28,8 +28,11 @@
 class ObservableTest {
   public:
     static void testObservableSettings();
+    static void testCoalescedUpdates();
+    static void testNotificationLatency();
     static void testAsyncGarbagCollector();
     static void testMultiThreadingGlobalSettings();
+    static void testProfiling();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -22,6 +22,8 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/hullwhiteprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -138,6 +140,112 @@ namespace {
         }
     }
 
+    void testSingleBatch(const boost::shared_ptr<StochasticProcess1D>& process,
+                         const std::string& tag, bool brownianBridge) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef PathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12;
+        Size samples = 7;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(timeSteps, seed);
+        PathGenerator<rsg_type> batchGenerator(process, length, timeSteps,
+                                               rsg, brownianBridge);
+        PathGenerator<rsg_type> generator(process, length, timeSteps,
+                                          rsg, brownianBridge);
+
+        Matrix paths, antitheticPaths;
+        Array weights, antitheticWeights;
+        Real tolerance = 1.0e-10;
+        for (Size batch=0; batch<2; batch++) {
+            batchGenerator.nextBatch(samples, paths, weights);
+            batchGenerator.antitheticBatch(antitheticPaths,
+                                           antitheticWeights);
+            for (Size j=0; j<samples; j++) {
+                sample_type sample = generator.next();
+                sample_type antithetic = generator.antithetic();
+                for (Size i=0; i<sample.value.length(); i++) {
+                    if (std::fabs(paths[i][j]-sample.value[i]) > tolerance
+                        || std::fabs(antitheticPaths[i][j]
+                                     -antithetic.value[i]) > tolerance)
+                        BOOST_FAIL("using " << tag << " process "
+                                   << (brownianBridge ? "with " : "without ")
+                                   << "brownian bridge:\n"
+                                   << "batch path " << j
+                                   << " differs from sequential path "
+                                   << "at time index " << i << ":\n"
+                                   << std::setprecision(13)
+                                   << "    batch:      " << paths[i][j]
+                                   << ", " << antitheticPaths[i][j] << "\n"
+                                   << "    sequential: " << sample.value[i]
+                                   << ", " << antithetic.value[i]);
+                }
+                if (weights[j] != sample.weight
+                    || antitheticWeights[j] != antithetic.weight)
+                    BOOST_FAIL("using " << tag << " process: "
+                               << "batch weight differs from "
+                               << "sequential weight");
+            }
+        }
+    }
+
+    void testMultipleBatch(const boost::shared_ptr<StochasticProcess>& process,
+                           const std::string& tag) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef MultiPathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12;
+        Size samples = 7;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(
+                                      timeSteps*process->factors(), seed);
+        MultiPathGenerator<rsg_type> batchGenerator(
+                              process, TimeGrid(length, timeSteps), rsg);
+        MultiPathGenerator<rsg_type> generator(
+                              process, TimeGrid(length, timeSteps), rsg);
+
+        std::vector<Matrix> paths, antitheticPaths;
+        Array weights, antitheticWeights;
+        Real tolerance = 1.0e-10;
+        for (Size batch=0; batch<2; batch++) {
+            batchGenerator.nextBatch(samples, paths, weights);
+            batchGenerator.antitheticBatch(antitheticPaths,
+                                           antitheticWeights);
+            for (Size j=0; j<samples; j++) {
+                sample_type sample = generator.next();
+                sample_type antithetic = generator.antithetic();
+                for (Size k=0; k<process->size(); k++) {
+                    for (Size i=0; i<sample.value.pathSize(); i++) {
+                        Real x = paths[k][i][j];
+                        Real y = antitheticPaths[k][i][j];
+                        if (std::fabs(x-sample.value[k][i]) > tolerance
+                            || std::fabs(y-antithetic.value[k][i])
+                                                               > tolerance)
+                            BOOST_FAIL("using " << tag << " process "
+                                       << "(" << io::ordinal(k+1)
+                                       << " asset):\n"
+                                       << "batch path " << j
+                                       << " differs from sequential path "
+                                       << "at time index " << i << ":\n"
+                                       << std::setprecision(13)
+                                       << "    batch:      " << x
+                                       << ", " << y << "\n"
+                                       << "    sequential: "
+                                       << sample.value[k][i] << ", "
+                                       << antithetic.value[k][i]);
+                    }
+                }
+                if (weights[j] != sample.weight
+                    || antitheticWeights[j] != antithetic.weight)
+                    BOOST_FAIL("using " << tag << " process: "
+                               << "batch weight differs from "
+                               << "sequential weight");
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +398,60 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testBatchGeneration() {
+
+    BOOST_TEST_MESSAGE("Testing batch path generation "
+                       "against sequential generation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    boost::shared_ptr<StochasticProcess1D> bsProcess(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testSingleBatch(bsProcess, "Black-Scholes", false);
+    testSingleBatch(bsProcess, "Black-Scholes", true);
+
+    testSingleBatch(boost::shared_ptr<StochasticProcess1D>(
+                                new HullWhiteProcess(r, 0.1, 0.01)),
+                    "Hull-White", false);
+
+    testSingleBatch(boost::shared_ptr<StochasticProcess1D>(
+                                new SquareRootProcess(0.1, 0.1, 0.20, 10.0)),
+                    "square-root", false);
+
+    testMultipleBatch(boost::shared_ptr<StochasticProcess>(
+                          new HestonProcess(r, q, x0, 0.04, 1.0, 0.04,
+                                            0.5, -0.7)),
+                      "Heston");
+    testMultipleBatch(boost::shared_ptr<StochasticProcess>(
+                          new HestonProcess(r, q, x0, 0.04, 1.0, 0.04,
+                                            0.5, -0.7,
+                                            HestonProcess::FullTruncation)),
+                      "Heston (full truncation)");
+
+    Matrix correlation(2,2);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.6;
+    correlation[1][0] = 0.6; correlation[1][1] = 1.0;
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(2,
+                                                                   bsProcess);
+    testMultipleBatch(boost::shared_ptr<StochasticProcess>(
+                          new StochasticProcessArray(processes,correlation)),
+                      "Black-Scholes array");
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBatchGeneration));
     return suite;
 }
 
@@ -48,6 +48,7 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/experimental/risk/curvebucketanalysis.hpp>
 #include <iomanip>
 
 using namespace QuantLib;
@@ -609,6 +610,157 @@ namespace {
         }
     }
 
+
+    template <class T, class I>
+    void testIncrementalConsistency(CommonVars& vars,
+                                  const I& interpolator,
+                                  bool local,
+                                  Real tolerance = 1.0e-9) {
+
+        typedef PiecewiseYieldCurve<T,I,IterativeBootstrap> Curve;
+
+        boost::shared_ptr<Curve> curve(
+            new Curve(vars.settlement, vars.instruments, Actual360(),
+                      interpolator,
+                      IterativeBootstrap<Curve>(true)));
+        curve->nodes();
+        if (curve->bootstrap().lastCalculationIncremental())
+            BOOST_ERROR("first calculation performed incrementally");
+
+        Size ticks[] = { 0, 10, 20, 3, 19 };
+        for (Size k=0; k<LENGTH(ticks); ++k) {
+            Size i = ticks[k];
+            vars.rates[i]->setValue(vars.rates[i]->value() + 0.0001);
+
+            std::vector<Real> data = curve->data();
+            const IterativeBootstrap<Curve>& bootstrap =
+                curve->bootstrap();
+            if (!bootstrap.lastCalculationIncremental())
+                BOOST_ERROR("calculation after " << io::ordinal(i+1)
+                            << " quote change not performed incrementally");
+            if (local && bootstrap.firstRecalculatedPillar() != i+1)
+                BOOST_ERROR("calculation after " << io::ordinal(i+1)
+                            << " quote change restarted from "
+                            << io::ordinal(bootstrap.firstRecalculatedPillar())
+                            << " pillar");
+            if (!local && bootstrap.newtonSteps() == 0)
+                BOOST_ERROR("no Newton steps performed after "
+                            << io::ordinal(i+1) << " quote change");
+
+            // the sensitivities must be calculated at the moved nodes;
+            // this is done before the full bootstrap below, which
+            // links the shared helpers to the other curve
+            Matrix jacobian = bootstrap.nodeJacobian();
+
+            // compare with a full bootstrap
+            Curve expected(vars.settlement, vars.instruments, Actual360(),
+                           interpolator);
+            for (Size j=0; j<data.size(); ++j) {
+                if (std::fabs(data[j]-expected.data()[j]) > tolerance)
+                    BOOST_ERROR("mismatch at node " << j
+                                << " after " << io::ordinal(i+1)
+                                << " quote change:"
+                                << std::setprecision(12)
+                                << "\n    incremental: " << data[j]
+                                << "\n    full:        "
+                                << expected.data()[j]
+                                << "\n    tolerance:   " << tolerance);
+            }
+
+            Matrix expectedJacobian = expected.bootstrap().nodeJacobian();
+            Real scale = 0.0;
+            for (Size r=0; r<jacobian.rows(); ++r)
+                for (Size c=0; c<jacobian.columns(); ++c)
+                    scale = std::max(scale,
+                                     std::fabs(expectedJacobian[r][c]));
+            for (Size r=0; r<jacobian.rows(); ++r) {
+                for (Size c=0; c<jacobian.columns(); ++c) {
+                    Real diff =
+                        std::fabs(jacobian[r][c]-expectedJacobian[r][c]);
+                    if (diff > 1.0e-4*scale)
+                        BOOST_ERROR("node Jacobian mismatch at (" << r
+                                    << "," << c << ") after "
+                                    << io::ordinal(i+1) << " quote change:"
+                                    << std::setprecision(8)
+                                    << "\n    incremental: "
+                                    << jacobian[r][c]
+                                    << "\n    full:        "
+                                    << expectedJacobian[r][c]);
+                }
+            }
+        }
+    }
+
+
+    template <class T, class I>
+    void testBucketAnalysisConsistency(CommonVars& vars,
+                                       Real tolerance = 1.0e-4) {
+
+        typedef PiecewiseYieldCurve<T,I> Curve;
+
+        boost::shared_ptr<Curve> curve(
+                  new Curve(vars.settlement, vars.instruments, Actual360()));
+        Handle<YieldTermStructure> curveHandle(curve);
+        boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(curveHandle));
+
+        Period tenors[] = { 18*Months, 4*Years, 7*Years, 13*Years };
+        Real strikes[] = { 0.045, 0.05, 0.053, 0.055 };
+        std::vector<boost::shared_ptr<Instrument> > swaps;
+        for (Size i=0; i<LENGTH(tenors); ++i) {
+            boost::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(tenors[i], euribor6m, strikes[i])
+                .withEffectiveDate(vars.settlement)
+                .withNominal(1000000.0)
+                .withFixedLegDayCount(vars.fixedLegDayCounter)
+                .withFixedLegTenor(Period(vars.fixedLegFrequency))
+                .withFixedLegConvention(vars.fixedLegConvention)
+                .withFixedLegTerminationDateConvention(
+                                                 vars.fixedLegConvention);
+            swaps.push_back(swap);
+        }
+        std::vector<Real> quantities(1, 1.0);
+
+        std::vector<boost::shared_ptr<RateHelper> > helpers =
+            curve->bootstrap().aliveHelpers();
+        std::vector<Handle<SimpleQuote> > quotes;
+        for (Size j=0; j<helpers.size(); ++j) {
+            for (Size k=0; k<vars.rates.size(); ++k) {
+                if (helpers[j]->quote().currentLink() == vars.rates[k])
+                    quotes.push_back(Handle<SimpleQuote>(vars.rates[k]));
+            }
+        }
+        BOOST_REQUIRE(quotes.size() == helpers.size());
+
+        Real npv = aggregateNPV(swaps, quantities);
+        Real shift = 1.0e-5;
+        std::vector<Real> calculated =
+            curveBucketAnalysis(curve, swaps, quantities, shift);
+
+        if (std::fabs(aggregateNPV(swaps, quantities)-npv) > 1.0e-8)
+            BOOST_ERROR("NPV not restored after bucket analysis:"
+                        << std::setprecision(12)
+                        << "\n    before: " << npv
+                        << "\n    after:  "
+                        << aggregateNPV(swaps, quantities));
+
+        std::vector<Real> expected =
+            bucketAnalysis(quotes, swaps, quantities, shift).first;
+
+        Real scale = 0.0;
+        for (Size j=0; j<expected.size(); ++j)
+            scale = std::max(scale, std::fabs(expected[j]));
+        for (Size j=0; j<expected.size(); ++j) {
+            if (std::fabs(calculated[j]-expected[j]) > tolerance*scale)
+                BOOST_ERROR("bucket sensitivity mismatch for "
+                            << io::ordinal(j+1) << " helper:"
+                            << std::setprecision(8)
+                            << "\n    from nodes:          " << calculated[j]
+                            << "\n    from bootstrapping:  " << expected[j]
+                            << "\n    tolerance:           "
+                            << tolerance*scale);
+        }
+    }
+
 }
 
 
@@ -759,6 +911,34 @@ void PiecewiseYieldCurveTest::testLocalBootstrapConsistency() {
 }
 
 
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_TEST_MESSAGE("Testing incremental bootstrap...");
+
+    CommonVars vars;
+
+    testIncrementalConsistency<Discount,LogLinear>(vars, LogLinear(), true);
+    testIncrementalConsistency<ZeroYield,Cubic>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0),
+                   false);
+}
+
+
+void PiecewiseYieldCurveTest::testBucketAnalysis() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing bucket analysis through curve-node sensitivities...");
+
+    CommonVars vars;
+
+    testBucketAnalysisConsistency<Discount,LogLinear>(vars);
+    testBucketAnalysisConsistency<ZeroYield,Linear>(vars);
+}
+
+
 void PiecewiseYieldCurveTest::testObservability() {
 
     BOOST_TEST_MESSAGE("Testing observability of piecewise yield curve...");
@@ -1067,6 +1247,12 @@ test_suite* PiecewiseYieldCurveTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
 
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testIncrementalBootstrap));
+
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testBucketAnalysis));
+
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
 
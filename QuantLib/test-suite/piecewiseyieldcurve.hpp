@@ -41,6 +41,8 @@ class PiecewiseYieldCurveTest {
 
     static void testConvexMonotoneForwardConsistency();
     static void testLocalBootstrapConsistency();
+    static void testIncrementalBootstrap();
+    static void testBucketAnalysis();
 
     static void testObservability();
     static void testLiborFixing();
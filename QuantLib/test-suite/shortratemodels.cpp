@@ -24,6 +24,7 @@
 #include "shortratemodels.hpp"
 #include "utilities.hpp"
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
@@ -38,6 +39,7 @@
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/discretizedasset.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -427,6 +429,60 @@ void ShortRateModelTest::testFuturesConvexityBias() {
     }
 }
 
+void ShortRateModelTest::testTreeRollback() {
+    BOOST_TEST_MESSAGE("Testing rollback on short-rate trees...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(
+                                 flatRate(today, 0.04, Actual360()));
+
+    std::vector<Time> times;
+    times.push_back(5.0);
+    times.push_back(10.0);
+
+    std::vector<boost::shared_ptr<ShortRateModel> > models;
+    std::vector<Size> steps;
+    models.push_back(boost::shared_ptr<ShortRateModel>(
+                             new HullWhite(termStructure, 0.1, 0.01)));
+    steps.push_back(400);
+    models.push_back(boost::shared_ptr<ShortRateModel>(
+                             new G2(termStructure)));
+    steps.push_back(100);
+
+    // the second bond maturing at 10 years is rolled back on
+    // branching data stored during the first rollback
+    Time maturities[] = { 10.0, 5.0, 10.0 };
+
+    Real tolerance = 1.0e-12;
+
+    for (Size k=0; k<models.size(); ++k) {
+        TimeGrid grid(times.begin(), times.end(), steps[k]);
+        boost::shared_ptr<Lattice> lattice = models[k]->tree(grid);
+
+        for (Size i=0; i<LENGTH(maturities); ++i) {
+            DiscretizedDiscountBond bond;
+            bond.initialize(lattice, maturities[i]);
+            // the state prices are calculated independently
+            // of the rollback
+            Real expected = lattice->presentValue(bond);
+            bond.rollback(0.0);
+            Real calculated = bond.presentValue();
+
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce discount bond price "
+                            "on " << (k == 0 ? "Hull-White" : "G2")
+                            << " tree:"
+                            << std::setprecision(12)
+                            << "\n    maturity:   " << maturities[i]
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+
 test_suite* ShortRateModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
@@ -434,6 +490,7 @@ test_suite* ShortRateModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeRollback));
     return suite;
 }
 
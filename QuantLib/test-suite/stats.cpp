@@ -27,11 +27,18 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <boost/make_shared.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -124,6 +131,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<TDigestStatistics>(std::string("TDigestStatistics"));
 }
 
 
@@ -389,11 +397,174 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+void StatisticsTest::testTDigestStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing t-digest statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal(mt);
+
+    // a skewed distribution, with a heavy left tail as for P&L
+    const Size n = 200000;
+    std::vector<Real> samples(n), w(n);
+    for (Size i=0; i<n; ++i) {
+        const Real x = normal.next().value;
+        samples[i] = x < 0.0 ? 3.0*x : x;
+        w[i] = 0.5 + mt.nextReal();
+    }
+
+    const Real percentiles[] = { 0.0001, 0.001, 0.01, 0.05, 0.25, 0.5,
+                                 0.75, 0.95, 0.99, 0.999, 0.9999 };
+
+    // unit weights: the error on the percentiles is measured as
+    // the difference of the rank of the result from the expected one
+    RiskStatistics exact;
+    TDigestRiskStatistics digest;
+    exact.addSequence(samples.begin(), samples.end());
+    digest.addSequence(samples.begin(), samples.end());
+
+    std::vector<Real> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    for (Size i=0; i<LENGTH(percentiles); ++i) {
+        const Real p = percentiles[i];
+        const Real x = digest.percentile(p);
+        const Real rank =
+            Real(std::lower_bound(sorted.begin(), sorted.end(), x)
+                 - sorted.begin())/n;
+        // the t-digest is more accurate in the tails
+        const Real tolerance = std::max(3.0e-3*std::sqrt(p*(1.0-p)), 3.0/n);
+        if (std::fabs(rank - p) > tolerance)
+            BOOST_ERROR("wrong percentile:"
+                        << "\n    percentile:  " << p
+                        << "\n    calculated:  " << x
+                        << "\n    exact:       " << exact.percentile(p)
+                        << "\n    rank:        " << rank
+                        << "\n    tolerance:   " << tolerance);
+
+        const Real y = digest.topPercentile(p);
+        const Real topRank =
+            Real(sorted.end()
+                 - std::upper_bound(sorted.begin(), sorted.end(), y))/n;
+        if (std::fabs(topRank - p) > tolerance)
+            BOOST_ERROR("wrong top percentile:"
+                        << "\n    percentile:  " << p
+                        << "\n    calculated:  " << y
+                        << "\n    exact:       " << exact.topPercentile(p)
+                        << "\n    rank:        " << topRank
+                        << "\n    tolerance:   " << tolerance);
+    }
+
+    const Real centiles[] = { 0.9, 0.95, 0.99, 0.999 };
+    for (Size i=0; i<LENGTH(centiles); ++i) {
+        const Real p = centiles[i];
+        Real calculated = digest.valueAtRisk(p),
+             expected = exact.valueAtRisk(p);
+        if (std::fabs(calculated - expected) > 1.0e-2*expected)
+            BOOST_ERROR("wrong value at risk:"
+                        << "\n    percentile:  " << p
+                        << "\n    calculated:  " << calculated
+                        << "\n    expected:    " << expected);
+        calculated = digest.expectedShortfall(p);
+        expected = exact.expectedShortfall(p);
+        if (std::fabs(calculated - expected) > 1.0e-2*expected)
+            BOOST_ERROR("wrong expected shortfall:"
+                        << "\n    percentile:  " << p
+                        << "\n    calculated:  " << calculated
+                        << "\n    expected:    " << expected);
+    }
+
+    // the memory used is bounded
+    if (digest.centroids() > 2*Size(digest.compression()))
+        BOOST_ERROR("too many centroids: " << digest.centroids()
+                    << " for compression " << digest.compression());
+
+    // weighted samples, accumulated separately and merged; the
+    // moments are exact
+    GeneralStatistics weighted;
+    weighted.addSequence(samples.begin(), samples.end(), w.begin());
+    std::vector<TDigestStatistics> parts(4);
+    for (Size i=0; i<n; ++i)
+        parts[i % parts.size()].add(samples[i], w[i]);
+    TDigestStatistics merged;
+    for (Size i=0; i<parts.size(); ++i)
+        merged.merge(parts[i]);
+
+    if (merged.samples() != weighted.samples())
+        BOOST_ERROR("wrong number of samples after merge:"
+                    << "\n    calculated:  " << merged.samples()
+                    << "\n    expected:    " << weighted.samples());
+
+    #define CHECK_MOMENT(name)                                             \
+    if (!close_enough(merged.name(), weighted.name(), 1000))               \
+        BOOST_ERROR("wrong " #name " after merge:"                         \
+                    << std::setprecision(16)                               \
+                    << "\n    calculated:  " << merged.name()              \
+                    << "\n    expected:    " << weighted.name());
+    CHECK_MOMENT(weightSum)
+    CHECK_MOMENT(mean)
+    CHECK_MOMENT(variance)
+    CHECK_MOMENT(skewness)
+    CHECK_MOMENT(kurtosis)
+    CHECK_MOMENT(min)
+    CHECK_MOMENT(max)
+    #undef CHECK_MOMENT
+
+    for (Size i=0; i<LENGTH(percentiles); ++i) {
+        const Real p = percentiles[i];
+        const Real calculated = merged.percentile(p),
+                   expected = weighted.percentile(p);
+        // compare with the distance between neighbouring samples
+        const Size j = std::lower_bound(sorted.begin(), sorted.end(),
+                                        expected) - sorted.begin();
+        const Size d = Size(std::max(4.0e-3*std::sqrt(p*(1.0-p)), 3.0/n)*n);
+        const Real tolerance =
+            sorted[std::min(j+d, n-1)] - sorted[j >= d ? j-d : 0];
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("wrong percentile of weighted samples:"
+                        << "\n    percentile:  " << p
+                        << "\n    calculated:  " << calculated
+                        << "\n    expected:    " << expected
+                        << "\n    tolerance:   " << tolerance);
+    }
+
+    // usable as the statistics of Monte Carlo engines
+    SavedSettings backup;
+    Date today = Settings::instance().evaluationDate();
+    DayCounter dc = Actual360();
+    boost::shared_ptr<BlackScholesMertonProcess> process =
+        boost::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(boost::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.2, dc)));
+    VanillaOption option(
+        boost::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        boost::make_shared<EuropeanExercise>(today + 360));
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(process)
+        .withSteps(1).withSamples(10000).withSeed(42));
+    const Real expected = option.NPV(), error = option.errorEstimate();
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom, TDigestRiskStatistics>(process)
+        .withSteps(1).withSamples(10000).withSeed(42));
+    if (!close_enough(option.NPV(), expected, 1000)
+        || !close_enough(option.errorEstimate(), error, 1000))
+        BOOST_ERROR("failed to reproduce Monte Carlo results:"
+                    << std::setprecision(16)
+                    << "\n    calculated:  " << option.NPV()
+                    << " +/- " << option.errorEstimate()
+                    << "\n    expected:    " << expected
+                    << " +/- " << error);
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testTDigestStatistics));
     return suite;
 }
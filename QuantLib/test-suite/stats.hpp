@@ -33,6 +33,7 @@ class StatisticsTest {
     static void testSequenceStatistics();
     static void testConvergenceStatistics();
     static void testIncrementalStatistics();
+    static void testTDigestStatistics();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -224,6 +224,100 @@ void SwaptionVolatilityCubeTest::testSabrVols() {
     vars.makeVolSpreadsTest(volCube, tolerance);
 }
 
+void SwaptionVolatilityCubeTest::testParallelSabrCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing parallel calibration of sabr cube...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SwaptionVolCube1 serialCube(vars.atmVolMatrix,
+                                vars.cube.tenors.options,
+                                vars.cube.tenors.swaps,
+                                vars.cube.strikeSpreads,
+                                vars.cube.volSpreadsHandle,
+                                vars.swapIndexBase,
+                                vars.shortSwapIndexBase,
+                                vars.vegaWeighedSmileFit,
+                                parametersGuess,
+                                isParameterFixed,
+                                true);
+    SwaptionVolCube1 parallelCube(vars.atmVolMatrix,
+                                  vars.cube.tenors.options,
+                                  vars.cube.tenors.swaps,
+                                  vars.cube.strikeSpreads,
+                                  vars.cube.volSpreadsHandle,
+                                  vars.swapIndexBase,
+                                  vars.shortSwapIndexBase,
+                                  vars.vegaWeighedSmileFit,
+                                  parametersGuess,
+                                  isParameterFixed,
+                                  true);
+    parallelCube.setThreads(4);
+
+    std::string description = "cold start";
+    for (Size m=0; m<2; ++m) {
+        Matrix serialParameters[] = { serialCube.sparseSabrParameters(),
+                                      serialCube.denseSabrParameters() };
+        Matrix parallelParameters[] = { parallelCube.sparseSabrParameters(),
+                                        parallelCube.denseSabrParameters() };
+        for (Size c=0; c<2; ++c) {
+            for (Size i=0; i<serialParameters[c].rows(); ++i) {
+                for (Size j=0; j<serialParameters[c].columns(); ++j) {
+                    if (serialParameters[c][i][j] != parallelParameters[c][i][j])
+                        BOOST_FAIL("parallel calibration failed (" <<
+                                   description << ", " <<
+                                   (c == 0 ? "sparse" : "dense") <<
+                                   " parameters):" <<
+                                   "\n    row:       " << i <<
+                                   "\n    column:    " << j <<
+                                   "\n    serial:    " <<
+                                   serialParameters[c][i][j] <<
+                                   "\n    parallel:  " <<
+                                   parallelParameters[c][i][j]);
+                }
+            }
+        }
+
+        // move the wings of the smile and recalibrate from the
+        // last parameters
+        description = "warm start";
+        serialCube.enableWarmStart();
+        parallelCube.enableWarmStart();
+        for (Size i=0; i<vars.cube.volSpreadsHandle.size(); ++i) {
+            for (Size j=0; j<vars.cube.volSpreadsHandle[i].size(); ++j) {
+                if (vars.cube.strikeSpreads[j] == 0.0)
+                    continue;
+                boost::shared_ptr<SimpleQuote> q =
+                    boost::dynamic_pointer_cast<SimpleQuote>(
+                                   vars.cube.volSpreadsHandle[i][j].currentLink());
+                q->setValue(q->value() + 0.0001);
+                vars.cube.volSpreads[i][j] += 0.0001;
+            }
+        }
+    }
+
+    Real tolerance = 3.0e-4;
+    vars.makeAtmVolTest(parallelCube, tolerance);
+
+    tolerance = 12.0e-4;
+    vars.makeVolSpreadsTest(parallelCube, tolerance);
+}
+
 void SwaptionVolatilityCubeTest::testSpreadedCube() {
 
     BOOST_TEST_MESSAGE("Testing spreaded swaption volatility cube...");
@@ -453,6 +547,8 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
     // SwaptionVolCubeBySabr reproduces ATM vol with given tolerance
     // SwaptionVolCubeBySabr reproduces smile spreads with given tolerance
     suite->add(QUANTLIB_TEST_CASE(&SwaptionVolatilityCubeTest::testSabrVols));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &SwaptionVolatilityCubeTest::testParallelSabrCalibration));
     suite->add(QUANTLIB_TEST_CASE(
                               &SwaptionVolatilityCubeTest::testSpreadedCube));
 
@@ -31,6 +31,7 @@ class SwaptionVolatilityCubeTest {
     static void testAtmVols();
     static void testSmile();
     static void testSabrVols();
+    static void testParallelSabrCalibration();
     static void testSpreadedCube();
     static void testObservability();
 